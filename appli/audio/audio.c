@@ -0,0 +1,301 @@
+/**
+ ******************************************************************************
+ * @file 	audio.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Lecture de sons echantillonnes sur le HP (PB6, TIM4 canal 1) :
+ * 			TIM4 devient une porteuse PWM 8 bits a 31,25 kHz dont le rapport cyclique est
+ * 			recharge a chaque periode par le DMA (requete CC1, DMA1 canal 1, mode circulaire).
+ * 			Le melangeur remplit une moitie du tampon pendant que le DMA lit l'autre.
+ * @note	Entre deux interruptions de demi-tampon (2 ms) le processeur est libre.
+ * 			En dehors des sons, TIM4 est rendu au mode carre (melodie, sequenceur).
+ * 			Les voies n'appartiennent qu'au melangeur : AUDIO_jouer et AUDIO_arreter, appeles sous
+ * 			Systick qui peut l'interrompre, deposent une demande qu'il prend au debut du remplissage.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "audio.h"
+
+#define TAILLE_TAMPON 128  /** @def Rapports cycliques en attente, deux moities de 2 ms*/
+#define SURECHANTILLONNAGE 4 /** @def Periodes de porteuse par echantillon*/
+#define PSC_PCM 8		   /** @def 72 MHz / 9 / 256 = 31,25 kHz*/
+#define ARR_PCM 255
+
+typedef struct
+{
+	const son_t *son; //NULL : voie muette
+	uint16_t position;
+	bool_e boucle;
+	int16_t predicteur; //etat du decodeur ADPCM
+	uint8_t index;
+} voix_t;
+
+typedef struct
+{
+	const son_t *son; //NULL : arret de la voie
+	bool_e boucle;
+} demande_t;
+
+static const int16_t pas[89] = {
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+static const int8_t variationIndex[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+static uint8_t tampon[TAILLE_TAMPON];
+static voix_t voix[AUDIO_NB_VOIES];
+static volatile demande_t demandes[AUDIO_NB_VOIES];
+static volatile uint8_t aPrendre = 0; //un bit par voie dont la demande attend le melangeur
+static volatile bool_e sortieActive = FALSE;
+static uint8_t moitiesMuettes = 0;
+static uint32_t pscCarre, arrCarre; //reglage du mode carre, restaure a la fin des sons
+static DMA_HandleTypeDef hdma;
+
+static int16_t echantillon(voix_t *);
+static void prendre_demandes(void);
+static const son_t *voie_demandee(voie_audio_e);
+static void remplir(uint8_t *);
+static void demi_tampon(DMA_HandleTypeDef *);
+static void fin_tampon(DMA_HandleTypeDef *);
+static void demarrer(void);
+static void couper(void);
+
+/**
+ * @brief Echantillon suivant d'une voie, centre sur 0
+ */
+static int16_t echantillon(voix_t *v)
+{
+	const son_t *s = v->son;
+	int16_t e;
+
+	if (v->position >= s->nb)
+	{
+		if (!v->boucle || s->debutBoucle >= s->nb)
+		{
+			v->son = NULL;
+			return 0;
+		}
+		v->position = s->debutBoucle;
+		v->predicteur = s->predicteurBoucle;
+		v->index = s->indexBoucle;
+	}
+
+	if (s->format == AUDIO_PCM8)
+		e = (int16_t)s->donnees[v->position] - 128;
+	else
+	{
+		uint8_t code = (s->donnees[v->position / 2] >> ((v->position & 1) * 4)) & 0x0F;
+		int32_t p = v->predicteur;
+		int32_t d = pas[v->index] >> 3;
+
+		if (code & 4)
+			d += pas[v->index];
+		if (code & 2)
+			d += pas[v->index] >> 1;
+		if (code & 1)
+			d += pas[v->index] >> 2;
+		p += (code & 8) ? -d : d;
+		v->predicteur = (p > 32767) ? 32767 : (p < -32768) ? -32768 : (int16_t)p;
+		v->index = (uint8_t)MAX(0, MIN(88, (int8_t)v->index + variationIndex[code & 7]));
+		e = v->predicteur >> 8;
+	}
+	v->position++;
+	return e;
+}
+
+/**
+ * @brief Applique aux voies les demandes deposees depuis le dernier remplissage
+ */
+static void prendre_demandes(void)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	for (uint8_t n = 0; n < AUDIO_NB_VOIES; n++)
+	{
+		if (!(aPrendre & (1 << n)))
+			continue;
+		voix[n].son = demandes[n].son;
+		voix[n].boucle = demandes[n].boucle;
+		voix[n].position = 0;
+		voix[n].predicteur = 0;
+		voix[n].index = 0;
+	}
+	aPrendre = 0;
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @retval le son qu'une voie jouera au prochain remplissage, a appeler interruptions masquees
+ */
+static const son_t *voie_demandee(voie_audio_e voie)
+{
+	return (aPrendre & (1 << voie)) ? demandes[voie].son : voix[voie].son;
+}
+
+/**
+ * @brief Melange une moitie de tampon : l'alerte suspend le son de fond
+ * @note  Chaque case est ecrite, le silence a 128 : un son fini en cours de moitie
+ * 			ne laisse pas au DMA la fin de l'ancien contenu
+ */
+static void remplir(uint8_t *moitie)
+{
+	bool_e muette = TRUE;
+
+	prendre_demandes();
+	for (uint8_t i = 0; i < TAILLE_TAMPON / 2; i += SURECHANTILLONNAGE)
+	{
+		voix_t *v = voix[AUDIO_ALERTE].son ? &voix[AUDIO_ALERTE] : &voix[AUDIO_FOND];
+		int16_t e = 0;
+
+		if (v->son)
+		{
+			e = echantillon(v);
+			muette = FALSE;
+		}
+		e += 128;
+		for (uint8_t j = 0; j < SURECHANTILLONNAGE; j++)
+			moitie[i + j] = (uint8_t)((e > ARR_PCM) ? ARR_PCM : (e < 0) ? 0 : e);
+	}
+	moitiesMuettes = muette ? moitiesMuettes + 1 : 0;
+}
+
+/**
+ * @brief Le DMA lit la seconde moitie : la premiere est remplie
+ */
+static void demi_tampon(DMA_HandleTypeDef *h)
+{
+	(void)h;
+	remplir(&tampon[0]);
+}
+
+/**
+ * @brief Le DMA repart au debut : la seconde moitie est remplie, la sortie est coupee apres deux moities muettes
+ * @note  Un son demande depuis le remplissage la maintient
+ */
+static void fin_tampon(DMA_HandleTypeDef *h)
+{
+	uint32_t primask;
+
+	(void)h;
+	remplir(&tampon[TAILLE_TAMPON / 2]);
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (moitiesMuettes >= 2 && !voie_demandee(AUDIO_ALERTE) && !voie_demandee(AUDIO_FOND))
+		couper();
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Passe TIM4 en porteuse PCM et lance le DMA circulaire sur un tampon muet
+ * @note  Le melangeur n'est pas appele ici, il peut etre en cours sous le Systick qui demarre :
+ * 			le son commence apres le premier demi-tampon, soit 4 ms au plus
+ */
+static void demarrer(void)
+{
+	pscCarre = TIM4->PSC;
+	arrCarre = TIM4->ARR;
+	moitiesMuettes = 0;
+	for (uint8_t i = 0; i < TAILLE_TAMPON; i++)
+		tampon[i] = 128;
+	TIM4->PSC = PSC_PCM;
+	TIM4->ARR = ARR_PCM;
+	TIM4->CCR1 = 128;
+	TIM4->EGR = TIM_EGR_UG; //prise en compte immediate des registres precharges
+	sortieActive = TRUE;
+	HAL_DMA_Start_IT(&hdma, (uint32_t)(uintptr_t)tampon, (uint32_t)(uintptr_t)&TIM4->CCR1, TAILLE_TAMPON);
+	TIM4->DIER |= TIM_DIER_CC1DE;
+}
+
+/**
+ * @brief Arrete le DMA et rend TIM4 au mode carre, muet ; sans effet si la sortie est deja coupee
+ */
+static void couper(void)
+{
+	if (!sortieActive)
+		return;
+	TIM4->DIER &= ~TIM_DIER_CC1DE;
+	HAL_DMA_Abort(&hdma);
+	TIM4->PSC = pscCarre;
+	TIM4->ARR = arrCarre;
+	TIM4->CCR1 = 0;
+	TIM4->EGR = TIM_EGR_UG;
+	sortieActive = FALSE;
+}
+
+void DMA1_Channel1_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&hdma);
+}
+
+/**
+ * @brief Configure le canal DMA de la requete CC1 de TIM4, a appeler apres HP_init
+ */
+void AUDIO_init(void)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	hdma.Instance = DMA1_Channel1; //TIM4_CH1
+	hdma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma.Init.MemInc = DMA_MINC_ENABLE;
+	hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD; //l'octet est etendu a 16 bits dans CCR1
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma.Init.Mode = DMA_CIRCULAR;
+	hdma.Init.Priority = DMA_PRIORITY_HIGH;
+	HAL_DMA_Init(&hdma);
+	hdma.XferHalfCpltCallback = &demi_tampon;
+	hdma.XferCpltCallback = &fin_tampon;
+	HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 2, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+}
+
+/**
+ * @brief Joue un son sur une voie, en remplacant le son en cours de cette voie
+ * @param voie : AUDIO_ALERTE suspend AUDIO_FOND tant qu'elle joue
+ * @param son : son a jouer
+ * @param boucle : TRUE pour repeter la partie bouclee du son jusqu'a AUDIO_arreter
+ */
+void AUDIO_jouer(voie_audio_e voie, const son_t *son, bool_e boucle)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	demandes[voie].son = son;
+	demandes[voie].boucle = boucle;
+	aPrendre |= 1 << voie;
+	if (!sortieActive)
+		demarrer();
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Arrete le son d'une voie, la sortie est coupee quand toutes les voies se taisent
+ */
+void AUDIO_arreter(voie_audio_e voie)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	demandes[voie].son = NULL;
+	aPrendre |= 1 << voie;
+	if (!voie_demandee(AUDIO_FOND) && !voie_demandee(AUDIO_ALERTE))
+		couper();
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @retval TRUE si TIM4 est en mode PCM
+ */
+bool_e AUDIO_actif(void)
+{
+	return sortieActive;
+}
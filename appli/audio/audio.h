@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file 	audio.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef AUDIO_H_
+#define AUDIO_H_
+
+#define AUDIO_FREQUENCE 7812 /** @def Frequence d'echantillonnage des sons (en Hz), 1/4 de la porteuse PWM*/
+
+typedef enum
+{
+	AUDIO_PCM8 = 0, //un octet non signe par echantillon
+	AUDIO_ADPCM		//IMA ADPCM, 4 bits par echantillon, quartet de poids faible en premier
+} format_audio_e;
+
+typedef struct
+{
+	const uint8_t *donnees;
+	uint16_t nb;			  //nombre d'echantillons
+	uint16_t debutBoucle;	  //premier echantillon de la partie repetee, nb : pas de boucle
+	format_audio_e format;
+	int16_t predicteurBoucle; //etat du decodeur ADPCM au debut de la boucle
+	uint8_t indexBoucle;
+} son_t; /** @struct Son echantillonne range en flash, produit par outils/wav2c.c*/
+
+typedef enum
+{
+	AUDIO_FOND = 0, //son de fond, suspendu tant qu'une alerte est jouee
+	AUDIO_ALERTE,
+	AUDIO_NB_VOIES
+} voie_audio_e;
+
+void AUDIO_init(void);
+void AUDIO_jouer(voie_audio_e, const son_t *, bool_e);
+void AUDIO_arreter(voie_audio_e);
+bool_e AUDIO_actif(void);
+
+#endif /* AUDIO_H_ */
@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @file 	sons.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Sons echantillonnes a AUDIO_FREQUENCE, generes par outils/wav2c.c
+ * @note	Klaxon : deux tons a 417 et 521 Hz (harmoniques 1, 3, 5), attaque de 31 ms puis
+ * 			boucle d'une periode commune de 75 echantillons, ADPCM : 158 octets.
+ * 			Bip de recul : 977 Hz, attaque de 2 ms puis boucle d'une periode, PCM 8 bits : 24 octets.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "audio.h"
+#include "sons.h"
+
+static const uint8_t SON_klaxon_donnees[158] = {
+	0x70, 0x77, 0x57, 0x82, 0xDF, 0xBA, 0x80, 0x7B, 0x95, 0x41, 0x02, 0xE9, 0x09, 0x00, 0xCD, 0x42,
+	0x88, 0x91, 0x10, 0x1A, 0xA0, 0x93, 0x7B, 0x97, 0x0B, 0x08, 0xFA, 0x0A, 0x52, 0x91, 0x34, 0x88,
+	0xB2, 0xDC, 0x8C, 0x88, 0x91, 0x78, 0x87, 0x80, 0x80, 0xA8, 0xAA, 0x1A, 0x98, 0x26, 0x08, 0x24,
+	0xA0, 0x9C, 0x08, 0xC0, 0x2E, 0x94, 0x00, 0x88, 0x91, 0x00, 0x29, 0x99, 0x67, 0xAB, 0x00, 0xA0,
+	0x9D, 0x10, 0x15, 0x49, 0x93, 0x10, 0xDA, 0xDB, 0x08, 0x08, 0x09, 0x67, 0x88, 0x00, 0x88, 0xBA,
+	0xAA, 0x01, 0x6A, 0x93, 0x41, 0x11, 0xDA, 0x09, 0x00, 0xCC, 0x42, 0x88, 0x91, 0x00, 0x19, 0xA0,
+	0x82, 0x7A, 0xA7, 0x0A, 0x08, 0xD9, 0x09, 0x51, 0x80, 0x43, 0x09, 0xA1, 0xBC, 0x8D, 0x88, 0x91,
+	0x78, 0x06, 0x08, 0x88, 0xA8, 0xAB, 0x1A, 0x90, 0x35, 0x19, 0x25, 0xA0, 0x8D, 0x08, 0xB0, 0x2D,
+	0x84, 0x08, 0x08, 0x90, 0x81, 0x29, 0xA8, 0x67, 0xAB, 0x00, 0xA0, 0x9D, 0x20, 0x14, 0x49, 0x94,
+	0x10, 0xBA, 0xBD, 0x09, 0x08, 0x88, 0x77, 0x80, 0x80, 0x90, 0xBA, 0xAA, 0x01, 0x09,
+};
+
+const son_t SON_klaxon = {SON_klaxon_donnees, 315, 240, AUDIO_ADPCM, -24309, 75};
+
+static const uint8_t SON_bip_donnees[24] = {
+	0x80, 0x84, 0x8C, 0x8D, 0x80, 0x69, 0x59, 0x60, 0x80, 0xA8, 0xBF, 0xB1, 0x80, 0x45, 0x27, 0x3C,
+	0x80, 0xC7, 0xE5, 0xC7, 0x80, 0x38, 0x1A, 0x38,
+};
+
+const son_t SON_bip = {SON_bip_donnees, 24, 16, AUDIO_PCM8, 0, 0};
@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file 	sons.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef SONS_H_
+#define SONS_H_
+
+extern const son_t SON_klaxon;
+extern const son_t SON_bip;
+
+#endif /* SONS_H_ */
@@ -0,0 +1,229 @@
+/**
+ ******************************************************************************
+ * @file 	automate.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Moteur de machine a etats pilote par table.
+ * 			Chaque etat a ses fonctions d'entree et de sortie et peut avoir un delai.
+ * 			La table des transitions (etat, evenement, garde, action, suivant) est groupee
+ * 			par etat de depart : un pas ne parcourt que les lignes de l'etat courant, la
+ * 			premiere ligne dont l'evenement et la garde conviennent est franchie.
+ * 			Apres une entree, l'etat atteint voit l'evenement AUTOMATE_ENTREE : ses lignes
+ * 			AUTOMATE_TOUS peuvent enchainer aussitot, au plus AUTOMATE_NB_ETATS_MAX fois par pas.
+ * 			Chaque changement d'etat est note dans une trace circulaire de AUTOMATE_TRACE_NB entrees.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "evenement/evenement.h"
+#include "journal/journal.h"
+#include "automate.h"
+
+typedef struct
+{
+	uint8_t premiere; //indice de la premiere ligne de l'etat dans la table
+	uint8_t nb;		  //nombre de lignes de l'etat
+} lignes_t;			  /** @struct Lignes de la table propres a un etat*/
+
+static const etat_t *etats;
+static uint8_t nbEtats = 0;
+static const transition_t *table;
+static lignes_t lignes[AUTOMATE_NB_ETATS_MAX];
+static uint8_t courant;
+static uint32_t debut;			 //date d'entree dans l'etat courant (en ms)
+static minuterie_t minuterie;	 //delai de l'etat courant
+static trace_t trace[AUTOMATE_TRACE_NB];
+static uint32_t nbTrace = 0;	 //transitions ecrites dans la trace depuis l'init
+static stat_automate_t stat;
+static uint64_t coutTotal = 0;
+
+static void echeance(void);
+static void entrer(uint8_t, uint8_t, uint8_t);
+
+/**
+ * @brief Expiration du delai de l'etat courant : reveille la boucle principale
+ */
+static void echeance(void)
+{
+	EVENEMENT_poster(EVENEMENT_TIMER);
+}
+
+/**
+ * @brief Change d'etat : note la transition, arme le delai du nouvel etat et appelle son entree
+ */
+static void entrer(uint8_t etat, uint8_t evenement, uint8_t ligne)
+{
+	trace_t *t = &trace[nbTrace % AUTOMATE_TRACE_NB];
+
+	t->date = MINUTERIE_maintenant();
+	t->de = courant;
+	t->vers = etat;
+	t->evenement = evenement;
+	t->ligne = ligne;
+	nbTrace++;
+	stat.transitions++;
+
+	courant = etat;
+	debut = MINUTERIE_maintenant();
+	if (etats[etat].delai)
+		MINUTERIE_armer(&minuterie, etats[etat].delai + 1, 0, &echeance);
+	else
+		MINUTERIE_annuler(&minuterie);
+	if (etats[etat].entree)
+		etats[etat].entree();
+}
+
+/**
+ * @brief Installe un automate et entre dans son etat initial
+ * @param e : tableau des etats, indexe par numero d'etat
+ * @param nbE : nombre d'etats, au plus AUTOMATE_NB_ETATS_MAX
+ * @param t : table des transitions, lignes groupees par etat de depart
+ * @param nbT : nombre de lignes, au plus 255
+ * @param initial : etat initial
+ * @retval FALSE si la table n'est pas groupee par etat ou reference un etat inconnu : l'automate n'est pas installe
+ */
+bool_e AUTOMATE_init(const etat_t *e, uint8_t nbE, const transition_t *t, uint8_t nbT, uint8_t initial)
+{
+	if (nbE > AUTOMATE_NB_ETATS_MAX || initial >= nbE)
+		return FALSE;
+	for (uint8_t i = 0; i < nbE; i++)
+		lignes[i].nb = 0;
+	stat.lignesMax = 0;
+	for (uint8_t i = 0; i < nbT; i++)
+	{
+		uint8_t s = t[i].etat;
+		if (s >= nbE || (t[i].suivant >= nbE && t[i].suivant != AUTOMATE_RESTE))
+			return FALSE;
+		if (lignes[s].nb == 0)
+			lignes[s].premiere = i;
+		else if (lignes[s].premiere + lignes[s].nb != i)
+			return FALSE; //lignes de l'etat s non contigues
+		lignes[s].nb++;
+		if (lignes[s].nb > stat.lignesMax)
+			stat.lignesMax = lignes[s].nb;
+	}
+	etats = e;
+	nbEtats = nbE;
+	table = t;
+	courant = initial;
+	entrer(initial, AUTOMATE_ENTREE, 0xFF);
+	AUTOMATE_pas(AUTOMATE_ENTREE);
+	return TRUE;
+}
+
+/**
+ * @brief Presente un evenement a l'automate et franchit au plus une transition par etat traverse
+ * @param evenement : evenement de l'application (inferieur a AUTOMATE_ENTREE)
+ */
+void AUTOMATE_pas(uint8_t evenement)
+{
+	uint32_t cout = 0;
+
+	if (!nbEtats)
+		return;
+	stat.pas++;
+	for (uint8_t chaine = 0; chaine < AUTOMATE_NB_ETATS_MAX; chaine++)
+	{
+		uint32_t decision = DWT->CYCCNT;
+		const transition_t *t = &table[lignes[courant].premiere];
+		const transition_t *fin = t + lignes[courant].nb;
+
+		for (; t < fin; t++)
+		{
+			if (t->evenement != evenement && t->evenement != AUTOMATE_TOUS)
+				continue;
+			if (t->garde == NULL || t->garde())
+				break;
+		}
+		cout += DWT->CYCCNT - decision;
+		if (t == fin)
+			break;
+		if (t->suivant == AUTOMATE_RESTE)
+		{
+			if (t->action)
+				t->action();
+			break;
+		}
+		if (etats[courant].sortie)
+			etats[courant].sortie();
+		if (t->action)
+			t->action();
+		entrer(t->suivant, evenement, (uint8_t)(t - table));
+		evenement = AUTOMATE_ENTREE;
+	}
+	coutTotal += cout;
+	stat.moy = (uint32_t)(coutTotal / stat.pas);
+	if (cout > stat.max)
+		stat.max = cout;
+}
+
+/**
+ * @retval l'etat courant
+ */
+uint8_t AUTOMATE_get_etat(void)
+{
+	return courant;
+}
+
+/**
+ * @retval le nom d'un etat, "?" s'il est inconnu
+ */
+const char *AUTOMATE_get_nom(uint8_t etat)
+{
+	return (etat < nbEtats) ? etats[etat].nom : "?";
+}
+
+/**
+ * @retval le temps passe dans l'etat courant (en ms)
+ */
+uint32_t AUTOMATE_duree(void)
+{
+	return MINUTERIE_maintenant() - debut;
+}
+
+/**
+ * @brief Garde commune : le delai de l'etat courant est ecoule
+ */
+bool_e AUTOMATE_delai_ecoule(void)
+{
+	return etats[courant].delai && AUTOMATE_duree() > etats[courant].delai;
+}
+
+/**
+ * @brief Lecture de la trace
+ * @param rang : 0 pour la transition la plus recente, 1 pour la precedente...
+ * @param t : recoit l'entree
+ * @retval le nombre d'entrees disponibles, t n'est rempli que si rang est inferieur
+ */
+uint8_t AUTOMATE_get_trace(uint8_t rang, trace_t *t)
+{
+	uint8_t nb = (nbTrace < AUTOMATE_TRACE_NB) ? (uint8_t)nbTrace : AUTOMATE_TRACE_NB;
+
+	if (rang < nb)
+		*t = trace[(nbTrace - 1 - rang) % AUTOMATE_TRACE_NB];
+	return nb;
+}
+
+stat_automate_t AUTOMATE_get_stat(void)
+{
+	return stat;
+}
+
+/**
+ * @brief Ecrit la trace dans le journal, de la plus ancienne a la plus recente transition
+ */
+void AUTOMATE_afficher_trace(void)
+{
+	trace_t t;
+	uint8_t nb = AUTOMATE_get_trace(0, &t);
+
+	for (uint8_t i = nb; i > 0; i--)
+	{
+		AUTOMATE_get_trace(i - 1, &t);
+		JOURNAL_texte(AUTOMATE_get_nom(t.de));
+		JOURNAL_4(JOURNAL_AUTOMATE_TRANSITION, t.vers, t.date, t.evenement, t.ligne);
+	}
+	JOURNAL_4(JOURNAL_AUTOMATE_COUT, stat.pas, stat.transitions, stat.moy, stat.max);
+}
@@ -0,0 +1,65 @@
+/**
+ ******************************************************************************
+ * @file 	automate.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef AUTOMATE_H_
+#define AUTOMATE_H_
+
+#define AUTOMATE_NB_ETATS_MAX 16 /** @def Nombre maximal d'etats d'un automate*/
+#define AUTOMATE_TRACE_NB 32	 /** @def Transitions conservees dans la trace (puissance de 2)*/
+#define AUTOMATE_TOUS 0xFF		 /** @def Evenement d'une transition franchissable sur tout evenement, y compris a l'entree dans l'etat*/
+#define AUTOMATE_ENTREE 0xFE	 /** @def Evenement interne presente a un etat juste apres son entree*/
+#define AUTOMATE_RESTE 0xFF		 /** @def Etat suivant d'une transition interne : action sans sortie ni entree*/
+
+typedef bool_e (*garde_t)(void); /** @def Condition d'une transition, NULL pour toujours vraie*/
+
+typedef struct
+{
+	const char *nom;
+	callback_fun_t entree; //appelee a l'entree dans l'etat, NULL si rien a faire
+	callback_fun_t sortie; //appelee a la sortie de l'etat, NULL si rien a faire
+	uint32_t delai;		   //duree apres laquelle AUTOMATE_delai_ecoule devient vraie et un evenement est poste (en ms), 0 : aucune
+} etat_t;				   /** @struct Description d'un etat*/
+
+typedef struct
+{
+	uint8_t etat;		   //etat de depart
+	uint8_t evenement;	   //evenement declencheur, AUTOMATE_TOUS pour tous
+	garde_t garde;		   //condition, evaluee dans l'ordre de la table
+	callback_fun_t action; //appelee entre la sortie et l'entree, NULL si rien a faire
+	uint8_t suivant;	   //etat d'arrivee, AUTOMATE_RESTE pour une transition interne
+} transition_t;			   /** @struct Ligne de la table des transitions, groupee par etat de depart*/
+
+typedef struct
+{
+	uint32_t date;	   //date de la transition (en ms)
+	uint8_t de;		   //etat quitte
+	uint8_t vers;	   //etat atteint
+	uint8_t evenement; //evenement traite
+	uint8_t ligne;	   //indice de la transition dans la table
+} trace_t;			   /** @struct Entree de la trace des transitions (8 octets)*/
+
+typedef struct
+{
+	uint32_t pas;		  //evenements traites
+	uint32_t transitions; //changements d'etat
+	uint32_t moy;		  //cout moyen de la decision d'un pas, gardes comprises, hors actions (en cycles)
+	uint32_t max;
+	uint8_t lignesMax;	  //plus grand nombre de lignes d'un meme etat : borne du parcours d'un pas
+} stat_automate_t;		  /** @struct Compteurs de l'automate*/
+
+bool_e AUTOMATE_init(const etat_t *, uint8_t, const transition_t *, uint8_t, uint8_t);
+void AUTOMATE_pas(uint8_t);
+uint8_t AUTOMATE_get_etat(void);
+const char *AUTOMATE_get_nom(uint8_t);
+uint32_t AUTOMATE_duree(void);
+bool_e AUTOMATE_delai_ecoule(void);
+uint8_t AUTOMATE_get_trace(uint8_t, trace_t *);
+stat_automate_t AUTOMATE_get_stat(void);
+void AUTOMATE_afficher_trace(void);
+
+#endif /* AUTOMATE_H_ */
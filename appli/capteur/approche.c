@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file 	approche.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Estimation de la vitesse de rapprochement et du temps avant contact
+ * 			d'un obstacle, par regression lineaire sur les derniers releves dates.
+ * 			Calcul entier uniquement, appele sous interruption a chaque releve.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "approche.h"
+
+#define ECART_MAX 300	  /** @def Ecart entre deux releves au dela duquel l'historique est perime (en ms)*/
+#define VITESSE_MIN 20	  /** @def Rapprochement en deca duquel l'obstacle est considere immobile (en mm/s)*/
+#define VITESSE_MAX 10000 /** @def Borne de la vitesse estimee, au dela c'est un saut de mesure (en mm/s)*/
+#define NUM_MAX 2000000	  /** @def Numerateur au dela duquel le produit par 1000 deborderait 32 bits*/
+
+/**
+ * @brief Oublie les releves d'un anneau
+ */
+void APPROCHE_vider(historique_t *h)
+{
+	h->nb = 0;
+}
+
+/**
+ * @brief Ajoute un releve a l'anneau et met a jour l'estimation.
+ * 		La pente des moindres carres est calculee sur des ecarts a la moyenne :
+ * 		avec APPROCHE_NB releves espaces d'au plus ECART_MAX ms et des distances sous 4 m,
+ * 		les sommes tiennent sur 32 bits.
+ * @param h : anneau du capteur
+ * @param distance : distance mesuree (en mm)
+ * @param date : date du releve (en ms)
+ * @retval l'estimation apres ce releve, vitesse nulle tant qu'il y a moins de deux releves
+ */
+approche_t APPROCHE_ajouter(historique_t *h, uint16_t distance, uint32_t date)
+{
+	approche_t a = {0, APPROCHE_AUCUNE};
+	int32_t sommeT = 0, sommeD = 0, num = 0, den = 0, v;
+	uint8_t i, k;
+
+	if (h->nb && date - h->date[h->tete] > ECART_MAX)
+		h->nb = 0;
+	h->tete = (h->tete + 1) % APPROCHE_NB;
+	h->distance[h->tete] = distance;
+	h->date[h->tete] = date;
+	if (h->nb < APPROCHE_NB)
+		h->nb++;
+	if (h->nb < 2)
+		return a;
+
+	//Dates relatives au releve le plus recent, negatives ou nulles
+	for (i = 0, k = h->tete; i < h->nb; i++, k = (k + APPROCHE_NB - 1) % APPROCHE_NB)
+	{
+		sommeT += (int32_t)(h->date[k] - date);
+		sommeD += h->distance[k];
+	}
+	for (i = 0, k = h->tete; i < h->nb; i++, k = (k + APPROCHE_NB - 1) % APPROCHE_NB)
+	{
+		int32_t t = (int32_t)(h->date[k] - date) * h->nb - sommeT; //ecarts multiplies par nb pour rester entiers
+		int32_t d = (int32_t)h->distance[k] * h->nb - sommeD;
+		num += t * d;
+		den += t * t;
+	}
+	if (den == 0)
+		return a;
+	//Pente en mm/ms convertie en mm/s, sans division 64 bits
+	if (num > -NUM_MAX && num < NUM_MAX)
+		v = -(num * 1000 / den);
+	else
+		v = -(num / (den / 1000 + 1));
+	a.vitesse = (int16_t)((v > VITESSE_MAX) ? VITESSE_MAX : (v < -VITESSE_MAX) ? -VITESSE_MAX : v);
+	if (a.vitesse >= VITESSE_MIN)
+	{
+		uint32_t ttc = (uint32_t)distance * 1000 / (uint32_t)a.vitesse;
+		a.ttc = (ttc < APPROCHE_AUCUNE) ? (uint16_t)ttc : APPROCHE_AUCUNE - 1;
+	}
+	return a;
+}
@@ -0,0 +1,31 @@
+/*
+ * approche.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: gauti
+ */
+
+#ifndef CAPTEUR_APPROCHE_H_
+#define CAPTEUR_APPROCHE_H_
+
+#define APPROCHE_NB 4				/** @def Nombre de releves conserves pour estimer la vitesse de rapprochement*/
+#define APPROCHE_AUCUNE 0xFFFF		/** @def Temps avant contact d'un obstacle qui n'approche pas*/
+
+typedef struct
+{
+	uint16_t distance[APPROCHE_NB]; //distances en mm, la plus recente en tete
+	uint32_t date[APPROCHE_NB];		//dates des releves en ms
+	uint8_t tete;					//indice du releve le plus recent
+	uint8_t nb;						//nombre de releves valides dans l'anneau
+} historique_t; /** @struct Anneau des derniers releves d'un capteur, a allouer par l'appelant*/
+
+typedef struct
+{
+	int16_t vitesse; //vitesse de rapprochement en mm/s, positive quand l'obstacle approche
+	uint16_t ttc;	 //temps avant contact a la date du dernier releve en ms, APPROCHE_AUCUNE si l'obstacle n'approche pas
+} approche_t; /** @struct Estimation du rapprochement d'un obstacle*/
+
+void APPROCHE_vider(historique_t *);
+approche_t APPROCHE_ajouter(historique_t *, uint16_t, uint32_t);
+
+#endif /* CAPTEUR_APPROCHE_H_ */
@@ -1,164 +1,486 @@
-/**
- ******************************************************************************
- * @file 	capteur.c
- * @date    27-January-2020
- * @author  Gautier - Dufourmantelle
- * @brief   Fonction associe aux capteurs
- * @see 	void HCSR04_demo_state_machine(void) dans le fichier HCSR04.c
- ******************************************************************************
- */
-
-#include "macro_types.h"
-#include "stm32f1_uart.h"
-#include "systick.h"
-#include "HC-SR04/HCSR04.h"
-#include "capteur.h"
-
-#define DISTANCE_OBSTACLE 1500 /** @def Distance maximale a laquelle peut se trouver un obstacle devant un capteur*/
-
-typedef struct
-{
-	uint16_t PIN_TRIG;
-	GPIO_TypeDef *GPIO_TRIG;
-	uint16_t PIN_ECHO;
-	GPIO_TypeDef *GPIO_ECHO;
-	uint8_t ID;
-} capteur_t; /** @struct Structure regroupant les infortions liees aux capteurs*/
-
-static const capteur_t capteurAvant = (capteur_t){GPIO_PIN_4, GPIOA, GPIO_PIN_8, GPIOB, 0};
-static const capteur_t capteurDroite = (capteur_t){GPIO_PIN_5, GPIOA, GPIO_PIN_9, GPIOB, 0};
-static const capteur_t capteurGauche = (capteur_t){GPIO_PIN_6, GPIOA, GPIO_PIN_10, GPIOB, 0};
-static const capteur_t capteurArriere = (capteur_t){GPIO_PIN_7, GPIOA, GPIO_PIN_11, GPIOB, 0};
-
-static uint16_t launch_measure(uint8_t);
-
-/**
- * @brief Fonction permettant de mesurer la distance à laquelle se trouve un éventuel obstacle devant le capteur
- * 			dont l'identifiant est passe en parametre
- * @param id_sensor : identifiant du capteur
- * @retval la distance en mm a laquelle se trouve l'obstacle,  
- * @retval 0xFFFF s'il n'y a pas d'obstacle ou qu'il est trop loin
- * @note Fonction copie
- * @see void HCSR04_demo_state_machine(void) dans le fichier HCSR04.c
- * @author Nirgal
- */
-static uint16_t launch_measure(uint8_t id_sensor)
-{
-	typedef enum
-	{
-		LAUNCH_MEASURE,
-		RUN,
-		WAIT_DURING_MEASURE,
-		WAIT_BEFORE_NEXT_MEASURE
-	} state_e;
-
-	static state_e state = LAUNCH_MEASURE;
-	static uint32_t tlocal;
-	uint16_t distance = 65535; //valeur max sur 16 bits, si on retourne cette valeur c'est que la meusure n'est pas faite
-
-	HCSR04_process_main();
-
-	switch (state)
-	{
-	case LAUNCH_MEASURE:
-		HCSR04_run_measure(id_sensor);
-		tlocal = HAL_GetTick();
-		state = WAIT_DURING_MEASURE;
-		break;
-	case WAIT_DURING_MEASURE:
-		switch (HCSR04_get_value(id_sensor, &distance))
-		{
-		case HAL_BUSY:
-			//rien � faire... on attend...
-			break;
-		case HAL_OK:
-			printf("sensor %d - distance : %d\n", id_sensor, distance);
-			state = WAIT_BEFORE_NEXT_MEASURE;
-			break;
-		case HAL_ERROR:
-			printf("sensor %d - erreur ou mesure non lanc�e\n", id_sensor);
-			state = WAIT_BEFORE_NEXT_MEASURE;
-			break;
-
-		case HAL_TIMEOUT:
-			printf("sensor %d - timeout\n", id_sensor);
-			state = WAIT_BEFORE_NEXT_MEASURE;
-			break;
-		}
-		break;
-	case WAIT_BEFORE_NEXT_MEASURE:
-		if (HAL_GetTick() > tlocal + 100)
-			state = LAUNCH_MEASURE;
-		break;
-	default:
-		break;
-	}
-	return distance;
-}
-
-/**
- * @brief Fonction permettant d'initialiser les 4 capteurs
- * @pre   Chaques capteurs doivent avoir un id different et etre associe a des broches differentes
- * @post  Un message est affiche dans le cas ou une erreur est survenue, sinon on affiche la reussite de l'initialisation
- */
-void CAPTEUR_init(void)
-{
-	HAL_StatusTypeDef ret;
-	ret = HCSR04_add(&capteurAvant.ID, capteurAvant.GPIO_TRIG, capteurAvant.PIN_TRIG, capteurAvant.GPIO_ECHO, capteurAvant.PIN_ECHO);
-	if (ret != HAL_OK)
-		printf("Erreur ajout capteur avant");
-	else
-	{
-		ret = HCSR04_add(&capteurDroite.ID, capteurDroite.GPIO_TRIG, capteurDroite.PIN_TRIG, capteurDroite.GPIO_ECHO, capteurDroite.PIN_ECHO);
-		if (ret != HAL_OK)
-			printf("Erreur ajout capteur droit");
-		else
-		{
-			ret = HCSR04_add(&capteurGauche.ID, capteurGauche.GPIO_TRIG, capteurGauche.PIN_TRIG, capteurGauche.GPIO_ECHO, capteurGauche.PIN_ECHO);
-			if (ret != HAL_OK)
-				printf("Erreur ajout capteur gauche");
-			else
-			{
-				ret = HCSR04_add(&capteurArriere.ID, capteurArriere.GPIO_TRIG, capteurArriere.PIN_TRIG, capteurArriere.GPIO_ECHO, capteurArriere.PIN_ECHO);
-				if (ret != HAL_OK)
-					printf("Erreur ajout capteur arriere");
-				else
-					printf("Tout les capteurs ont été ajouté avec succé");
-			}
-		}
-	}
-}
-
-/**
- * @brief 	Fonction permettant de tester le bon fonctionnement des capteurs,
- * 			ceux-ci seront allume pendant 4s
- * @pre 	Il faut avoir active les test dans le main
- */
-void CAPTEUR_process_test(void)
-{
-	static uint32_t t_capteur = 0;
-
-	while (t_capteur < 4000)
-	{
-		t_capteur++;
-		launch_measure(capteurGauche.ID);
-		launch_measure(capteurAvant.ID);
-		launch_measure(capteurDroite.ID);
-		launch_measure(capteurArriere.ID);
-	}
-}
-
-/**
- * @brief Retourne un booleen, si un obstacle à moins de 10cm
- * @param id_sensor : identifiant du capteur
- * @retval FALSE si on mesure un obstacle a 0mm ou au dela de la limite fixe
- * @retval TRUE si on mesure un obstacle a plus de 0mm et en dessous de la limite fixe
- */
-bool_e obstacle(uint8_t id)
-{
-	uint16_t mesure = launch_measure(id);
-	bool_e ret = FALSE;
-	if (mesure < DISTANCE_OBSTACLE && mesure != 0)
-		ret = TRUE;
-	return ret;
-}
+/**
+ ******************************************************************************
+ * @file 	capteur.c
+ * @date    27-January-2020
+ * @author  Gautier - Dufourmantelle
+ * @brief   Fonction associe aux capteurs
+ * @see 	void HCSR04_demo_state_machine(void) dans le fichier HCSR04.c
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "registre/registre.h"
+#include "HC-SR04/HCSR04.h"
+#include "capteur.h"
+#include "filtre.h"
+#include "evenement/evenement.h"
+#include "journal/journal.h"
+
+#if CAPTURE_MATERIELLE
+#include "echo.h"
+#define SONDE_add ECHO_add
+#define SONDE_run_measure ECHO_run_measure
+#define SONDE_get_value ECHO_get_value
+#define SONDE_process_main ECHO_process_main
+#else
+#define SONDE_add HCSR04_add
+#define SONDE_run_measure HCSR04_run_measure
+#define SONDE_get_value HCSR04_get_value
+#define SONDE_process_main HCSR04_process_main
+#endif
+
+#define DISTANCE_OBSTACLE 1500 /** @def Distance maximale a laquelle peut se trouver un obstacle devant un capteur*/
+
+typedef struct
+{
+	uint16_t PIN_TRIG;
+	GPIO_TypeDef *GPIO_TRIG;
+	uint16_t PIN_ECHO;
+	GPIO_TypeDef *GPIO_ECHO;
+	uint8_t ID;
+} capteur_t; /** @struct Structure regroupant les infortions liees aux capteurs*/
+
+#if CAPTURE_MATERIELLE
+//Les echos arrivent sur les entrees de capture de TIM2 et TIM3, voir echo.c (PA0 et PB0 a travers un pont diviseur)
+static capteur_t capteurAvant = (capteur_t){GPIO_PIN_4, GPIOA, GPIO_PIN_0, GPIOA, 0};
+static capteur_t capteurDroite = (capteur_t){GPIO_PIN_5, GPIOA, GPIO_PIN_4, GPIOB, 0};
+static capteur_t capteurGauche = (capteur_t){GPIO_PIN_6, GPIOA, GPIO_PIN_10, GPIOB, 0};
+static capteur_t capteurArriere = (capteur_t){GPIO_PIN_7, GPIOA, GPIO_PIN_0, GPIOB, 0};
+#else
+static capteur_t capteurAvant = (capteur_t){GPIO_PIN_4, GPIOA, GPIO_PIN_8, GPIOB, 0};
+static capteur_t capteurDroite = (capteur_t){GPIO_PIN_5, GPIOA, GPIO_PIN_9, GPIOB, 0};
+static capteur_t capteurGauche = (capteur_t){GPIO_PIN_6, GPIOA, GPIO_PIN_10, GPIOB, 0};
+static capteur_t capteurArriere = (capteur_t){GPIO_PIN_7, GPIOA, GPIO_PIN_11, GPIOB, 0};
+#endif
+
+#define CAPTEUR_NB 4			  /** @def Nombre de capteurs montes sur la voiture*/
+#define CAPTEURS_PAR_CRENEAU 2	  /** @def Nombre de capteurs declenches simultanement*/
+#define DUREE_MAX_CRENEAU 60	  /** @def Duree maximale d'un creneau de mesure, cycle conseille par la datasheet du HC-SR04 (en ms)*/
+#define DELAI_GARDE 10			  /** @def Silence laisse entre deux creneaux pour que les echos parasites s'eteignent (en ms)*/
+#define FENETRE_FREQUENCE 1000	  /** @def Fenetre de calcul du nombre de mesures par seconde (en ms)*/
+#define AGE_MAX_RELEVE 300		  /** @def Age au dela duquel un releve n'est plus considere comme valide, soit deux tours de creneaux (en ms)*/
+#define DELAI_SALVE 500			  /** @def Delai entre le declenchement et le debut de l'echo : impulsion TRIG + salve ultrason (en us)*/
+#define DUREE_VOL_MAX 24		  /** @def Aller-retour du son jusqu'a la portee maximale du HC-SR04, 4 m (en ms)*/
+#define FILTRE_N 3				  /** @def Largeur par defaut de la mediane glissante*/
+#define FILTRE_ALPHA 224		  /** @def Coefficient par defaut de la moyenne exponentielle (Q8)*/
+#define FILTRE_VITESSE 3000		  /** @def Variation de distance admise par defaut, voiture et obstacle confondus (en mm/s)*/
+
+typedef enum
+{
+	LANCEMENT,
+	ATTENTE_ECHO,
+	GARDE
+} etat_creneau_e; /** @enum Etats de l'ordonnanceur de mesure*/
+
+typedef struct
+{
+	uint16_t distance;	 //derniere distance mesuree en mm, 0xFFFF tant qu'aucune mesure n'a abouti
+	uint32_t date;		 //date de la derniere mesure (HAL_GetTick)
+	bool_e valide;		 //FALSE si la derniere mesure a echoue (timeout, erreur)
+	uint8_t version;	 //incremente a chaque publication, permet une lecture coherente hors interruption
+	bool_e aLancer;		 //mesure a lancer dans le creneau courant, le module peut encore emettre l'echo precedent
+	bool_e enCours;		 //mesure lancee dans le creneau courant et pas encore terminee
+	uint32_t debut;		 //date de lancement de la mesure en cours
+	uint8_t porte;		 //duree d'ecoute au dela de laquelle on conclut a l'absence d'obstacle (en ms), 0 : mesure complete
+	uint16_t compteur;	 //mesures abouties dans la fenetre courante
+	uint16_t frequence;	 //mesures abouties sur la derniere fenetre complete
+	int16_t vitesse;	 //vitesse de rapprochement estimee au dernier releve (en mm/s)
+	uint16_t ttc;		 //temps avant contact a la date du dernier releve (en ms), APPROCHE_AUCUNE si rien n'approche
+} mesure_t; /** @struct Etat propre a chaque capteur, ecrit uniquement sous interruption Systick*/
+
+/*
+ * Les capteurs opposes ne s'entendent pas : l'avant et l'arriere partagent un creneau,
+ * la droite et la gauche le suivant. Deux capteurs a 90 degres ne sont donc jamais
+ * declenches en meme temps, ce qui supprime la diaphonie entre voisins.
+ */
+static capteur_t *const creneaux[][CAPTEURS_PAR_CRENEAU] = {
+	{&capteurAvant, &capteurArriere},
+	{&capteurDroite, &capteurGauche}};
+
+#define NB_CRENEAUX (sizeof(creneaux) / sizeof(creneaux[0]))
+
+static volatile mesure_t mesures[CAPTEUR_NB];
+static historique_t historiques[CAPTEUR_NB]; //derniers releves de chaque capteur, pour l'estimation du rapprochement
+static filtre_t filtres[CAPTEUR_NB];		  //filtre des distances de chaque capteur, avant publication
+static bool_e porteExpiree = FALSE; //une mesure du creneau courant a ete close par sa porte, sa salve peut encore revenir
+
+static void CAPTEUR_process_ms(void);
+static void publier(uint8_t, uint16_t, bool_e);
+static void lancer_creneau(uint8_t);
+static bool_e attendre_creneau(uint8_t);
+static void calculer_frequences(void);
+
+/**
+ * @brief Met a jour le releve d'un capteur et reveille la boucle principale
+ * @param id : identifiant du capteur
+ * @param distance : distance mesuree en mm
+ * @param valide : FALSE si la mesure a echoue
+ */
+static void publier(uint8_t id, uint16_t distance, bool_e valide)
+{
+	uint32_t date = HAL_GetTick();
+	approche_t approche = {0, APPROCHE_AUCUNE};
+
+	//Un echec ne passe pas par le filtre : il n'apporte pas de distance
+	if (valide && distance != 0)
+		distance = FILTRE_ajouter(&filtres[id], distance, date);
+
+	//Seules les distances mesurees entrent dans l'historique : un echec ou une porte expiree le vident
+	if (valide && distance != 0 && distance != 65535)
+		approche = APPROCHE_ajouter(&historiques[id], distance, date);
+	else
+		APPROCHE_vider(&historiques[id]);
+
+	mesures[id].version++;
+	mesures[id].distance = distance;
+	mesures[id].date = date;
+	mesures[id].valide = valide;
+	mesures[id].vitesse = approche.vitesse;
+	mesures[id].ttc = approche.ttc;
+	mesures[id].version++;
+	EVENEMENT_poster(EVENEMENT_CAPTEUR);
+}
+
+/**
+ * @brief Demande le declenchement de tous les capteurs d'un creneau
+ * @param creneau : indice du creneau dans le tableau creneaux
+ */
+static void lancer_creneau(uint8_t creneau)
+{
+	for (uint8_t i = 0; i < CAPTEURS_PAR_CRENEAU; i++)
+		mesures[creneaux[creneau][i]->ID].aLancer = TRUE;
+}
+
+/**
+ * @brief Declenche les capteurs du creneau qui ne l'ont pas encore ete et recupere les mesures terminees.
+ * 			Une mesure dont l'echo n'est pas revenu a l'expiration de sa porte est publiee comme "rien en deca de la porte"
+ * 			sans attendre la fin de l'echo : le creneau suivant peut commencer pendant que le module finit son impulsion.
+ * @param creneau : indice du creneau dans le tableau creneaux
+ * @retval TRUE quand tous les capteurs du creneau ont fini (echo, porte expiree, erreur ou timeout)
+ */
+static bool_e attendre_creneau(uint8_t creneau)
+{
+	bool_e fini = TRUE;
+
+	for (uint8_t i = 0; i < CAPTEURS_PAR_CRENEAU; i++)
+	{
+		uint8_t id = creneaux[creneau][i]->ID;
+		uint16_t distance;
+
+		if (mesures[id].aLancer)
+		{
+			switch (SONDE_run_measure(id))
+			{
+			case HAL_OK:
+				mesures[id].aLancer = FALSE;
+				mesures[id].enCours = TRUE;
+				mesures[id].debut = HAL_GetTick();
+				break;
+			case HAL_BUSY: //Le module n'a pas fini l'echo de la mesure precedente, on reessaie au prochain tick
+				fini = FALSE;
+				break;
+			default:
+				mesures[id].aLancer = FALSE;
+				publier(id, 65535, FALSE);
+				break;
+			}
+		}
+		if (!mesures[id].enCours)
+			continue;
+		switch (SONDE_get_value(id, &distance))
+		{
+		case HAL_BUSY:
+			if (mesures[id].porte && HAL_GetTick() - mesures[id].debut > mesures[id].porte)
+			{
+				porteExpiree = TRUE;
+				publier(id, 65535, TRUE);
+				mesures[id].compteur++;
+				mesures[id].enCours = FALSE;
+			}
+			else
+				fini = FALSE;
+			break;
+		case HAL_OK:
+			publier(id, distance, TRUE);
+			mesures[id].compteur++;
+			mesures[id].enCours = FALSE;
+			break;
+		case HAL_ERROR:
+		case HAL_TIMEOUT:
+			publier(id, 65535, FALSE);
+			mesures[id].enCours = FALSE;
+			break;
+		}
+	}
+	return fini;
+}
+
+/**
+ * @brief Met a jour le nombre de mesures par seconde de chaque capteur a la fin de chaque fenetre
+ */
+static void calculer_frequences(void)
+{
+	static uint32_t debutFenetre = 0;
+	uint32_t maintenant = HAL_GetTick();
+
+	if (maintenant - debutFenetre >= FENETRE_FREQUENCE)
+	{
+		for (uint8_t id = 0; id < CAPTEUR_NB; id++)
+		{
+			mesures[id].frequence = (uint16_t)(((uint32_t)mesures[id].compteur * 1000) / (maintenant - debutFenetre));
+			mesures[id].compteur = 0;
+		}
+		debutFenetre = maintenant;
+	}
+}
+
+/**
+ * @brief Ordonnanceur des mesures : enchaine les creneaux aussi vite que les echos le permettent.
+ * 			Un creneau se termine des que tous ses capteurs ont repondu, ou au bout de DUREE_MAX_CRENEAU.
+ * @note  Appele chaque ms par la routine d'interruption du Systick, le reste du code ne lit que les releves
+ */
+static void CAPTEUR_process_ms(void)
+{
+	static etat_creneau_e state = LANCEMENT;
+	static uint8_t creneau = 0;
+	static uint32_t tlocal;
+	static uint32_t tlancement;
+
+	SONDE_process_main();
+
+	switch (state)
+	{
+	case LANCEMENT:
+		lancer_creneau(creneau);
+		porteExpiree = FALSE;
+		tlocal = HAL_GetTick();
+		tlancement = tlocal;
+		state = ATTENTE_ECHO;
+		__attribute__((fallthrough)); //l'echo le plus court peut deja etre arrive
+	case ATTENTE_ECHO:
+		if (attendre_creneau(creneau) || HAL_GetTick() - tlocal > DUREE_MAX_CRENEAU)
+		{
+			for (uint8_t i = 0; i < CAPTEURS_PAR_CRENEAU; i++)
+				mesures[creneaux[creneau][i]->ID].aLancer = FALSE;
+			tlocal = HAL_GetTick();
+			state = GARDE;
+		}
+		break;
+	case GARDE:
+		//Apres une porte expiree, la salve court encore : on attend qu'elle ait atteint la portee maximale avant d'ecouter les voisins
+		if (HAL_GetTick() - tlocal >= DELAI_GARDE && (!porteExpiree || HAL_GetTick() - tlancement >= DUREE_VOL_MAX))
+		{
+			creneau = (creneau + 1) % NB_CRENEAUX;
+			state = LANCEMENT;
+		}
+		break;
+	default:
+		break;
+	}
+	calculer_frequences();
+}
+
+/**
+ * @brief Nombre de mesures abouties par seconde pour un capteur
+ * @param id : identifiant du capteur
+ * @retval le nombre de mesures sur la derniere seconde complete
+ */
+uint16_t CAPTEUR_get_frequence(uint8_t id)
+{
+	return (id < CAPTEUR_NB) ? mesures[id].frequence : 0;
+}
+
+/**
+ * @brief Regle la porte en distance d'un capteur : au dela, la mesure est close des que l'echo
+ * 			correspondant a cette distance aurait du revenir, et le releve indique l'absence d'obstacle (0xFFFF)
+ * @param id : identifiant du capteur
+ * @param distance : distance de la porte en mm, 0 pour attendre l'echo complet
+ */
+void CAPTEUR_set_porte(uint8_t id, uint16_t distance)
+{
+	if (id >= CAPTEUR_NB)
+		return;
+	if (distance)
+		mesures[id].porte = (uint8_t)((((uint32_t)distance * 58) / 10 + DELAI_SALVE + 999) / 1000);
+	else
+		mesures[id].porte = 0;
+}
+
+/**
+ * @brief Regle le filtre des distances d'un capteur et le remet a zero
+ * @param id : identifiant du capteur
+ * @param n : largeur de la mediane glissante (impaire, au plus FILTRE_N_MAX, 1 pour s'en passer)
+ * @param alpha : coefficient de la moyenne exponentielle (Q8, 256 pour s'en passer)
+ * @param vitesse : variation de distance admise entre deux releves (en mm/s), au dela un releve doit etre confirme
+ */
+void CAPTEUR_set_filtre(uint8_t id, uint8_t n, uint16_t alpha, uint16_t vitesse)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	if (id >= CAPTEUR_NB)
+		return;
+	__disable_irq();
+	FILTRE_init(&filtres[id], n, alpha, vitesse);
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Lecture en temps constant du dernier releve d'un capteur, sans toucher au pilote
+ * @param id : identifiant du capteur
+ * @retval le releve : distance en mm, age en ms et validite. Un releve plus vieux que AGE_MAX_RELEVE est invalide.
+ */
+releve_t CAPTEUR_get_releve(uint8_t id)
+{
+	releve_t releve = {65535, 0xFFFFFFFF, FALSE};
+	uint32_t date;
+	uint8_t version;
+
+	if (id >= CAPTEUR_NB)
+		return releve;
+	do
+	{ //Si le Systick a publie pendant la lecture, on relit
+		version = mesures[id].version;
+		releve.distance = mesures[id].distance;
+		releve.valide = mesures[id].valide;
+		date = mesures[id].date;
+	} while (version != mesures[id].version);
+
+	releve.age = HAL_GetTick() - date;
+	if (releve.age > AGE_MAX_RELEVE)
+		releve.valide = FALSE;
+	return releve;
+}
+
+/**
+ * @param id : identifiant du capteur
+ * @param portee : distance rendue quand rien n'est vu plus pres (en mm)
+ * @retval la distance du dernier releve du capteur, bornee a portee (en mm)
+ */
+uint16_t CAPTEUR_get_distance(uint8_t id, uint16_t portee)
+{
+	releve_t releve = CAPTEUR_get_releve(id);
+
+	//Un releve invalide ou nul n'indique pas d'obstacle, comme pour obstacle()
+	if (!releve.valide || releve.distance == 0 || releve.distance > portee)
+		return portee;
+	return releve.distance;
+}
+
+/**
+ * @brief Lecture coherente de l'estimation du rapprochement d'un obstacle
+ * @param id : identifiant du capteur
+ * @retval la vitesse de rapprochement (en mm/s) et le temps avant contact compte a partir de maintenant (en ms).
+ * 			Sans releve valide recent, la vitesse est nulle et le temps avant contact vaut APPROCHE_AUCUNE.
+ */
+approche_t CAPTEUR_get_approche(uint8_t id)
+{
+	approche_t approche = {0, APPROCHE_AUCUNE};
+	uint32_t age;
+	uint8_t version;
+
+	if (id >= CAPTEUR_NB)
+		return approche;
+	do
+	{
+		version = mesures[id].version;
+		approche.vitesse = mesures[id].vitesse;
+		approche.ttc = mesures[id].ttc;
+		age = HAL_GetTick() - mesures[id].date;
+	} while (version != mesures[id].version);
+
+	if (age > AGE_MAX_RELEVE)
+		return (approche_t){0, APPROCHE_AUCUNE};
+	if (approche.ttc != APPROCHE_AUCUNE)
+		approche.ttc = (approche.ttc > age) ? approche.ttc - age : 0;
+	return approche;
+}
+
+/**
+ * @brief Fonction permettant d'initialiser les 4 capteurs
+ * @pre   Chaques capteurs doivent avoir un id different et etre associe a des broches differentes
+ * @post  Un message est journalise si une erreur est survenue, sinon la reussite est journalisee de l'initialisation
+ */
+void CAPTEUR_init(void)
+{
+	HAL_StatusTypeDef ret;
+	for (uint8_t id = 0; id < CAPTEUR_NB; id++)
+	{
+		mesures[id].distance = 65535;
+		CAPTEUR_set_filtre(id, FILTRE_N, FILTRE_ALPHA, FILTRE_VITESSE);
+		CAPTEUR_set_porte(id, DISTANCE_OBSTACLE); //Seule la presence d'un obstacle sous le seuil interesse obstacle()
+	}
+	ret = SONDE_add(&capteurAvant.ID, capteurAvant.GPIO_TRIG, capteurAvant.PIN_TRIG, capteurAvant.GPIO_ECHO, capteurAvant.PIN_ECHO);
+	if (ret != HAL_OK)
+		JOURNAL_1(JOURNAL_ERREUR_AJOUT_CAPTEUR, 0);
+	else
+	{
+		ret = SONDE_add(&capteurDroite.ID, capteurDroite.GPIO_TRIG, capteurDroite.PIN_TRIG, capteurDroite.GPIO_ECHO, capteurDroite.PIN_ECHO);
+		if (ret != HAL_OK)
+			JOURNAL_1(JOURNAL_ERREUR_AJOUT_CAPTEUR, 1);
+		else
+		{
+			ret = SONDE_add(&capteurGauche.ID, capteurGauche.GPIO_TRIG, capteurGauche.PIN_TRIG, capteurGauche.GPIO_ECHO, capteurGauche.PIN_ECHO);
+			if (ret != HAL_OK)
+				JOURNAL_1(JOURNAL_ERREUR_AJOUT_CAPTEUR, 2);
+			else
+			{
+				ret = SONDE_add(&capteurArriere.ID, capteurArriere.GPIO_TRIG, capteurArriere.PIN_TRIG, capteurArriere.GPIO_ECHO, capteurArriere.PIN_ECHO);
+				if (ret != HAL_OK)
+					JOURNAL_1(JOURNAL_ERREUR_AJOUT_CAPTEUR, 3);
+				else
+					JOURNAL_0(JOURNAL_CAPTEURS_AJOUTES);
+			}
+		}
+	}
+	REGISTRE_reserver(&CAPTEUR_process_ms, "CAPTEUR_process_ms", TRUE); //Les mesures tournent en tache de fond
+}
+
+/**
+ * @brief 	Fonction permettant de tester le bon fonctionnement des capteurs :
+ * 			le dernier releve et le nombre de mesures par seconde de chacun sont journalises
+ * @pre 	Il faut avoir active les test dans le main, dont la tache laisse tourner les capteurs 4s avant l'appel
+ */
+void CAPTEUR_process_test(void)
+{
+	for (uint8_t id = 0; id < CAPTEUR_NB; id++)
+	{
+		releve_t releve = CAPTEUR_get_releve(id);
+		if (releve.valide)
+			JOURNAL_4(JOURNAL_RELEVE, id, releve.distance, releve.age, CAPTEUR_get_frequence(id));
+		else
+			JOURNAL_3(JOURNAL_RELEVE_INVALIDE, id, releve.age, CAPTEUR_get_frequence(id));
+	}
+}
+
+/**
+ * @brief Retourne un booleen, si un obstacle est a moins de DISTANCE_OBSTACLE (1500 mm)
+ * 			d'apres le dernier releve valide du capteur
+ * @param id : identifiant du capteur
+ * @retval FALSE si on mesure un obstacle a 0mm ou a DISTANCE_OBSTACLE et au dela
+ * @retval TRUE si on mesure un obstacle a plus de 0mm et en deca de DISTANCE_OBSTACLE
+ */
+bool_e obstacle(uint8_t id)
+{
+	releve_t releve = CAPTEUR_get_releve(id);
+	bool_e ret = FALSE;
+
+	if (releve.valide && releve.distance < DISTANCE_OBSTACLE && releve.distance != 0)
+		ret = TRUE;
+	return ret;
+}
+
+/**
+ * @brief Retourne un booleen, si un obstacle approche assez vite pour etre touche avant un delai,
+ * 			d'apres la vitesse de rapprochement estimee sur les derniers releves du capteur
+ * @param id : identifiant du capteur
+ * @param delai : temps avant contact en deca duquel l'obstacle est imminent (en ms)
+ * @retval TRUE si l'obstacle approche et sera atteint avant le delai
+ * @note  Condition d'arret au temps avant contact du regulateur de croisiere
+ */
+bool_e obstacle_imminent(uint8_t id, uint16_t delai)
+{
+	uint16_t ttc = CAPTEUR_get_approche(id).ttc;
+
+	return ttc != APPROCHE_AUCUNE && ttc < delai;
+}
@@ -1,15 +1,35 @@
-/*
- * capteur.h
- *
- *  Created on: 14 janv. 2020
- *      Author: gauti
- */
-
-#ifndef CAPTEUR_CAPTEUR_H_
-#define CAPTEUR_CAPTEUR_H_
-
-void CAPTEUR_init(void);
-void CAPTEUR_process_test(void);
-bool_e obstacle (uint8_t);
-
-#endif /* CAPTEUR_CAPTEUR_H_ */
+/*
+ * capteur.h
+ *
+ *  Created on: 14 janv. 2020
+ *      Author: gauti
+ */
+
+#ifndef CAPTEUR_CAPTEUR_H_
+#define CAPTEUR_CAPTEUR_H_
+
+#include "approche.h"
+
+#ifndef CAPTURE_MATERIELLE
+#define CAPTURE_MATERIELLE 0 /** @def 1 : echos dates par les entrees de capture des timers (echo.c), 0 : pilote HCSR04 de la librairie (EXTI)*/
+#endif
+
+typedef struct
+{
+	uint16_t distance; //distance mesuree en mm
+	uint32_t age;	   //temps ecoule depuis la mesure en ms
+	bool_e valide;	   //FALSE si la mesure a echoue ou est trop ancienne
+} releve_t; /** @struct Dernier releve d'un capteur*/
+
+void CAPTEUR_init(void);
+void CAPTEUR_process_test(void);
+uint16_t CAPTEUR_get_frequence(uint8_t);
+releve_t CAPTEUR_get_releve(uint8_t);
+uint16_t CAPTEUR_get_distance(uint8_t, uint16_t);
+void CAPTEUR_set_porte(uint8_t, uint16_t);
+void CAPTEUR_set_filtre(uint8_t, uint8_t, uint16_t, uint16_t);
+approche_t CAPTEUR_get_approche(uint8_t);
+bool_e obstacle (uint8_t);
+bool_e obstacle_imminent(uint8_t, uint16_t);
+
+#endif /* CAPTEUR_CAPTEUR_H_ */
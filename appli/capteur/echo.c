@@ -0,0 +1,214 @@
+/**
+ ******************************************************************************
+ * @file 	echo.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Mesure des echos HC-SR04 par les entrees de capture des timers.
+ * 			Chaque echo est relie a l'entree TI1 ou TI3 d'un timer : le canal direct
+ * 			capture le front montant, le canal voisin, branche en indirect sur la meme
+ * 			entree, capture le front descendant. La largeur est la difference des deux
+ * 			captures, datee par le materiel a 1 us pres, quelle que soit la charge du CPU.
+ * 			Aucune interruption n'est utilisee : les drapeaux sont lus par l'ordonnanceur de capteur.c.
+ * @note	Cablage impose par les remappages partiels :
+ * 			TIM2 (remap partiel 2) : PA0 (TI1), PB10 (TI3)
+ * 			TIM3 (remap partiel)   : PB4 (TI1), PB0 (TI3), PB4 n'est libre qu'une fois le JTAG desactive
+ * 			TIM4 reste reserve au haut-parleur. PA0 et PB0 ne sont pas tolerantes 5 V :
+ * 			l'echo du module doit y arriver a travers un pont diviseur.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "stm32f1_gpio.h"
+#include "echo.h"
+
+#define ECHO_NB_SENSORS 4	  /** @def Nombre d'entrees de capture disponibles*/
+#define ECHO_TIMEOUT 150	  /** @def Duree maximale d'une mesure, comme le pilote HCSR04 (en ms)*/
+#define PRESCALER_1MHZ 71	  /** @def Horloge timer 72 MHz divisee par 72 : une unite de compteur par us*/
+#define BOUCLE_TRIG 120		  /** @def Iterations d'attente pour une impulsion TRIG d'au moins 10 us*/
+
+typedef struct
+{
+	GPIO_TypeDef *gpio;
+	uint16_t pin;
+	TIM_HandleTypeDef *htim;
+	uint32_t canalMontee;	 //canal direct, capture le front montant
+	uint32_t canalDescente; //canal indirect sur la meme entree, capture le front descendant
+	uint32_t drapeauMontee;
+	uint32_t drapeauDescente;
+	uint32_t debordement;	 //drapeau de sur-capture du front descendant : plusieurs echos dans la meme mesure
+} entree_t; /** @struct Entree de capture pouvant recevoir un echo*/
+
+typedef enum
+{
+	ECHO_INEXISTANT = 0,
+	ECHO_REPOS,
+	ECHO_MESURE
+} etat_echo_e; /** @enum Etat d'un capteur enregistre*/
+
+typedef struct
+{
+	etat_echo_e etat;
+	GPIO_TypeDef *gpioTrig;
+	uint16_t pinTrig;
+	const entree_t *entree;
+	uint32_t debut;
+} capteur_echo_t; /** @struct Capteur enregistre*/
+
+static TIM_HandleTypeDef htim2 = {.Instance = TIM2};
+static TIM_HandleTypeDef htim3 = {.Instance = TIM3};
+
+static const entree_t entrees[ECHO_NB_SENSORS] = {
+	{GPIOA, GPIO_PIN_0, &htim2, TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_FLAG_CC1, TIM_FLAG_CC2, TIM_FLAG_CC2OF},
+	{GPIOB, GPIO_PIN_10, &htim2, TIM_CHANNEL_3, TIM_CHANNEL_4, TIM_FLAG_CC3, TIM_FLAG_CC4, TIM_FLAG_CC4OF},
+	{GPIOB, GPIO_PIN_4, &htim3, TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_FLAG_CC1, TIM_FLAG_CC2, TIM_FLAG_CC2OF},
+	{GPIOB, GPIO_PIN_0, &htim3, TIM_CHANNEL_3, TIM_CHANNEL_4, TIM_FLAG_CC3, TIM_FLAG_CC4, TIM_FLAG_CC4OF}};
+
+static capteur_echo_t capteurs[ECHO_NB_SENSORS];
+static uint8_t nbCapteurs = 0;
+
+static void init_timer(TIM_HandleTypeDef *);
+static void init_entree(const entree_t *);
+
+/**
+ * @brief Timer en comptage libre a 1 MHz sur 16 bits, une seule fois par timer
+ */
+static void init_timer(TIM_HandleTypeDef *htim)
+{
+	if (htim->Instance->CR1 & TIM_CR1_CEN)
+		return;
+	__HAL_RCC_AFIO_CLK_ENABLE();
+	__HAL_AFIO_REMAP_SWJ_NOJTAG(); //libere PB4 (et PA15 de la LED rouge), le SWD reste disponible
+	if (htim->Instance == TIM2)
+	{
+		__HAL_RCC_TIM2_CLK_ENABLE();
+		__HAL_AFIO_REMAP_TIM2_PARTIAL_2();
+	}
+	else
+	{
+		__HAL_RCC_TIM3_CLK_ENABLE();
+		__HAL_AFIO_REMAP_TIM3_PARTIAL();
+	}
+	htim->Init.Prescaler = PRESCALER_1MHZ;
+	htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+	htim->Init.Period = 0xFFFF;
+	htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	htim->Init.RepetitionCounter = 0;
+	htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	HAL_TIM_IC_Init(htim);
+}
+
+/**
+ * @brief Configure la paire de canaux d'une entree : direct sur front montant, indirect sur front descendant
+ */
+static void init_entree(const entree_t *e)
+{
+	TIM_IC_InitTypeDef ic = {0};
+
+	BSP_GPIO_PinCfg(e->gpio, e->pin, GPIO_MODE_INPUT, GPIO_NOPULL, GPIO_SPEED_FREQ_HIGH);
+	init_timer(e->htim);
+	ic.ICPrescaler = TIM_ICPSC_DIV1;
+	ic.ICFilter = 0;
+	ic.ICPolarity = TIM_ICPOLARITY_RISING;
+	ic.ICSelection = TIM_ICSELECTION_DIRECTTI;
+	HAL_TIM_IC_ConfigChannel(e->htim, &ic, e->canalMontee);
+	ic.ICPolarity = TIM_ICPOLARITY_FALLING;
+	ic.ICSelection = TIM_ICSELECTION_INDIRECTTI;
+	HAL_TIM_IC_ConfigChannel(e->htim, &ic, e->canalDescente);
+	HAL_TIM_IC_Start(e->htim, e->canalMontee);
+	HAL_TIM_IC_Start(e->htim, e->canalDescente);
+}
+
+/**
+ * @brief Enregistre un capteur, avec la meme signature que HCSR04_add
+ * @param id : identifiant attribue au capteur
+ * @param TRIG_GPIO, TRIG_PIN : broche de declenchement
+ * @param ECHO_GPIO, ECHO_PIN : broche d'echo, qui doit etre l'une des entrees de capture du tableau entrees
+ * @retval HAL_ERROR si la broche d'echo n'est pas une entree de capture ou si tous les capteurs sont pris
+ */
+HAL_StatusTypeDef ECHO_add(uint8_t *id, GPIO_TypeDef *TRIG_GPIO, uint16_t TRIG_PIN, GPIO_TypeDef *ECHO_GPIO, uint16_t ECHO_PIN)
+{
+	if (nbCapteurs >= ECHO_NB_SENSORS)
+		return HAL_ERROR;
+	for (uint8_t i = 0; i < ECHO_NB_SENSORS; i++)
+	{
+		if (entrees[i].gpio == ECHO_GPIO && entrees[i].pin == ECHO_PIN)
+		{
+			BSP_GPIO_PinCfg(TRIG_GPIO, TRIG_PIN, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL, GPIO_SPEED_FREQ_HIGH);
+			HAL_GPIO_WritePin(TRIG_GPIO, TRIG_PIN, GPIO_PIN_RESET);
+			init_entree(&entrees[i]);
+			capteurs[nbCapteurs].etat = ECHO_REPOS;
+			capteurs[nbCapteurs].gpioTrig = TRIG_GPIO;
+			capteurs[nbCapteurs].pinTrig = TRIG_PIN;
+			capteurs[nbCapteurs].entree = &entrees[i];
+			*id = nbCapteurs++;
+			return HAL_OK;
+		}
+	}
+	return HAL_ERROR;
+}
+
+/**
+ * @brief Declenche une mesure : efface les captures precedentes puis envoie l'impulsion TRIG
+ * @retval HAL_BUSY si l'echo de la mesure precedente est encore haut (le module ignorerait le declenchement)
+ */
+HAL_StatusTypeDef ECHO_run_measure(uint8_t id)
+{
+	capteur_echo_t *c;
+
+	if (id >= nbCapteurs)
+		return HAL_ERROR;
+	c = &capteurs[id];
+	if (HAL_GPIO_ReadPin(c->entree->gpio, c->entree->pin) == GPIO_PIN_SET)
+		return HAL_BUSY;
+
+	__HAL_TIM_CLEAR_FLAG(c->entree->htim, c->entree->drapeauMontee | c->entree->drapeauDescente | c->entree->debordement);
+	HAL_GPIO_WritePin(c->gpioTrig, c->pinTrig, GPIO_PIN_SET);
+	for (volatile uint16_t i = 0; i < BOUCLE_TRIG; i++)
+		;
+	HAL_GPIO_WritePin(c->gpioTrig, c->pinTrig, GPIO_PIN_RESET);
+	c->debut = HAL_GetTick();
+	c->etat = ECHO_MESURE;
+	return HAL_OK;
+}
+
+/**
+ * @brief Recupere la distance d'une mesure lancee, sans attente
+ * @param distance : distance en mm, ecrite uniquement si HAL_OK
+ * @retval HAL_BUSY tant que le front descendant n'a pas ete capture, HAL_TIMEOUT au bout de ECHO_TIMEOUT,
+ * 			HAL_ERROR si aucune mesure n'est en cours ou si plusieurs echos se sont chevauches
+ */
+HAL_StatusTypeDef ECHO_get_value(uint8_t id, uint16_t *distance)
+{
+	capteur_echo_t *c;
+	const entree_t *e;
+	uint16_t montee, descente;
+
+	if (id >= nbCapteurs || capteurs[id].etat != ECHO_MESURE)
+		return HAL_ERROR;
+	c = &capteurs[id];
+	e = c->entree;
+	if (!__HAL_TIM_GET_FLAG(e->htim, e->drapeauDescente))
+	{
+		if (HAL_GetTick() - c->debut < ECHO_TIMEOUT)
+			return HAL_BUSY;
+		c->etat = ECHO_REPOS;
+		return HAL_TIMEOUT;
+	}
+	c->etat = ECHO_REPOS;
+	if (!__HAL_TIM_GET_FLAG(e->htim, e->drapeauMontee) || __HAL_TIM_GET_FLAG(e->htim, e->debordement))
+		return HAL_ERROR;
+	//La lecture des registres de capture efface CCxIF ; la soustraction sur 16 bits absorbe le debordement du compteur
+	montee = (uint16_t)__HAL_TIM_GET_COMPARE(e->htim, e->canalMontee);
+	descente = (uint16_t)__HAL_TIM_GET_COMPARE(e->htim, e->canalDescente);
+	*distance = (uint16_t)(((uint32_t)(uint16_t)(descente - montee) * 10) / 58);
+	return HAL_OK;
+}
+
+/**
+ * @brief Rien a faire en tache de fond : les fronts sont dates par le materiel et les timeouts traites a la lecture.
+ * 			Conserve pour garder la meme interface que le pilote HCSR04.
+ */
+void ECHO_process_main(void)
+{
+}
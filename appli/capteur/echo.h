@@ -0,0 +1,16 @@
+/*
+ * echo.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: gauti
+ */
+
+#ifndef CAPTEUR_ECHO_H_
+#define CAPTEUR_ECHO_H_
+
+HAL_StatusTypeDef ECHO_add(uint8_t *, GPIO_TypeDef *, uint16_t, GPIO_TypeDef *, uint16_t);
+HAL_StatusTypeDef ECHO_run_measure(uint8_t);
+HAL_StatusTypeDef ECHO_get_value(uint8_t, uint16_t *);
+void ECHO_process_main(void);
+
+#endif /* CAPTEUR_ECHO_H_ */
@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @file 	filtre.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Filtrage des distances d'un capteur ultrason, en entiers pour le Cortex-M3 sans FPU :
+ * 			- porte de variation : un releve trop loin de la sortie courante pour la vitesse
+ * 			  admise est mis de cote, il n'est accepte que si le releve suivant le confirme.
+ * 			  Un echo parasite isole ne passe donc jamais, un obstacle reel passe au second releve.
+ * 			- mediane glissante des n derniers releves acceptes, contournee quand ils decroissent
+ * 			  regulierement : un obstacle qui se rapproche est suivi sans le releve de retard
+ * 			  de la mediane, au prix de quelques echos parasites de plus pris pour lui,
+ * 			- moyenne exponentielle de la mediane, en Q4.
+ * 			"Rien en deca de la porte" (FILTRE_LOIN) est une distance comme une autre pour
+ * 			la mediane, mais remet la moyenne a zero : on ne lisse pas vers l'infini.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "filtre.h"
+
+#define MARGE 60		 /** @def Variation toujours admise en plus de la vitesse, bruit et resolution de date (en mm)*/
+#define REJETS_MAX 3	 /** @def Releves rejetes d'affilee au bout desquels le filtre se recale sur la mesure*/
+#define Q 4				 /** @def Bits fractionnaires de la moyenne*/
+
+static void remplir(filtre_t *, uint16_t);
+static uint16_t mediane(const filtre_t *);
+static bool_e proche(uint16_t, uint16_t, uint32_t);
+static bool_e rapprochement(const filtre_t *);
+
+/**
+ * @brief Initialise un filtre
+ * @param f : filtre a initialiser
+ * @param n : largeur de la mediane, ramenee a un nombre impair entre 1 et FILTRE_N_MAX
+ * @param alpha : coefficient de la moyenne exponentielle (Q8 : 256 pour la recopier, 64 pour un quart)
+ * @param vitesseMax : variation de distance admise entre deux releves (en mm/s)
+ */
+void FILTRE_init(filtre_t *f, uint8_t n, uint16_t alpha, uint16_t vitesseMax)
+{
+	f->n = (n > FILTRE_N_MAX) ? FILTRE_N_MAX : (n | 1); //FILTRE_N_MAX est impair
+	f->alpha = (alpha == 0) ? 1 : (alpha > 256) ? 256 : alpha;
+	f->vitesseMax = vitesseMax;
+	f->rejets = 0;
+	f->candidat = FILTRE_LOIN;
+	f->date = 0;
+	remplir(f, FILTRE_LOIN);
+}
+
+/**
+ * @brief Remplit la fenetre et la moyenne avec une meme distance : recalage du filtre
+ */
+static void remplir(filtre_t *f, uint16_t distance)
+{
+	for (uint8_t i = 0; i < f->n; i++)
+		f->fenetre[i] = distance;
+	f->tete = 0;
+	f->moyenne = (int32_t)distance << Q;
+}
+
+/**
+ * @brief Mediane de la fenetre par tri par insertion d'une copie (n <= FILTRE_N_MAX)
+ */
+static uint16_t mediane(const filtre_t *f)
+{
+	uint16_t tri[FILTRE_N_MAX];
+
+	for (uint8_t i = 0; i < f->n; i++)
+	{
+		uint16_t v = f->fenetre[i];
+		uint8_t j = i;
+		while (j > 0 && tri[j - 1] > v)
+		{
+			tri[j] = tri[j - 1];
+			j--;
+		}
+		tri[j] = v;
+	}
+	return tri[f->n / 2];
+}
+
+/**
+ * @retval TRUE si les releves de la fenetre decroissent regulierement, du plus ancien au plus recent :
+ * 			chaque baisse au plus double de la precedente, a MARGE pres. Un echo parasite
+ * 			admis par la porte fait une baisse isolee et reste a la mediane.
+ */
+static bool_e rapprochement(const filtre_t *f)
+{
+	uint8_t i = f->tete; //plus ancien releve
+	uint32_t baisse = UINT32_MAX;
+
+	for (uint8_t k = 1; k < f->n; k++)
+	{
+		uint8_t suivant = (i + 1 == f->n) ? 0 : i + 1;
+		uint32_t b;
+
+		if (f->fenetre[suivant] >= f->fenetre[i])
+			return FALSE;
+		b = f->fenetre[i] - f->fenetre[suivant];
+		if (baisse != UINT32_MAX && b > 2 * baisse + MARGE)
+			return FALSE;
+		baisse = b;
+		i = suivant;
+	}
+	return TRUE;
+}
+
+/**
+ * @retval TRUE si deux distances different d'au plus seuil mm
+ */
+static bool_e proche(uint16_t a, uint16_t b, uint32_t seuil)
+{
+	return (uint32_t)((a > b) ? a - b : b - a) <= seuil;
+}
+
+/**
+ * @brief Filtre un releve
+ * @param f : filtre du capteur
+ * @param distance : distance mesuree (en mm), FILTRE_LOIN si rien n'est vu en deca de la porte
+ * @param date : date du releve (en ms)
+ * @retval la distance filtree (en mm), FILTRE_LOIN si rien n'est vu
+ */
+uint16_t FILTRE_ajouter(filtre_t *f, uint16_t distance, uint32_t date)
+{
+	uint16_t sortie = (uint16_t)((f->moyenne + (1 << (Q - 1))) >> Q);
+	uint32_t duree = date - f->date;
+	uint32_t seuil = MARGE + (duree < 1000 ? duree : 1000) * f->vitesseMax / 1000;
+	uint16_t m;
+
+	if (!proche(distance, sortie, seuil))
+	{ //Saut : accepte seulement s'il confirme le releve rejete precedent
+		if (f->rejets && (proche(distance, f->candidat, seuil) || f->rejets >= REJETS_MAX))
+		{
+			f->rejets = 0;
+			f->date = date;
+			remplir(f, distance);
+			return distance;
+		}
+		f->rejets++;
+		f->candidat = distance;
+		return sortie;
+	}
+	f->rejets = 0;
+	f->date = date;
+	f->fenetre[f->tete] = distance;
+	f->tete = (f->tete + 1 == f->n) ? 0 : f->tete + 1;
+
+	//Obstacle qui se rapproche regulierement : la mediane le suivrait avec un releve de retard
+	m = (f->n > 1 && rapprochement(f)) ? distance : mediane(f);
+	if (m == FILTRE_LOIN || sortie == FILTRE_LOIN)
+		f->moyenne = (int32_t)m << Q;
+	else
+		f->moyenne += ((((int32_t)m << Q) - f->moyenne) * f->alpha) >> 8;
+	return (uint16_t)((f->moyenne + (1 << (Q - 1))) >> Q);
+}
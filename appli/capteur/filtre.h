@@ -0,0 +1,30 @@
+/*
+ * filtre.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: gauti
+ */
+
+#ifndef CAPTEUR_FILTRE_H_
+#define CAPTEUR_FILTRE_H_
+
+#define FILTRE_N_MAX 7		  /** @def Largeur maximale de la mediane glissante*/
+#define FILTRE_LOIN 65535	  /** @def Distance publiee quand rien n'est vu en deca de la porte*/
+
+typedef struct
+{
+	uint16_t fenetre[FILTRE_N_MAX]; //derniers releves acceptes, en anneau
+	uint8_t n;						//largeur de la mediane (impaire, au plus FILTRE_N_MAX)
+	uint8_t tete;					//prochaine case ecrite de la fenetre
+	uint8_t rejets;					//releves rejetes d'affilee par la porte de variation
+	uint16_t alpha;					//coefficient de la moyenne exponentielle (Q8, 256 : pas de lissage)
+	uint16_t vitesseMax;			//variation admise entre deux releves (en mm/s)
+	uint16_t candidat;				//dernier releve rejete, accepte si le suivant le confirme
+	uint32_t date;					//date du dernier releve accepte (en ms)
+	int32_t moyenne;				//sortie lissee (Q4, en 1/16 mm), FILTRE_LOIN << 4 quand rien n'est vu
+} filtre_t; /** @struct Etat du filtre d'un capteur, a allouer par l'appelant*/
+
+void FILTRE_init(filtre_t *, uint8_t, uint16_t, uint16_t);
+uint16_t FILTRE_ajouter(filtre_t *, uint16_t, uint32_t);
+
+#endif /* CAPTEUR_FILTRE_H_ */
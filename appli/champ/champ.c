@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ * @file 	champ.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Pilotage continu par champ de repulsion : les distances avant, droite et
+ * 			gauche sont converties en repulsions (0 au dela de CHAMP_PORTEE, 256 au contact)
+ * 			dont la somme donne une correction de cap. La correction est retranchee a une
+ * 			roue et ajoutee a l'autre : la voiture contourne les obstacles en arc, sans
+ * 			s'arreter ni reculer. Le cap estime par l'odometrie attire la voiture vers sa
+ * 			direction de depart une fois l'obstacle passe.
+ * 			Tout est en entiers, le calcul est a temps constant.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "stm32f1xx_hal.h"
+#include "capteur/capteur.h"
+#include "comportement/comportement.h"
+#include "minuterie/minuterie.h"
+#include "odometrie/odometrie.h"
+#include "champ.h"
+
+#define GAIN_COTE 60	  /** @def Ecart entre les roues pour un mur lateral au contact (en %)*/
+#define GAIN_AVANT 90	  /** @def Ecart entre les roues pour un obstacle avant au contact (en %)*/
+#define ECART_MAX 100	  /** @def Ecart maximal entre les roues : la roue interieure s'arrete au pire (en %)*/
+#define GAIN_CAP 80		  /** @def Ecart entre les roues par radian d'ecart a la direction de depart (en %)*/
+#define RAPPEL_MAX 60	  /** @def Ecart maximal du au rappel vers la direction de depart (en %)*/
+#define CAP_CHOIX 150	  /** @def Ecart a la direction de depart au dela duquel un obstacle avant est contourne en y revenant (en mrad)*/
+#define CAP_LIMITE 1400	  /** @def Ecart a la direction de depart au dela duquel le contournement change de cote : evite le demi-tour (en mrad)*/
+#define DEGAGE 600		  /** @def Distance laterale minimale du cote choisi pour contourner (en mm)*/
+#define PASSAGE 1500	  /** @def Duree sans rappel apres la perte de vue d'un obstacle avant : le temps de le depasser (en ms)*/
+#define PI_MRAD 3142
+
+static uint8_t capteurAvant, capteurDroite, capteurGauche;
+static int8_t sens = 1;		//cote du dernier evitement frontal : 1 a gauche, -1 a droite
+static bool_e devantVu = FALSE; //un obstacle avant etait vu au pas precedent
+static uint16_t passage = 0;	//temps restant avant de rappeler la voiture vers sa direction de depart (en ms)
+static int32_t cap = 0; //ecart a la direction de depart, positif a gauche (en mrad, entre -pi et pi)
+static uint32_t dernier; //date de la commande precedente (en ms)
+
+static int32_t repulsion(uint16_t);
+
+/**
+ * @brief Associe le pilotage a ses capteurs
+ * @param avant : identifiant du capteur avant
+ * @param droite : identifiant du capteur droit
+ * @param gauche : identifiant du capteur gauche
+ */
+void CHAMP_init(uint8_t avant, uint8_t droite, uint8_t gauche)
+{
+	capteurAvant = avant;
+	capteurDroite = droite;
+	capteurGauche = gauche;
+}
+
+/**
+ * @brief Repulsion d'un obstacle, quadratique pour peser peu au loin et beaucoup de pres
+ * @retval 0 au dela de CHAMP_PORTEE, 256 au contact
+ */
+static int32_t repulsion(uint16_t d)
+{
+	int32_t proche;
+
+	if (d >= CHAMP_PORTEE)
+		return 0;
+	proche = ((int32_t)(CHAMP_PORTEE - d) << 8) / CHAMP_PORTEE;
+	return (proche * proche) >> 8;
+}
+
+/**
+ * @brief Commande des roues d'apres trois distances
+ * @param avant : distance de l'obstacle avant (en mm)
+ * @param droite : distance du mur droit (en mm)
+ * @param gauche : distance du mur gauche (en mm)
+ * @param puissance : vitesse d'avance voulue (en %)
+ * @retval la commande des roues, jamais en marche arriere
+ */
+commande_t CHAMP_calculer(uint16_t avant, uint16_t droite, uint16_t gauche, uint8_t puissance)
+{
+	int32_t ecart; //positif : la voiture tourne a gauche
+	int32_t rappel;
+
+	ecart = (GAIN_COTE * (repulsion(droite) - repulsion(gauche))) >> 8;
+	rappel = -GAIN_CAP * cap / 1000;
+	//Pas de rappel pendant le contournement ni vers un cote encombre : l'obstacle qu'on vient de perdre de vue est a cote
+	if (passage || (rappel > 0 && gauche < DEGAGE) || (rappel < 0 && droite < DEGAGE))
+		rappel = 0;
+	ecart += (rappel > RAPPEL_MAX) ? RAPPEL_MAX : (rappel < -RAPPEL_MAX) ? -RAPPEL_MAX : rappel;
+	if (avant < CHAMP_PORTEE)
+	{
+		//Le cote de contournement est choisi a la decouverte de l'obstacle et garde tant qu'il est vu :
+		//de preference celui qui ramene vers la direction de depart, sinon le plus degage
+		if (!devantVu)
+		{
+			if (cap > CAP_CHOIX && droite > DEGAGE)
+				sens = -1;
+			else if (cap < -CAP_CHOIX && gauche > DEGAGE)
+				sens = 1;
+			else if (gauche > droite + 100)
+				sens = 1;
+			else if (droite > gauche + 100)
+				sens = -1;
+		}
+		else if (sens > 0 && cap > CAP_LIMITE)
+			sens = -1;
+		else if (sens < 0 && cap < -CAP_LIMITE)
+			sens = 1;
+		ecart += sens * ((GAIN_AVANT * repulsion(avant)) >> 8);
+	}
+	devantVu = (avant < CHAMP_PORTEE);
+	if (devantVu)
+		passage = PASSAGE;
+	if (ecart > ECART_MAX)
+		ecart = ECART_MAX;
+	else if (ecart < -ECART_MAX)
+		ecart = -ECART_MAX;
+
+	return COMPORTEMENT_repartir(puissance, ecart);
+}
+
+/**
+ * @brief Commande des roues d'apres les derniers releves des capteurs avant et lateraux
+ * @param puissance : vitesse d'avance voulue (en %), typiquement celle du regulateur de croisiere
+ */
+commande_t CHAMP_commande(uint8_t puissance)
+{
+	uint32_t maintenant = MINUTERIE_maintenant();
+	uint32_t ecoule = maintenant - dernier;
+
+	dernier = maintenant;
+	passage = (passage > ecoule) ? passage - ecoule : 0;
+	cap = (int32_t)ODOMETRIE_get_pose().cap * PI_MRAD / ODOMETRIE_DEMI_TOUR;
+	return CHAMP_calculer(CAPTEUR_get_distance(capteurAvant, CHAMP_PORTEE), CAPTEUR_get_distance(capteurDroite, CHAMP_PORTEE), CAPTEUR_get_distance(capteurGauche, CHAMP_PORTEE), puissance);
+}
@@ -0,0 +1,18 @@
+/**
+ ******************************************************************************
+ * @file 	champ.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef CHAMP_CHAMP_H_
+#define CHAMP_CHAMP_H_
+
+#define CHAMP_PORTEE 1500 /** @def Distance au dela de laquelle un obstacle ne repousse plus la voiture (en mm)*/
+
+void CHAMP_init(uint8_t, uint8_t, uint8_t);
+commande_t CHAMP_calculer(uint16_t, uint16_t, uint16_t, uint8_t);
+commande_t CHAMP_commande(uint8_t);
+
+#endif /* CHAMP_CHAMP_H_ */
@@ -0,0 +1,240 @@
+/**
+ ******************************************************************************
+ * @file 	comportement.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Arbitrage de comportements a la maniere de la subsomption.
+ * 			A chaque pas de controle, cadence par une minuterie periodique, tous les
+ * 			comportements proposent une commande des roues ou s'abstiennent. La plus
+ * 			haute priorite proposante l'emporte ; les propositions de meme priorite sont
+ * 			melangees par moyenne ponderee et la plus lourde est le maitre des moteurs.
+ * 			Le cout d'un pas est borne : COMPORTEMENT_NB_MAX propositions a temps constant.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "evenement/evenement.h"
+#include "moteur/moteur.h"
+#include "comportement.h"
+
+static const comportement_t *comportements;
+static uint8_t nb = 0;
+static uint16_t periode;
+static minuterie_t minuterie;		 //cadence des pas de controle
+static uint8_t maitre = COMPORTEMENT_AUCUN;
+static uint32_t debut;				 //date de la prise des moteurs par le maitre (en ms)
+static uint32_t dernierPas;			 //date du pas precedent (en ms)
+static commande_t appliquee;		 //derniere commande envoyee aux moteurs
+static stat_comportement_t stats[COMPORTEMENT_NB_MAX];
+static stat_arbitre_t arbitre;
+static uint64_t coutTotal = 0;
+
+static void cadence(void);
+static void changer_maitre(uint8_t, uint32_t);
+
+/**
+ * @brief Echeance de la periode de controle : reveille la boucle principale
+ */
+static void cadence(void)
+{
+	EVENEMENT_poster(EVENEMENT_CONTROLE);
+}
+
+/**
+ * @brief Solde la possession du maitre sortant et donne les moteurs a un autre comportement
+ */
+static void changer_maitre(uint8_t nouveau, uint32_t maintenant)
+{
+	if (maitre != COMPORTEMENT_AUCUN)
+	{
+		uint32_t tenue = maintenant - debut;
+		stats[maitre].duree += tenue;
+		if (tenue > stats[maitre].plusLong)
+			stats[maitre].plusLong = tenue;
+	}
+	maitre = nouveau;
+	debut = maintenant;
+	if (maitre != COMPORTEMENT_AUCUN)
+	{
+		stats[maitre].prises++;
+		if (comportements[maitre].prise)
+			comportements[maitre].prise();
+	}
+}
+
+/**
+ * @brief Installe les comportements et lance la cadence de controle
+ * @param c : tableau des comportements
+ * @param n : nombre de comportements, au plus COMPORTEMENT_NB_MAX
+ * @param periodeMs : periode des pas de controle (en ms, au moins 1)
+ * @retval FALSE si les parametres sont invalides : rien n'est installe
+ * @pre   A appeler apres MINUTERIE_init et EVENEMENT_init. La boucle principale appelle
+ * 			COMPORTEMENT_pas a chaque EVENEMENT_CONTROLE.
+ */
+bool_e COMPORTEMENT_init(const comportement_t *c, uint8_t n, uint16_t periodeMs)
+{
+	if (n == 0 || n > COMPORTEMENT_NB_MAX || periodeMs == 0)
+		return FALSE;
+	for (uint8_t i = 0; i < n; i++)
+	{
+		if (c[i].proposer == NULL || c[i].poids == 0)
+			return FALSE;
+		stats[i] = (stat_comportement_t){0};
+	}
+	comportements = c;
+	nb = n;
+	periode = periodeMs;
+	maitre = COMPORTEMENT_AUCUN;
+	appliquee = (commande_t){0, 0};
+	dernierPas = MINUTERIE_maintenant();
+	MINUTERIE_armer(&minuterie, periode, periode, &cadence);
+	return TRUE;
+}
+
+/**
+ * @brief Pas de controle : recueille les propositions, elit le maitre et commande les moteurs
+ */
+void COMPORTEMENT_pas(void)
+{
+	uint32_t cycles = DWT->CYCCNT;
+	uint32_t maintenant = MINUTERIE_maintenant();
+	uint8_t meilleure = 0;
+	uint8_t elu = COMPORTEMENT_AUCUN;
+	uint8_t contributions = 0;
+	int32_t droite = 0, gauche = 0, poids = 0;
+	commande_t c;
+
+	if (!nb)
+		return;
+	arbitre.pas++;
+	if (maintenant - dernierPas > periode)
+		arbitre.retards++;
+	dernierPas = maintenant;
+
+	//Tous les comportements proposent a chaque pas : leur etat interne avance meme quand ils ne gagnent pas
+	for (uint8_t i = 0; i < nb; i++)
+	{
+		if (!comportements[i].proposer(&c))
+			continue;
+		if (elu == COMPORTEMENT_AUCUN || comportements[i].priorite > meilleure)
+		{
+			meilleure = comportements[i].priorite;
+			elu = i;
+			contributions = 0;
+			droite = gauche = poids = 0;
+		}
+		else if (comportements[i].priorite < meilleure)
+			continue;
+		else if (comportements[i].poids > comportements[elu].poids)
+			elu = i;
+		contributions++;
+		droite += (int32_t)c.droite * comportements[i].poids;
+		gauche += (int32_t)c.gauche * comportements[i].poids;
+		poids += comportements[i].poids;
+	}
+	if (contributions > 1)
+		arbitre.fusions++;
+	if (elu == COMPORTEMENT_AUCUN)
+		c = (commande_t){0, 0};
+	else
+		c = (commande_t){(int8_t)(droite / poids), (int8_t)(gauche / poids)};
+	if (c.droite != appliquee.droite || c.gauche != appliquee.gauche)
+	{
+		MOTEUR_commander(c.droite, c.gauche);
+		appliquee = c;
+		arbitre.commandes++;
+	}
+	if (elu != COMPORTEMENT_AUCUN)
+		stats[elu].pas++;
+	cycles = DWT->CYCCNT - cycles;
+	coutTotal += cycles;
+	arbitre.moy = (uint32_t)(coutTotal / arbitre.pas);
+	if (cycles > arbitre.max)
+		arbitre.max = cycles;
+
+	if (elu != maitre)
+		changer_maitre(elu, maintenant);
+}
+
+/**
+ * @retval l'indice du comportement maitre des moteurs, COMPORTEMENT_AUCUN si aucun ne propose
+ */
+uint8_t COMPORTEMENT_get_maitre(void)
+{
+	return maitre;
+}
+
+/**
+ * @retval le temps depuis lequel le maitre actuel tient les moteurs (en ms)
+ */
+uint32_t COMPORTEMENT_duree(void)
+{
+	return MINUTERIE_maintenant() - debut;
+}
+
+uint8_t COMPORTEMENT_get_nb(void)
+{
+	return nb;
+}
+
+const char *COMPORTEMENT_get_nom(uint8_t i)
+{
+	return (i < nb) ? comportements[i].nom : "?";
+}
+
+/**
+ * @retval les compteurs de possession d'un comportement, la possession en cours comprise
+ */
+stat_comportement_t COMPORTEMENT_get_stat(uint8_t i)
+{
+	stat_comportement_t s = {0};
+
+	if (i < nb)
+	{
+		s = stats[i];
+		if (i == maitre)
+		{
+			uint32_t tenue = COMPORTEMENT_duree();
+			s.duree += tenue;
+			if (tenue > s.plusLong)
+				s.plusLong = tenue;
+		}
+	}
+	return s;
+}
+
+stat_arbitre_t COMPORTEMENT_get_stat_arbitre(void)
+{
+	return arbitre;
+}
+
+/**
+ * @brief Repartit un ecart entre les roues autour d'une vitesse d'avance
+ * @param puissance : vitesse d'avance voulue (en %)
+ * @param ecart : difference entre la roue droite et la roue gauche, positive pour tourner a gauche (en %)
+ * @retval la commande des roues, jamais en marche arriere
+ */
+commande_t COMPORTEMENT_repartir(uint8_t puissance, int32_t ecart)
+{
+	int32_t d = puissance + ecart / 2;
+	int32_t g = puissance - ecart / 2;
+
+	//Une roue saturee reporte le surplus sur l'autre pour conserver l'ecart
+	if (d > 100)
+	{
+		g -= d - 100;
+		d = 100;
+	}
+	if (g > 100)
+	{
+		d -= g - 100;
+		g = 100;
+	}
+	if (d < 0)
+		d = 0;
+	if (g < 0)
+		g = 0;
+	return (commande_t){(int8_t)d, (int8_t)g};
+}
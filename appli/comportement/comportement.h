@@ -0,0 +1,60 @@
+/**
+ ******************************************************************************
+ * @file 	comportement.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef COMPORTEMENT_COMPORTEMENT_H_
+#define COMPORTEMENT_COMPORTEMENT_H_
+
+#define COMPORTEMENT_NB_MAX 8	  /** @def Nombre maximal de comportements arbitres*/
+#define COMPORTEMENT_AUCUN 0xFF /** @def Maitre rendu quand aucun comportement ne propose de commande*/
+
+typedef struct
+{
+	int8_t droite; //rapport cyclique de la roue droite (en %, signe selon le sens)
+	int8_t gauche;
+} commande_t;	   /** @struct Commande des deux roues proposee par un comportement*/
+
+typedef bool_e (*proposer_t)(commande_t *); /** @def Remplit la commande et rend TRUE si le comportement veut les moteurs*/
+
+typedef struct
+{
+	const char *nom;
+	proposer_t proposer;
+	callback_fun_t prise; //appelee quand le comportement prend les moteurs (LED, HP...), NULL si aucune
+	uint8_t priorite;	  //la plus haute priorite proposante l'emporte
+	uint8_t poids;		  //poids dans la moyenne des propositions de meme priorite, au moins 1
+} comportement_t;		  /** @struct Description d'un comportement*/
+
+typedef struct
+{
+	uint32_t pas;	   //pas de controle ou le comportement avait les moteurs
+	uint32_t prises;   //nombre de fois ou il les a pris
+	uint32_t duree;	   //temps total passe maitre des moteurs (en ms)
+	uint32_t plusLong; //plus longue possession continue (en ms)
+} stat_comportement_t; /** @struct Possession des moteurs par un comportement*/
+
+typedef struct
+{
+	uint32_t pas;		//pas de controle executes
+	uint32_t fusions;	//pas ou plusieurs propositions de meme priorite ont ete melangees
+	uint32_t retards;	//pas executes plus d'une periode apres le precedent
+	uint32_t commandes; //commandes envoyees aux moteurs
+	uint32_t moy;		//cout moyen d'un pas, propositions comprises, hors fonctions de prise (en cycles)
+	uint32_t max;
+} stat_arbitre_t;		/** @struct Compteurs de l'arbitre*/
+
+bool_e COMPORTEMENT_init(const comportement_t *, uint8_t, uint16_t);
+void COMPORTEMENT_pas(void);
+uint8_t COMPORTEMENT_get_maitre(void);
+uint32_t COMPORTEMENT_duree(void);
+uint8_t COMPORTEMENT_get_nb(void);
+const char *COMPORTEMENT_get_nom(uint8_t);
+stat_comportement_t COMPORTEMENT_get_stat(uint8_t);
+stat_arbitre_t COMPORTEMENT_get_stat_arbitre(void);
+commande_t COMPORTEMENT_repartir(uint8_t, int32_t);
+
+#endif /* COMPORTEMENT_COMPORTEMENT_H_ */
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file 	croisiere.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Regulateur de croisiere : la puissance de marche avant decroit continument
+ * 			avec la distance de l'obstacle avant, corrigee de la vitesse de rapprochement.
+ * 			La voiture s'arrete quand l'obstacle sera atteint en moins de TTC_ARRET ms,
+ * 			ou en deca d'une distance d'arret reglable : un obstacle qui approche vite
+ * 			arrete la voiture plus tot, un obstacle approche lentement plus pres.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "stm32f1xx_hal.h"
+#include "capteur/capteur.h"
+#include "croisiere.h"
+
+#define DISTANCE_ARRET 250	/** @def Distance avant en deca de laquelle la voiture s'arrete quelle que soit sa vitesse (en mm)*/
+#define TTC_ARRET 1000		/** @def Temps avant contact en deca duquel la voiture s'arrete (en ms)*/
+#define DISTANCE_LIBRE 1500 /** @def Distance au dela de laquelle la voiture roule a pleine puissance, porte du capteur avant (en mm)*/
+#define HYSTERESIS 100		/** @def Marge au dessus de la distance d'arret pour repartir, evite de hacher pres du seuil (en mm)*/
+#define PUISSANCE_MAX 100	/** @def Puissance en voie libre (en %)*/
+#define PUISSANCE_MIN 30	/** @def Puissance a la distance d'arret, la plus faible qui fasse encore avancer la voiture (en %)*/
+#define ANTICIPATION 500	/** @def Horizon sur lequel le rapprochement est retranche de la distance (en ms)*/
+
+static uint8_t capteur; //identifiant du capteur avant
+static uint16_t distanceArret = DISTANCE_ARRET;
+static bool_e arrete = FALSE; //la derniere reponse etait un arret
+
+/**
+ * @brief Associe le regulateur au capteur avant
+ * @param id : identifiant du capteur dont la distance regle la puissance
+ */
+void CROISIERE_init(uint8_t id)
+{
+	capteur = id;
+}
+
+/**
+ * @brief Regle la distance d'arret
+ * @param distance : distance avant en deca de laquelle CROISIERE_puissance rend 0 (en mm, inferieure a la porte avant)
+ */
+void CROISIERE_set_arret(uint16_t distance)
+{
+	distanceArret = (distance < DISTANCE_LIBRE - HYSTERESIS) ? distance : DISTANCE_LIBRE - HYSTERESIS;
+}
+
+/**
+ * @brief Puissance de marche avant d'apres le dernier releve du capteur avant.
+ * 		Entre la distance d'arret et DISTANCE_LIBRE, la puissance va lineairement de PUISSANCE_MIN a PUISSANCE_MAX ;
+ * 		la distance utilisee est celle que l'obstacle aura dans ANTICIPATION ms au rapprochement estime par capteur.c.
+ * @retval la puissance en %, 0 si la voiture doit s'arreter
+ */
+uint8_t CROISIERE_puissance(void)
+{
+	releve_t releve = CAPTEUR_get_releve(capteur);
+	approche_t approche = CAPTEUR_get_approche(capteur);
+	int32_t distance;
+
+	//Un releve invalide ou nul n'indique pas d'obstacle, comme pour obstacle()
+	if (!releve.valide || releve.distance == 0 || releve.distance >= DISTANCE_LIBRE)
+	{
+		arrete = FALSE;
+		return PUISSANCE_MAX;
+	}
+
+	if (releve.distance < distanceArret || obstacle_imminent(capteur, TTC_ARRET) || (arrete && releve.distance < distanceArret + HYSTERESIS))
+	{
+		arrete = TRUE;
+		return 0;
+	}
+	arrete = FALSE;
+
+	distance = releve.distance;
+	if (approche.vitesse > 0)
+		distance -= (int32_t)approche.vitesse * ANTICIPATION / 1000;
+	if (distance <= distanceArret)
+		return PUISSANCE_MIN;
+	return (uint8_t)(PUISSANCE_MIN + (PUISSANCE_MAX - PUISSANCE_MIN) * (distance - distanceArret) / (DISTANCE_LIBRE - distanceArret));
+}
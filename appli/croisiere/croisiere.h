@@ -0,0 +1,16 @@
+/**
+ ******************************************************************************
+ * @file 	croisiere.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef CROISIERE_CROISIERE_H_
+#define CROISIERE_CROISIERE_H_
+
+void CROISIERE_init(uint8_t);
+uint8_t CROISIERE_puissance(void);
+void CROISIERE_set_arret(uint16_t);
+
+#endif /* CROISIERE_CROISIERE_H_ */
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file 	evenement.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Boucle evenementielle : les interruptions postent des evenements,
+ * 			la boucle principale dort (WFI) tant qu'aucun n'est en attente
+ * @note	Le temps de veille est mesure avec le compteur de cycles DWT du Cortex-M3
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "evenement.h"
+
+#define CYCLES_PAR_FENETRE 72000000UL /** @def Fenetre de calcul du temps de repos, une seconde a 72 MHz (en cycles)*/
+
+//Un drapeau par evenement : une ecriture d'octet est atomique, les interruptions peuvent poster sans se gener
+static volatile bool_e enAttente[EVENEMENT_NB];
+
+static uint32_t reveils = 0;
+static uint32_t traites = 0;
+static uint32_t debutFenetre = 0;
+static uint32_t veilleFenetre = 0; //cycles passes en veille dans la fenetre courante
+static uint8_t repos = 0;
+
+static void calculer_repos(void);
+
+/**
+ * @brief Demarre le compteur de cycles utilise pour mesurer le temps de veille
+ */
+void EVENEMENT_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	debutFenetre = DWT->CYCCNT;
+}
+
+/**
+ * @brief Signale un evenement a la boucle principale, appelable depuis une interruption
+ * @param evenement : evenement a signaler, plusieurs signalements avant traitement n'en font qu'un
+ */
+void EVENEMENT_poster(evenement_e evenement)
+{
+	if (evenement < EVENEMENT_NB)
+		enAttente[evenement] = TRUE;
+}
+
+/**
+ * @brief Met a jour le pourcentage de repos a la fin de chaque fenetre
+ */
+static void calculer_repos(void)
+{
+	uint32_t ecoule = DWT->CYCCNT - debutFenetre;
+
+	if (ecoule >= CYCLES_PAR_FENETRE)
+	{
+		repos = (uint8_t)(((uint64_t)veilleFenetre * 100) / ecoule);
+		veilleFenetre = 0;
+		debutFenetre += ecoule;
+	}
+}
+
+/**
+ * @brief Endort le processeur jusqu'a ce qu'au moins un evenement soit en attente
+ * @retval le masque des evenements en attente (EVENEMENT_MASQUE), qui sont consommes
+ * @note  Les interruptions sont masquees entre le test et le WFI : un evenement poste juste avant
+ * 			la mise en veille reveille quand meme le coeur, et la routine s'execute au demasquage.
+ */
+uint32_t EVENEMENT_attendre(void)
+{
+	uint32_t masque = 0;
+
+	__disable_irq();
+	for (;;)
+	{
+		for (uint8_t e = 0; e < EVENEMENT_NB; e++)
+		{
+			if (enAttente[e])
+			{
+				enAttente[e] = FALSE;
+				masque |= EVENEMENT_MASQUE(e);
+				traites++;
+			}
+		}
+		if (masque)
+			break;
+		uint32_t debut = DWT->CYCCNT;
+		__WFI();
+		veilleFenetre += DWT->CYCCNT - debut;
+		reveils++;
+		__enable_irq(); //la routine qui a reveille le coeur s'execute ici
+		__disable_irq();
+	}
+	__enable_irq();
+	calculer_repos();
+	return masque;
+}
+
+/**
+ * @brief Compteurs de la boucle evenementielle
+ * @retval les nombres de reveils et d'evenements traites, et le temps de repos sur la derniere seconde
+ */
+stat_evenement_t EVENEMENT_get_stat(void)
+{
+	return (stat_evenement_t){reveils, traites, repos};
+}
@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @file 	evenement.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef EVENEMENT_H_
+#define EVENEMENT_H_
+
+typedef enum
+{
+	EVENEMENT_CAPTEUR = 0, //un nouveau releve a ete publie
+	EVENEMENT_TIMER,	   //une echeance de main.c est atteinte
+	EVENEMENT_CONTROLE,	   //une periode de l'arbitrage des comportements est ecoulee
+	EVENEMENT_VIRAGE,	   //le virage demande au gyroscope a atteint son angle
+	EVENEMENT_TACHE,	   //une tache de l'ordonnanceur est arrivee a echeance
+	EVENEMENT_BOUTON,	   //reserve : aucun bouton n'est cable sur la voiture
+	EVENEMENT_NB
+} evenement_e; /** @enum Evenements pouvant reveiller la boucle principale*/
+
+#define EVENEMENT_MASQUE(e) (1UL << (e)) /** @def Bit de l'evenement dans le masque rendu par EVENEMENT_attendre*/
+
+typedef struct
+{
+	uint32_t reveils; //sorties de veille
+	uint32_t traites; //evenements rendus a la boucle principale
+	uint8_t repos;	  //part du temps passee en veille sur la derniere seconde complete (en %)
+} stat_evenement_t; /** @struct Compteurs de la boucle evenementielle*/
+
+void EVENEMENT_init(void);
+void EVENEMENT_poster(evenement_e);
+uint32_t EVENEMENT_attendre(void);
+stat_evenement_t EVENEMENT_get_stat(void);
+
+#endif /* EVENEMENT_H_ */
@@ -0,0 +1,306 @@
+/**
+ ******************************************************************************
+ * @file 	grille.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Grille d'occupation locale alimentee par les capteurs ultrason : la voiture se
+ * 			souvient des obstacles qu'elle ne voit plus. Chaque cellule contient un log-odds
+ * 			sur 8 bits : 0 inconnue, positif occupee, negatif libre. Un releve rend libres les
+ * 			cellules traversees par l'axe du faisceau et occupee celle de l'echo.
+ * 			La fenetre de GRILLE_COTE x GRILLE_COTE cellules (4 Ko) est indexee modulo son cote :
+ * 			quand la voiture s'eloigne de son centre, seules les colonnes ou lignes quittees
+ * 			sont effacees pour etre reutilisees de l'autre cote, rien n'est recopie.
+ * 			Positions dans le repere de l'odometrie, en mm Q8 pour le trace des faisceaux.
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "capteur/capteur.h"
+#include "odometrie/odometrie.h"
+#include "grille.h"
+
+#define BITS_CELLULE 6	/** @def log2(GRILLE_CELLULE)*/
+#define BITS_COTE 6		/** @def log2(GRILLE_COTE)*/
+#define VIRGULE 8		/** @def Positions en virgule fixe Q8*/
+#define PAS (GRILLE_CELLULE / 2) /** @def Pas du trace d'un faisceau : une demi-cellule, aucune cellule traversee n'est sautee en diagonale (en mm)*/
+#define MARGE 4			/** @def Ecart au centre de la fenetre, en cellules, au dela duquel elle est recentree sur la voiture*/
+#define LIBRE 6			/** @def Log-odds retranche a une cellule traversee par un faisceau*/
+#define OCCUPE 40		/** @def Log-odds ajoute a la cellule d'un echo : un echo suffit a l'occuper, deux faisceaux qui la traversent la liberent*/
+#define SATURATION 100	/** @def Borne des log-odds : une cellule change d'avis en quelques releves*/
+#define AGE_MAX 100		/** @def Age au dela duquel un releve n'est plus integre, la pose ayant change depuis (en ms)*/
+#define DEMI_LARGEUR 120 /** @def Demi-largeur du couloir examine dans une direction : rayon de la voiture et une marge (en mm)*/
+#define LIGNES 3		 /** @def Lignes du couloir de chaque cote de son axe, espacees de moins d'une demi-diagonale de cellule*/
+
+static int8_t cellules[GRILLE_COTE * GRILLE_COTE];
+static int32_t origineX, origineY; //cellule du coin de la fenetre, en cellules dans le repere de l'odometrie
+static const monture_t *montures;
+static uint8_t nbMontures;
+static uint32_t dates[GRILLE_NB_MONTURES]; //date du dernier releve integre de chaque capteur (en ms)
+static stat_grille_t stat;
+static uint64_t coutTotal;
+
+#define INDEX(cx, cy) ((((cy) & (GRILLE_COTE - 1)) << BITS_COTE) | ((cx) & (GRILLE_COTE - 1)))
+
+static bool_e dedans(int32_t, int32_t);
+static void modifier(int32_t, int32_t, int8_t);
+static void recentrer(pose_t);
+
+/**
+ * @brief Efface la grille, centree sur l'origine de l'odometrie, et associe les capteurs
+ * @param m : position de chaque capteur sur la voiture
+ * @param n : nombre de capteurs, au plus GRILLE_NB_MONTURES
+ */
+void GRILLE_init(const monture_t *m, uint8_t n)
+{
+	memset(cellules, 0, sizeof(cellules));
+	origineX = origineY = -GRILLE_COTE / 2;
+	montures = m;
+	nbMontures = (n > GRILLE_NB_MONTURES) ? GRILLE_NB_MONTURES : n;
+	memset(dates, 0, sizeof(dates));
+	stat = (stat_grille_t){0};
+	coutTotal = 0;
+}
+
+/**
+ * @brief Pas de la grille, a appeler a la cadence de controle apres l'odometrie : la fenetre
+ * 			suit la voiture puis les releves parus depuis le pas precedent sont integres
+ * @param pose : pose estimee de la voiture
+ */
+void GRILLE_pas(pose_t pose)
+{
+	uint32_t maintenant = HAL_GetTick();
+
+	recentrer(pose);
+	for (uint8_t i = 0; i < nbMontures; i++)
+	{
+		releve_t r = CAPTEUR_get_releve(montures[i].capteur);
+		uint32_t date = maintenant - r.age;
+
+		if (!r.valide || r.age > AGE_MAX || date == dates[i])
+			continue;
+		dates[i] = date;
+		GRILLE_ajouter(pose, i, r.distance);
+	}
+}
+
+/**
+ * @brief Integre un releve : libere les cellules sur l'axe du faisceau et occupe celle de l'echo.
+ * 			Le cone du capteur n'est pas trace, les vues successives sous d'autres angles le completent.
+ * 			Au plus GRILLE_PORTEE / PAS cellules sont touchees : le cout est borne.
+ * @param pose : pose de la voiture au moment du releve
+ * @param monture : indice du capteur dans le tableau donne a GRILLE_init
+ * @param distance : distance mesuree (en mm), au dela de GRILLE_PORTEE le faisceau est libre jusqu'a la portee
+ */
+void GRILLE_ajouter(pose_t pose, uint8_t monture, uint16_t distance)
+{
+	uint32_t cycles = DWT->CYCCNT;
+	const monture_t *m;
+	int32_t c, s, fc, fs, px, py, ex, ey, dernierX, dernierY;
+	uint16_t faisceau, portee, limite;
+	bool_e echo = (distance <= GRILLE_PORTEE);
+	uint8_t touchees = 0;
+
+	if (distance == 0 || monture >= nbMontures)
+		return;
+	m = &montures[monture];
+	c = ODOMETRIE_sinus((uint16_t)pose.cap + 0x4000);
+	s = ODOMETRIE_sinus((uint16_t)pose.cap);
+	faisceau = (uint16_t)pose.cap + (uint16_t)m->angle;
+	fc = ODOMETRIE_sinus(faisceau + 0x4000);
+	fs = ODOMETRIE_sinus(faisceau);
+	//Position du capteur (en mm Q8) : les produits par un sinus Q15 sont ramenes en Q8
+	px = (pose.x << VIRGULE) + ((m->avance * c - m->lateral * s) >> (15 - VIRGULE));
+	py = (pose.y << VIRGULE) + ((m->avance * s + m->lateral * c) >> (15 - VIRGULE));
+	portee = echo ? distance : GRILLE_PORTEE;
+	ex = (px + ((int32_t)portee * fc >> (15 - VIRGULE))) >> (VIRGULE + BITS_CELLULE);
+	ey = (py + ((int32_t)portee * fs >> (15 - VIRGULE))) >> (VIRGULE + BITS_CELLULE);
+	dernierX = ex; //la cellule de l'echo n'est jamais liberee
+	dernierY = ey;
+	limite = echo ? ((portee > PAS) ? portee - PAS : 0) : portee + 1;
+	for (uint16_t d = 0; d < limite; d += PAS)
+	{
+		int32_t cx = px >> (VIRGULE + BITS_CELLULE), cy = py >> (VIRGULE + BITS_CELLULE);
+		if (cx != dernierX || cy != dernierY)
+		{
+			modifier(cx, cy, -LIBRE);
+			dernierX = cx;
+			dernierY = cy;
+			touchees++;
+		}
+		px += fc * PAS >> (15 - VIRGULE);
+		py += fs * PAS >> (15 - VIRGULE);
+	}
+	if (echo)
+	{
+		modifier(ex, ey, OCCUPE);
+		touchees++;
+	}
+
+	stat.releves++;
+	if (touchees > stat.cellulesMax)
+		stat.cellulesMax = touchees;
+	cycles = DWT->CYCCNT - cycles;
+	coutTotal += cycles;
+	stat.moy = (uint32_t)(coutTotal / stat.releves);
+	if (cycles > stat.max)
+		stat.max = cycles;
+}
+
+/**
+ * @brief Distance libre devant la voiture dans une direction : un couloir de la largeur de la voiture
+ * 			est parcouru jusqu'a la premiere cellule occupee. Les cellules inconnues sont tenues pour libres.
+ * 			Les lignes espacees de DEMI_LARGEUR / LIGNES et le pas de PAS echantillonnent le couloir plus
+ * 			finement qu'une cellule : une cellule en biais ne passe pas entre deux echantillons.
+ * @param pose : pose de la voiture
+ * @param direction : direction par rapport au cap de la voiture, positive a gauche (angle binaire)
+ * @retval la distance libre, GRILLE_PORTEE au plus (en mm)
+ */
+uint16_t GRILLE_degagement(pose_t pose, int16_t direction)
+{
+	uint16_t a = (uint16_t)pose.cap + (uint16_t)direction;
+	int32_t c = ODOMETRIE_sinus(a + 0x4000), s = ODOMETRIE_sinus(a);
+	int32_t px = pose.x << VIRGULE, py = pose.y << VIRGULE;
+	int32_t lx = -s * (DEMI_LARGEUR / LIGNES) >> (15 - VIRGULE), ly = c * (DEMI_LARGEUR / LIGNES) >> (15 - VIRGULE); //ecart entre deux lignes, vers la gauche
+
+	for (uint16_t d = PAS; d <= GRILLE_PORTEE; d += PAS)
+	{
+		px += c * PAS >> (15 - VIRGULE);
+		py += s * PAS >> (15 - VIRGULE);
+		for (int8_t ligne = -LIGNES; ligne <= LIGNES; ligne++)
+		{
+			int32_t cx = (px + ligne * lx) >> (VIRGULE + BITS_CELLULE), cy = (py + ligne * ly) >> (VIRGULE + BITS_CELLULE);
+			if (dedans(cx, cy) && cellules[INDEX(cx, cy)] > GRILLE_SEUIL_OCCUPE)
+				return d - PAS;
+		}
+	}
+	return GRILLE_PORTEE;
+}
+
+/**
+ * @brief Cherche la direction la plus degagee parmi GRILLE_NB_DIRECTIONS reparties sur un tour,
+ * 			l'arriere exclu : reculer est l'affaire de la navigation, pas d'une rotation.
+ * 			A degagement egal, la plus proche de l'avant l'emporte, la droite avant la gauche.
+ * @param pose : pose de la voiture
+ * @param degagement : si non NULL, recoit la distance libre dans la direction choisie (en mm)
+ * @retval la direction choisie par rapport au cap de la voiture, positive a gauche (angle binaire)
+ */
+int16_t GRILLE_direction_libre(pose_t pose, uint16_t *degagement)
+{
+	uint32_t cycles = DWT->CYCCNT;
+	int16_t meilleure = 0;
+	uint16_t plusLong = 0;
+
+	for (uint8_t k = 0; k < GRILLE_NB_DIRECTIONS / 2; k++)
+	{
+		for (int8_t sens = -1; sens <= 1; sens += 2)
+		{
+			int16_t direction = (int16_t)(sens * k * (65536 / GRILLE_NB_DIRECTIONS));
+			uint16_t d;
+
+			if (k == 0 && sens > 0)
+				continue; //l'avant n'est examine qu'une fois
+			d = GRILLE_degagement(pose, direction);
+			if (d > plusLong || (k == 0 && sens < 0))
+			{
+				plusLong = d;
+				meilleure = direction;
+			}
+		}
+	}
+	if (degagement)
+		*degagement = plusLong;
+
+	stat.requetes++;
+	cycles = DWT->CYCCNT - cycles;
+	if (cycles > stat.requeteMax)
+		stat.requeteMax = cycles;
+	return meilleure;
+}
+
+/**
+ * @param x : position dans le repere de l'odometrie (en mm)
+ * @param y
+ * @retval le log-odds de la cellule, 0 hors de la fenetre
+ */
+int8_t GRILLE_lire(int32_t x, int32_t y)
+{
+	int32_t cx = x >> BITS_CELLULE, cy = y >> BITS_CELLULE;
+	return dedans(cx, cy) ? cellules[INDEX(cx, cy)] : 0;
+}
+
+/**
+ * @brief Coin de la fenetre de plus petites coordonnees, la fenetre couvrant GRILLE_COTE * GRILLE_CELLULE mm de cote
+ */
+void GRILLE_fenetre(int32_t *x, int32_t *y)
+{
+	*x = origineX << BITS_CELLULE;
+	*y = origineY << BITS_CELLULE;
+}
+
+stat_grille_t GRILLE_get_stat(void)
+{
+	return stat;
+}
+
+static bool_e dedans(int32_t cx, int32_t cy)
+{
+	return (uint32_t)(cx - origineX) < GRILLE_COTE && (uint32_t)(cy - origineY) < GRILLE_COTE;
+}
+
+/**
+ * @brief Ajoute un log-odds a une cellule de la fenetre, sature a +-SATURATION
+ */
+static void modifier(int32_t cx, int32_t cy, int8_t delta)
+{
+	int8_t *cellule = &cellules[INDEX(cx, cy)];
+	int16_t v;
+
+	if (!dedans(cx, cy))
+		return;
+	v = *cellule + delta;
+	*cellule = (v > SATURATION) ? SATURATION : (v < -SATURATION) ? -SATURATION : (int8_t)v;
+}
+
+/**
+ * @brief Ramene la voiture au centre de la fenetre quand elle s'en ecarte de plus de MARGE cellules.
+ * 			La colonne quittee d'un cote porte le meme index que celle gagnee de l'autre : seule son
+ * 			effacement coute. Au dela d'un cote entier de deplacement, tout est efface.
+ */
+static void recentrer(pose_t pose)
+{
+	int32_t ecartX = (pose.x >> BITS_CELLULE) - (origineX + GRILLE_COTE / 2);
+	int32_t ecartY = (pose.y >> BITS_CELLULE) - (origineY + GRILLE_COTE / 2);
+
+	if (ecartX >= GRILLE_COTE || ecartX <= -GRILLE_COTE || ecartY >= GRILLE_COTE || ecartY <= -GRILLE_COTE)
+	{
+		memset(cellules, 0, sizeof(cellules));
+		origineX += ecartX;
+		origineY += ecartY;
+		stat.recentrages += GRILLE_COTE;
+		return;
+	}
+	if (ecartX > MARGE || ecartX < -MARGE)
+	{
+		for (; ecartX > 0; ecartX--, origineX++, stat.recentrages++)
+			for (uint8_t r = 0; r < GRILLE_COTE; r++)
+				cellules[INDEX(origineX, r)] = 0;
+		for (; ecartX < 0; ecartX++, stat.recentrages++)
+		{
+			origineX--;
+			for (uint8_t r = 0; r < GRILLE_COTE; r++)
+				cellules[INDEX(origineX, r)] = 0;
+		}
+	}
+	if (ecartY > MARGE || ecartY < -MARGE)
+	{
+		for (; ecartY > 0; ecartY--, origineY++, stat.recentrages++)
+			memset(&cellules[INDEX(0, origineY)], 0, GRILLE_COTE);
+		for (; ecartY < 0; ecartY++, stat.recentrages++)
+		{
+			origineY--;
+			memset(&cellules[INDEX(0, origineY)], 0, GRILLE_COTE);
+		}
+	}
+}
@@ -0,0 +1,47 @@
+/**
+ ******************************************************************************
+ * @file 	grille.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef GRILLE_GRILLE_H_
+#define GRILLE_GRILLE_H_
+
+#define GRILLE_COTE 64			/** @def Nombre de cellules d'un cote de la fenetre*/
+#define GRILLE_CELLULE 64		/** @def Cote d'une cellule (en mm)*/
+#define GRILLE_PORTEE 1500		/** @def Distance au dela de laquelle un releve ne renseigne plus la grille (en mm)*/
+#define GRILLE_SEUIL_OCCUPE 30	/** @def Log-odds au dela duquel une cellule est tenue pour occupee*/
+#define GRILLE_NB_DIRECTIONS 16 /** @def Directions examinees par la recherche d'une direction libre, sur un tour*/
+#define GRILLE_NB_MONTURES 4	/** @def Nombre maximal de capteurs alimentant la grille*/
+
+typedef struct
+{
+	uint8_t capteur; //identifiant du capteur
+	int16_t avance;	 //position du capteur vers l'avant de la voiture, depuis son centre (en mm)
+	int16_t lateral; //position vers la gauche (en mm)
+	int16_t angle;	 //direction du faisceau par rapport a l'avant, positive a gauche (angle binaire)
+} monture_t;		 /** @struct Position d'un capteur sur la voiture*/
+
+typedef struct
+{
+	uint32_t releves;	  //releves integres a la grille
+	uint32_t recentrages; //colonnes et lignes effacees en suivant la voiture
+	uint32_t moy;		  //cout moyen de l'integration d'un releve (en cycles)
+	uint32_t max;
+	uint8_t cellulesMax;  //plus grand nombre de cellules modifiees par un releve
+	uint32_t requetes;	  //recherches d'une direction libre
+	uint32_t requeteMax;  //cout maximal d'une recherche (en cycles)
+} stat_grille_t;		  /** @struct Compteurs de la grille*/
+
+void GRILLE_init(const monture_t *, uint8_t);
+void GRILLE_pas(pose_t);
+void GRILLE_ajouter(pose_t, uint8_t, uint16_t);
+uint16_t GRILLE_degagement(pose_t, int16_t);
+int16_t GRILLE_direction_libre(pose_t, uint16_t *);
+int8_t GRILLE_lire(int32_t, int32_t);
+void GRILLE_fenetre(int32_t *, int32_t *);
+stat_grille_t GRILLE_get_stat(void);
+
+#endif /* GRILLE_GRILLE_H_ */
@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file 	gyro.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Cap de la voiture par integration de la vitesse de lacet d'un gyroscope I2C
+ * 			(MPU6050 ou LSM6DS3 selon config.h). La lecture est relancee toutes les PERIODE ms
+ * 			par une minuterie et se termine sous interruption : la boucle principale
+ * 			n'attend jamais le bus. Le biais est moyenne sur la premiere seconde, la voiture
+ * 			partant en ligne droite. Un virage demande par GYRO_viser poste EVENEMENT_VIRAGE
+ * 			des que l'angle voulu sera atteint compte tenu du temps d'arret des moteurs.
+ * @note    PB6 etant le HP et PB7 l'UART1, I2C1 est remappe sur PB8/PB9 (I2C1_ON_PB6_PB7 a 0) :
+ * 			ces broches ne sont libres qu'avec CAPTURE_MATERIELLE, le pilote EXTI y lit deux echos.
+ ******************************************************************************
+ */
+
+#include "config.h"
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "stm32f1_gpio.h"
+#include "minuterie/minuterie.h"
+#include "evenement/evenement.h"
+#include "gyro.h"
+
+#define PERIODE 5		   /** @def Periode de lecture de la vitesse de lacet (en ms)*/
+#define NB_ETALONNAGE 200  /** @def Lectures moyennees pour estimer le biais, une seconde*/
+#define ANTICIPATION 10	   /** @def Rotation encore faite entre la fin d'un virage et l'arret des roues (en ms de rotation)*/
+#define VITESSE_I2C 400000 /** @def Frequence du bus (en Hz)*/
+
+#if USE_SENSOR_LSM6DS3
+#define ADRESSE (0x6A << 1) /** @def Adresse I2C, SDO a la masse*/
+#define REG_LACET 0x26		/** @def OUTZ_L_G, poids faible en tete*/
+#define LSB_PAR_10DPS 571	/** @def Sensibilite a +/- 500 dps (en LSB pour 10 deg/s)*/
+#define LACET(o) ((int16_t)((uint16_t)(o)[1] << 8 | (o)[0]))
+static const uint8_t configuration[][2] = {
+	{0x11, 0x54}, //CTRL2_G : 208 Hz, +/- 500 dps
+};
+#else
+#define ADRESSE (0x68 << 1) /** @def Adresse I2C, AD0 a la masse*/
+#define REG_LACET 0x47		/** @def GYRO_ZOUT_H, poids fort en tete*/
+#define LSB_PAR_10DPS 655	/** @def Sensibilite a +/- 500 dps (en LSB pour 10 deg/s)*/
+#define LACET(o) ((int16_t)((uint16_t)(o)[0] << 8 | (o)[1]))
+static const uint8_t configuration[][2] = {
+	{0x6B, 0x01}, //PWR_MGMT_1 : reveil, horloge sur le gyroscope X
+	{0x1A, 0x03}, //CONFIG : filtre passe-bas a 44 Hz
+	{0x1B, 0x08}, //GYRO_CONFIG : +/- 500 dps
+};
+#endif
+
+//Rotation par LSB Q4 et par PERIODE, en 2^-48 tour : le cap est gere en 2^-32 tour apres un decalage de 16
+#define ECHELLE (((int64_t)PERIODE * 10 << 48) / (360000LL * LSB_PAR_10DPS * 16))
+
+static I2C_HandleTypeDef hi2c;
+static minuterie_t minuterie;
+static uint8_t octets[2];
+static volatile uint32_t lacet = 0;	   //cap, 2^32 pour un tour, positif a gauche
+static volatile int32_t pas = 0;	   //rotation pendant la derniere PERIODE (en 2^-32 tour)
+static volatile uint8_t periodes = 0;  //periodes ecoulees depuis la derniere lecture integree
+static volatile uint16_t etalonnage = 0;
+static int32_t somme = 0;
+static volatile uint32_t cible;		   //cap vise
+static volatile int8_t sens = 0;	   //sens du virage en cours : 1 a gauche, -1 a droite, 0 aucun
+static stat_gyro_t stat;
+
+static void lire(void);
+
+/**
+ * @brief Configure le bus et le gyroscope, puis lance les lectures periodiques
+ */
+void GYRO_init(void)
+{
+	//SCL et SDA en fonction alternative a drain ouvert, avant l'activation du peripherique
+	__HAL_RCC_AFIO_CLK_ENABLE();
+#if I2C1_ON_PB6_PB7
+	BSP_GPIO_PinCfg(GPIOB, GPIO_PIN_6 | GPIO_PIN_7, GPIO_MODE_AF_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_HIGH);
+#else
+	__HAL_AFIO_REMAP_I2C1_ENABLE();
+	BSP_GPIO_PinCfg(GPIOB, GPIO_PIN_8 | GPIO_PIN_9, GPIO_MODE_AF_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_HIGH);
+#endif
+	__HAL_RCC_I2C1_CLK_ENABLE();
+	hi2c.Instance = I2C1;
+	hi2c.Init.ClockSpeed = VITESSE_I2C;
+	hi2c.Init.DutyCycle = I2C_DUTYCYCLE_2;
+	hi2c.Init.OwnAddress1 = 0;
+	hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	hi2c.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	hi2c.Init.OwnAddress2 = 0;
+	hi2c.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	hi2c.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	HAL_I2C_Init(&hi2c);
+	HAL_NVIC_SetPriority(I2C1_EV_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+	HAL_NVIC_SetPriority(I2C1_ER_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+	//Seules ecritures bloquantes, avant le lancement de la navigation
+	for (uint8_t i = 0; i < sizeof(configuration) / sizeof(configuration[0]); i++)
+		if (HAL_I2C_Mem_Write(&hi2c, ADRESSE, configuration[i][0], I2C_MEMADD_SIZE_8BIT, (uint8_t *)&configuration[i][1], 1, I2C_TIMEOUT) != HAL_OK)
+			stat.erreurs++;
+	MINUTERIE_armer(&minuterie, PERIODE, PERIODE, &lire);
+}
+
+void I2C1_EV_IRQHandler(void)
+{
+	HAL_I2C_EV_IRQHandler(&hi2c);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+	HAL_I2C_ER_IRQHandler(&hi2c);
+}
+
+/**
+ * @brief Lance la lecture de la vitesse de lacet, sous interruption Systick
+ */
+static void lire(void)
+{
+	periodes++;
+	if (hi2c.State != HAL_I2C_STATE_READY)
+		stat.occupe++;
+	else if (HAL_I2C_Mem_Read_IT(&hi2c, ADRESSE, REG_LACET, I2C_MEMADD_SIZE_8BIT, octets, 2) != HAL_OK)
+		stat.erreurs++;
+}
+
+/**
+ * @brief Fin de lecture : etalonnage puis integration du lacet sur les periodes ecoulees
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *h)
+{
+	int16_t brut = LACET(octets);
+	int32_t reste;
+
+	if (h != &hi2c)
+		return;
+	if (etalonnage < NB_ETALONNAGE)
+	{
+		somme += brut;
+		if (++etalonnage == NB_ETALONNAGE)
+			stat.biais = somme * 16 / NB_ETALONNAGE;
+		periodes = 0;
+		return;
+	}
+	pas = (int32_t)((((int64_t)brut << 4) - stat.biais) * ECHELLE >> 16);
+	lacet += (uint32_t)(pas * periodes);
+	periodes = 0;
+	stat.lectures++;
+
+	//Fin du virage quand le reste a tourner est couvert pendant ANTICIPATION
+	reste = (int32_t)(cible - lacet) - pas * ANTICIPATION / PERIODE;
+	if (sens && sens * reste <= 0)
+	{
+		sens = 0;
+		stat.virages++;
+		EVENEMENT_poster(EVENEMENT_VIRAGE);
+	}
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *h)
+{
+	if (h == &hi2c)
+		stat.erreurs++;
+}
+
+/**
+ * @retval TRUE quand le biais est estime et le cap integre
+ */
+bool_e GYRO_pret(void)
+{
+	return etalonnage == NB_ETALONNAGE;
+}
+
+/**
+ * @retval le cap depuis la fin de l'etalonnage (angle binaire, positif a gauche)
+ */
+int16_t GYRO_get_cap(void)
+{
+	return (int16_t)(lacet >> 16);
+}
+
+/**
+ * @brief Demande un virage relatif au cap courant, EVENEMENT_VIRAGE est poste a son terme
+ * @param angle : angle binaire, positif a gauche, non nul
+ */
+void GYRO_viser(int16_t angle)
+{
+	__disable_irq();
+	cible = lacet + ((uint32_t)(int32_t)angle << 16);
+	sens = (angle > 0) ? 1 : -1;
+	__enable_irq();
+}
+
+/**
+ * @brief Abandonne le virage en cours, par exemple interrompu par un obstacle
+ */
+void GYRO_annuler(void)
+{
+	sens = 0;
+}
+
+/**
+ * @retval TRUE si aucun virage n'est en cours
+ */
+bool_e GYRO_virage_fini(void)
+{
+	return sens == 0;
+}
+
+stat_gyro_t GYRO_get_stat(void)
+{
+	return stat;
+}
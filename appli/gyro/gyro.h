@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @file 	gyro.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef GYRO_GYRO_H_
+#define GYRO_GYRO_H_
+
+typedef struct
+{
+	uint32_t lectures; //lectures de la vitesse de lacet integrees
+	uint32_t erreurs;  //transferts I2C en echec
+	uint32_t occupe;   //periodes sans lecture, le transfert precedent n'etant pas fini
+	int32_t biais;	   //biais estime du gyroscope (en LSB Q4)
+	uint32_t virages;  //virages demandes et termines sur leur angle
+} stat_gyro_t;		   /** @struct Compteurs du gyroscope*/
+
+void GYRO_init(void);
+bool_e GYRO_pret(void);
+int16_t GYRO_get_cap(void);
+void GYRO_viser(int16_t);
+void GYRO_annuler(void);
+bool_e GYRO_virage_fini(void);
+stat_gyro_t GYRO_get_stat(void);
+
+#endif /* GYRO_GYRO_H_ */
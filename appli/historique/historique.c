@@ -0,0 +1,187 @@
+/**
+ ******************************************************************************
+ * @file 	historique.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Historique des manoeuvres de degagement et detection des boucles.
+ * 			Chaque manoeuvre est inscrite avec la position de son depart. Au blocage
+ * 			suivant, elle est jugee : un echec si la voiture est encore a moins de
+ * 			HISTORIQUE_RAYON de ce depart, ou revenue pres du depart d'une manoeuvre
+ * 			plus ancienne de l'historique, une reussite sinon. Une suite d'echecs qui
+ * 			repete le meme motif de manoeuvres est une boucle : le planificateur propose
+ * 			alors la manoeuvre la moins recemment essayee a cet endroit.
+ * 			Les manoeuvres sont des identifiants choisis par l'appelant (etats de
+ * 			l'automate ou comportements).
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "odometrie/odometrie.h"
+#include "historique.h"
+
+static souvenir_t souvenirs[HISTORIQUE_NB];
+static uint32_t nbSouvenirs = 0; //manoeuvres inscrites depuis l'init
+static uint8_t chaine = 0;		 //echecs consecutifs les plus recents, au plus HISTORIQUE_NB
+static stat_historique_t stat;
+
+static souvenir_t *souvenir(uint8_t);
+static bool_e pres(const souvenir_t *, pose_t);
+
+void HISTORIQUE_init(void)
+{
+	nbSouvenirs = 0;
+	chaine = 0;
+	stat = (stat_historique_t){0};
+}
+
+/**
+ * @brief Constate un blocage : juge la manoeuvre en cours d'apres la distance a son depart et a ceux des precedentes
+ * @param pose : pose de la voiture au blocage
+ */
+void HISTORIQUE_bloque(pose_t pose)
+{
+	souvenir_t *s = souvenir(0);
+	bool_e revenue = FALSE;
+
+	if (s == NULL || s->issue != HISTORIQUE_EN_COURS)
+		return;
+	for (uint8_t rang = 0; rang < HISTORIQUE_NB && souvenir(rang) != NULL && !revenue; rang++)
+		revenue = pres(souvenir(rang), pose);
+	if (revenue)
+	{
+		s->issue = HISTORIQUE_ECHEC;
+		stat.echecs++;
+		if (chaine < HISTORIQUE_NB)
+			chaine++;
+		if (chaine > stat.chaineMax)
+			stat.chaineMax = chaine;
+	}
+	else
+	{
+		s->issue = HISTORIQUE_REUSSIE;
+		chaine = 0;
+	}
+}
+
+/**
+ * @brief Inscrit une manoeuvre. La precedente, si elle n'a pas ete jugee, l'est depuis cette pose.
+ * @param manoeuvre : identifiant de la manoeuvre
+ * @param pose : pose de la voiture a son depart
+ */
+void HISTORIQUE_debut(uint8_t manoeuvre, pose_t pose)
+{
+	HISTORIQUE_bloque(pose);
+	souvenirs[nbSouvenirs % HISTORIQUE_NB] = (souvenir_t){MINUTERIE_maintenant(), pose.x, pose.y, manoeuvre, HISTORIQUE_EN_COURS};
+	nbSouvenirs++;
+	stat.manoeuvres++;
+}
+
+/**
+ * @brief Cherche un motif repete a la fin de la suite d'echecs : pour une periode p, les
+ * 			max(2p, HISTORIQUE_LONGUEUR_MIN) derniers echecs se repetent de p en p
+ * @retval la plus courte periode trouvee, 0 si la voiture ne boucle pas
+ */
+uint8_t HISTORIQUE_boucle(void)
+{
+	for (uint8_t p = 1; p <= HISTORIQUE_PERIODE_MAX; p++)
+	{
+		uint8_t longueur = (2 * p > HISTORIQUE_LONGUEUR_MIN) ? 2 * p : HISTORIQUE_LONGUEUR_MIN;
+		uint8_t i;
+
+		if (chaine < longueur)
+			break;
+		for (i = 0; i + p < longueur; i++)
+			if (souvenir(i)->manoeuvre != souvenir(i + p)->manoeuvre)
+				break;
+		if (i + p == longueur)
+			return p;
+	}
+	return 0;
+}
+
+/**
+ * @retval TRUE si la manoeuvre figure dans la suite d'echecs en cours : elle a deja echoue a cet endroit
+ */
+bool_e HISTORIQUE_essayee(uint8_t manoeuvre)
+{
+	for (uint8_t rang = 0; rang < chaine; rang++)
+		if (souvenir(rang)->manoeuvre == manoeuvre)
+			return TRUE;
+	return FALSE;
+}
+
+/**
+ * @brief Choisit la manoeuvre qui sort d'une boucle : la premiere des candidates absente de la suite
+ * 			d'echecs, sinon celle qui y a ete essayee le moins recemment
+ * @param candidats : manoeuvres possibles dans la situation, par ordre de preference
+ * @param nb : nombre de candidats
+ * @retval la manoeuvre choisie, HISTORIQUE_AUCUNE si nb est nul
+ */
+uint8_t HISTORIQUE_planifier(const uint8_t *candidats, uint8_t nb)
+{
+	uint8_t choix = HISTORIQUE_AUCUNE;
+	uint8_t plusAncien = 0;
+	uint8_t periode = HISTORIQUE_boucle();
+
+	for (uint8_t c = 0; c < nb; c++)
+	{
+		uint8_t rang = 0; //rang du dernier essai dans la suite d'echecs, chaine + 1 s'il n'y figure pas
+		while (rang < chaine && souvenir(rang)->manoeuvre != candidats[c])
+			rang++;
+		if (rang == chaine)
+			rang++;
+		if (choix == HISTORIQUE_AUCUNE || rang > plusAncien)
+		{
+			choix = candidats[c];
+			plusAncien = rang;
+		}
+	}
+	stat.evasions++;
+	if (periode > stat.periodeMax)
+		stat.periodeMax = periode;
+	return choix;
+}
+
+/**
+ * @brief Lecture de l'historique
+ * @param rang : 0 pour la manoeuvre la plus recente, 1 pour la precedente...
+ * @param s : recoit la manoeuvre
+ * @retval le nombre de manoeuvres disponibles, s n'est rempli que si rang est inferieur
+ */
+uint8_t HISTORIQUE_get(uint8_t rang, souvenir_t *s)
+{
+	uint8_t nb = (nbSouvenirs < HISTORIQUE_NB) ? (uint8_t)nbSouvenirs : HISTORIQUE_NB;
+
+	if (rang < nb)
+		*s = *souvenir(rang);
+	return nb;
+}
+
+stat_historique_t HISTORIQUE_get_stat(void)
+{
+	return stat;
+}
+
+/**
+ * @retval la manoeuvre de rang donne, 0 pour la plus recente, NULL si elle n'existe pas
+ */
+static souvenir_t *souvenir(uint8_t rang)
+{
+	if (rang >= nbSouvenirs || rang >= HISTORIQUE_NB)
+		return NULL;
+	return &souvenirs[(nbSouvenirs - 1 - rang) % HISTORIQUE_NB];
+}
+
+/**
+ * @retval TRUE si la pose est a moins de HISTORIQUE_RAYON du depart de la manoeuvre
+ */
+static bool_e pres(const souvenir_t *s, pose_t pose)
+{
+	int32_t dx = pose.x - s->x, dy = pose.y - s->y;
+
+	if (dx > HISTORIQUE_RAYON || dx < -HISTORIQUE_RAYON || dy > HISTORIQUE_RAYON || dy < -HISTORIQUE_RAYON)
+		return FALSE;
+	return dx * dx + dy * dy < HISTORIQUE_RAYON * HISTORIQUE_RAYON;
+}
@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file 	historique.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef HISTORIQUE_HISTORIQUE_H_
+#define HISTORIQUE_HISTORIQUE_H_
+
+#define HISTORIQUE_NB 16		  /** @def Manoeuvres conservees (puissance de 2)*/
+#define HISTORIQUE_RAYON 500	  /** @def Distance au point de depart d'une manoeuvre en deca de laquelle un nouveau blocage en fait un echec (en mm)*/
+#define HISTORIQUE_PERIODE_MAX 4  /** @def Plus longue periode de boucle recherchee (en manoeuvres)*/
+#define HISTORIQUE_LONGUEUR_MIN 2 /** @def Echecs consecutifs au moins pour conclure a une boucle, quelle que soit sa periode*/
+#define HISTORIQUE_AUCUNE 0xFF	  /** @def Manoeuvre rendue quand aucun candidat n'est propose*/
+
+typedef enum
+{
+	HISTORIQUE_EN_COURS = 0, //pas encore de nouveau blocage
+	HISTORIQUE_ECHEC,		 //bloquee de nouveau pres de son point de depart
+	HISTORIQUE_REUSSIE		 //bloquee de nouveau ailleurs : la voiture s'etait tiree d'affaire
+} issue_e;					 /** @enum Issue d'une manoeuvre*/
+
+typedef struct
+{
+	uint32_t date;	   //date du debut (en ms)
+	int32_t x;		   //position au debut, repere de l'odometrie (en mm)
+	int32_t y;
+	uint8_t manoeuvre; //identifiant choisi par l'appelant
+	uint8_t issue;	   //issue_e
+} souvenir_t;		   /** @struct Manoeuvre de l'historique*/
+
+typedef struct
+{
+	uint32_t manoeuvres; //manoeuvres inscrites
+	uint32_t echecs;
+	uint32_t evasions;	 //boucles detectees et manoeuvres planifiees pour en sortir
+	uint8_t periodeMax;	 //plus longue periode de boucle detectee
+	uint8_t chaineMax;	 //plus longue suite d'echecs consecutifs
+} stat_historique_t;	 /** @struct Compteurs de l'historique*/
+
+void HISTORIQUE_init(void);
+void HISTORIQUE_bloque(pose_t);
+void HISTORIQUE_debut(uint8_t, pose_t);
+uint8_t HISTORIQUE_boucle(void);
+bool_e HISTORIQUE_essayee(uint8_t);
+uint8_t HISTORIQUE_planifier(const uint8_t *, uint8_t);
+uint8_t HISTORIQUE_get(uint8_t, souvenir_t *);
+stat_historique_t HISTORIQUE_get_stat(void);
+
+#endif /* HISTORIQUE_HISTORIQUE_H_ */
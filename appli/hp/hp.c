@@ -1,386 +1,382 @@
-/**
- ******************************************************************************
- * @file 	hp.c
- * @date    27-January-2020
- * @author  Gautier - Dufourmantelle
- * @brief   Fonction associe au Haut parleur
- ******************************************************************************
- */
-
-#include "stm32f1_pwm.h"
-#include "macro_types.h"
-#include "systick.h"
-#include "hp.h"
-#include "config.h"
-
-#define POWER 50 /** @def amplitude en % pour la generation du son*/
-
-#define PIN_HP GPIO_PIN_6 //Broche PB6
-#define GPIO_HP GPIOB
-
-#define TIMER TIMER4_ID
-#define CHANNEL TIM_CHANNEL_1
-
-#define BEEPPER ((uint32_t)60000)  /** @def periode en µs du son pour la marche arriere*/
-#define DETRESSE ((uint32_t)10000) /** @def periode en µs du son quand la voiture est coince*/
-#define KLAXON ((uint32_t)65535)   /** @def periode en µs du son du klaxon*/
-
-#define DO ((uint32_t)3817)  /** @def periode en µs de la note DO*/
-#define RE ((uint32_t)3401)  /** @def periode en µs de la note RE*/
-#define MI ((uint32_t)3030)  /** @def periode en µs de la note MI*/
-#define FA ((uint32_t)2865)  /** @def periode en µs de la note FA*/
-#define SOL ((uint32_t)2551) /** @def periode en µs de la note SOL*/
-#define LA ((uint32_t)2273)  /** @def periode en µs de la note LA*/
-#define SI ((uint32_t)2024)  /** @def periode en µs de la note SI*/
-
-static const uint16_t melodie[] = {
-	379, 379, 0, 379,
-	0, 477, 379, 0,
-	318, 0, 0, 0,
-	637, 0, 0, 0,
-
-	477, 0, 0, 637,
-	0, 0, 658, 0,
-	0, 568, 0, 506,
-	0, 536, 568, 0,
-
-	637, 379, 318,
-	284, 0, 357, 318,
-	0, 379, 0, 477,
-	425, 506, 0, 0,
-
-	477, 0, 0, 637,
-	0, 0, 658, 0,
-	0, 568, 0, 506,
-	0, 536, 568, 0,
-
-	637, 379, 318,
-	284, 0, 357, 318,
-	0, 379, 0, 477,
-	425, 506, 0, 0};
-
-static const uint8_t tempo[] = {
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-
-	111,
-	111,
-	111,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-
-	111,
-	111,
-	111,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-	83,
-};
-
-static volatile uint32_t HP_timer = 0;
-
-static void HP_timer_process(void);
-
-/**
- * @brief Accesseur en lecture du timer du HP
- * @retval le timer du HP
- */
-uint32_t HP_getTimer(void)
-{
-	return HP_timer;
-}
-
-/**
- * @brief Fonction permettant d'avoir un compte du temps passe
- * @pre 	Il faut avoir active les test dans le main
- */
-void HP_timer_process(void)
-{
-	HP_timer++;
-}
-
-/**
- * @brief Fonction permettant de changer la valeur du timer
- * @param newTimer : entier positif correspondant a la valeur du nouveau timer
- */
-void HP_setTimer(uint32_t newTimer)
-{
-	HP_timer = newTimer;
-}
-
-/**
- * @brief Fonction forcant la mise au niveau bas de la broche pilotant le HP
- */
-void HP_init(void)
-{
-	Systick_add_callback_function(&HP_timer_process); //Ajout du timer en interruption
-	PWM_run(TIMER, CHANNEL, FALSE, DO, 0, FALSE);
-}
-
-/**
- * @brief 	Fonction permettant de tester le bon fonctionnement de la LED RGB,
- * 			celle-ci fera DO RE MI FA SOL LA SI DO
- */
-void HP_process_test(void)
-{
-	static bool_e on = FALSE;
-
-	if (!on && HP_timer < 10)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, DO, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer >= 500 && HP_timer < 1000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, RE, POWER);
-		on = FALSE;
-	}
-	else if (!on && HP_timer >= 1000 && HP_timer < 1500)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, MI, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer >= 1500 && HP_timer < 2000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, FA, POWER);
-		on = FALSE;
-	}
-	else if (!on && HP_timer >= 2000 && HP_timer < 2500)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, SOL, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer >= 2500 && HP_timer < 3000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, LA, POWER);
-		on = FALSE;
-	}
-	else if (!on && HP_timer >= 3000 && HP_timer < 3500)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, SI, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer >= 3500 && HP_timer < 4000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, DO, POWER);
-		on = FALSE;
-	}
-	else if (HP_timer >= 4000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, DO, 0);
-		HP_setTimer(0);
-		Systick_remove_callback_function(&HP_process_test);
-	}
-}
-/**
- * @brief Fonction permettant d'indiquer que la voiture fait une marche arriere
- * 			le HP bip
- */
-void HP_arriere(void)
-{
-	static bool_e on = FALSE;
-
-	if (!on && HP_timer < 10)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, BEEPPER, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer > 1000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, BEEPPER, 0);
-		on = FALSE;
-	}
-	else if (HP_timer > 1250)
-	{
-		HP_setTimer(0);
-	}
-}
-
-/**
- * @brief Fonction allument le HP afin d'indiquer que la voiture est bloque
- * 			celui-ci fait un SOS en morse
- */
-void HP_detresse(void)
-{
-	static bool_e on = FALSE;
-	static bool_e court = TRUE;
-	static uint8_t compt = 0;
-	static uint8_t cycle = 0;
-	const uint16_t courtTimer = 250;
-	const uint16_t longTimer = 500;
-	const uint16_t pauseTimer = 250;
-
-	if (cycle < 3)
-	{
-		if (!on && HP_timer >= pauseTimer)
-		{
-			PWM_run(TIMER, CHANNEL, FALSE, DETRESSE, POWER, FALSE);
-			on = TRUE;
-			compt++;
-			HP_setTimer(0);
-		}
-		else if (on && court && HP_timer > courtTimer && compt <= 3)
-		{
-			PWM_run(TIMER, CHANNEL, FALSE, DETRESSE, 0, FALSE);
-			on = FALSE;
-			HP_setTimer(0);
-		}
-		else if (on && !court && HP_timer > longTimer && compt <= 3)
-		{
-			PWM_run(TIMER, CHANNEL, FALSE, DETRESSE, 0, FALSE);
-			on = FALSE;
-			HP_setTimer(0);
-		}
-		else if (compt > 3)
-		{
-			compt = 1; //Il faut le mettre à 1 car quand on rentre dans cette boucle, le HP est allumé
-			cycle++;
-			court = !court;
-			HP_setTimer(0);
-		}
-	}
-	else if (HP_timer >= 5 * pauseTimer)
-	{
-		cycle = 0;
-		compt = 0;
-		court = TRUE;
-		HP_setTimer(0);
-	}
-	else if (on)
-	{
-		PWM_run(TIMER, CHANNEL, FALSE, DETRESSE, 0, FALSE);
-		on = FALSE;
-	}
-}
-
-/**
- * @brief Fonction faisant klaxonner la voiture
- */
-void HP_klaxon(void)
-{
-	static bool_e on = FALSE;
-
-	if (!on && HP_timer < 10)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer > 750 && HP_timer < 1000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, 0);
-		on = FALSE;
-	}
-	else if (!on && HP_timer > 1000 && HP_timer < 2000)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer > 2000 && HP_timer < 2500)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, 0);
-		on = FALSE;
-	}
-	else if (!on && HP_timer > 2500 && HP_timer < 4250)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, POWER);
-		on = TRUE;
-	}
-	else if (on && HP_timer > 4250)
-	{
-		PWM_set_period_and_duty(TIMER, CHANNEL, KLAXON, 0);
-		on = FALSE;
-		Systick_remove_callback_function(&HP_klaxon);
-	}
-}
-
-/**
- * @brief Fonction lançant la musique Mario losque que la voiture est en marche
- * @note  Le sons est horrible et agassant, par defaut la fonction n'est pas appele
- * @pre   Il faut avoir active la music dans le main
- */
-void HP_marche(void)
-{
-	static bool_e on = FALSE;
-	static uint8_t note = 0;
-
-	if (melodie[note] != 0)
-		PWM_run(TIMER, CHANNEL, FALSE, melodie[note], POWER, FALSE);
-	else
-		PWM_run(TIMER, CHANNEL, FALSE, DO, 0, FALSE); //si aucune melodie ne doit etre joue on met une periode quelconque mais avec une amplitude nulle
-
-	if (HP_timer > tempo[note])
-	{
-		if (note < (sizeof(melodie) / sizeof(uint16_t))) //sizeof retourne litterallement la taille du tableau, soit le nombre de bit qu'il occupe et non le nombre d'element
-			note++;
-		else
-			note = 0;
-		HP_setTimer(0);
-	}
-}
+/**
+ ******************************************************************************
+ * @file 	hp.c
+ * @date    27-January-2020
+ * @author  Gautier - Dufourmantelle
+ * @brief   Fonction associe au Haut parleur
+ ******************************************************************************
+ */
+
+#include "stm32f1_pwm.h"
+#include "macro_types.h"
+#include "registre/registre.h"
+#include "hp.h"
+#include "config.h"
+#include "minuterie/minuterie.h"
+#include "sequenceur/sequenceur.h"
+#include "audio/audio.h"
+#include "audio/sons.h"
+
+#define POWER 50 /** @def amplitude en % pour la generation du son*/
+
+#define PIN_HP GPIO_PIN_6 //Broche PB6
+#define GPIO_HP GPIOB
+
+#define TIMER TIMER4_ID
+#define CHANNEL TIM_CHANNEL_1
+
+#define DETRESSE ((uint32_t)10000) /** @def periode en µs du son quand la voiture est coince*/
+
+#define DO ((uint32_t)3817)  /** @def periode en µs de la note DO*/
+#define RE ((uint32_t)3401)  /** @def periode en µs de la note RE*/
+#define MI ((uint32_t)3030)  /** @def periode en µs de la note MI*/
+#define FA ((uint32_t)2865)  /** @def periode en µs de la note FA*/
+#define SOL ((uint32_t)2551) /** @def periode en µs de la note SOL*/
+#define LA ((uint32_t)2273)  /** @def periode en µs de la note LA*/
+#define SI ((uint32_t)2024)  /** @def periode en µs de la note SI*/
+
+#define HAUTEUR(nom, octave) ((octave)*12 + (nom) + 1) /** @def Numero de demi-ton d'une note, 0 etant reserve au silence*/
+#define NOTE(hauteur, duree) ((uint16_t)((hauteur) << 8 | (duree))) /** @def Note compactee : hauteur sur 8 bits, duree en unites du morceau sur 8 bits*/
+#define SILENCE 0
+#define CROCHE 3
+#define TRIOLET 4
+
+enum
+{
+	N_DO = 0,
+	N_DOd,
+	N_RE,
+	N_REd,
+	N_MI,
+	N_FA,
+	N_FAd,
+	N_SOL,
+	N_SOLd,
+	N_LA,
+	N_LAd,
+	N_SI
+};
+
+typedef struct
+{
+	const uint16_t *notes;
+	uint8_t nb;
+} piste_t; /** @struct Suite de notes compactees (NOTE), rangee en flash*/
+
+typedef struct
+{
+	const uint8_t *ordre; //pistes jouees, dans l'ordre : une piste repetee n'est stockee qu'une fois
+	uint8_t nb;
+	uint32_t unite_us;	  //duree d'une unite au tempo d'origine
+	bool_e boucle;
+} morceau_t; /** @struct Morceau joue note a note par la minuterie du HP*/
+
+typedef enum
+{
+	SON_SILENCE = 0,
+	SON_DETRESSE, //signal carre
+	SON_BIP,	  //son echantillonne, voie de fond
+	SON_KLAXON	  //son echantillonne, voie d'alerte
+} son_e; /** @enum Etats du canal HP du sequenceur*/
+
+static const pas_t pasArriere[] = {{1000, SON_BIP}, {250, SON_SILENCE}};
+static const pas_t pasDetresse[] = SEQUENCEUR_SOS(SON_DETRESSE);
+static const pas_t pasKlaxon[] = {{750, SON_KLAXON}, {250, SON_SILENCE}, {1000, SON_KLAXON}, {500, SON_SILENCE}, {1750, SON_KLAXON}};
+
+static const motif_t arriere = SEQUENCEUR_MOTIF(pasArriere, TRUE);
+static const motif_t detresse = SEQUENCEUR_MOTIF(pasDetresse, TRUE);
+static const motif_t klaxon = SEQUENCEUR_MOTIF(pasKlaxon, FALSE);
+
+//Morceau de la marche avant (theme de Mario), trois pistes enchainees A B C B C en boucle
+static const uint16_t pisteA[] = {
+	NOTE(HAUTEUR(N_MI, 7), CROCHE), NOTE(HAUTEUR(N_MI, 7), CROCHE), NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_MI, 7), CROCHE),
+	NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_DO, 7), CROCHE), NOTE(HAUTEUR(N_MI, 7), CROCHE), NOTE(SILENCE, CROCHE),
+	NOTE(HAUTEUR(N_SOL, 7), CROCHE), NOTE(SILENCE, 3 * CROCHE),
+	NOTE(HAUTEUR(N_SOL, 6), CROCHE), NOTE(SILENCE, 3 * CROCHE)};
+
+static const uint16_t pisteB[] = {
+	NOTE(HAUTEUR(N_DO, 7), CROCHE), NOTE(SILENCE, 2 * CROCHE), NOTE(HAUTEUR(N_SOL, 6), CROCHE),
+	NOTE(SILENCE, 2 * CROCHE), NOTE(HAUTEUR(N_MI, 6), CROCHE), NOTE(SILENCE, 2 * CROCHE),
+	NOTE(HAUTEUR(N_LA, 6), CROCHE), NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_SI, 6), CROCHE),
+	NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_LAd, 6), CROCHE), NOTE(HAUTEUR(N_LA, 6), CROCHE), NOTE(SILENCE, CROCHE)};
+
+static const uint16_t pisteC[] = {
+	NOTE(HAUTEUR(N_SOL, 6), TRIOLET), NOTE(HAUTEUR(N_MI, 7), TRIOLET), NOTE(HAUTEUR(N_SOL, 7), TRIOLET),
+	NOTE(HAUTEUR(N_LA, 7), CROCHE), NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_FA, 7), CROCHE), NOTE(HAUTEUR(N_SOL, 7), CROCHE),
+	NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_MI, 7), CROCHE), NOTE(SILENCE, CROCHE), NOTE(HAUTEUR(N_DO, 7), CROCHE),
+	NOTE(HAUTEUR(N_RE, 7), CROCHE), NOTE(HAUTEUR(N_SI, 6), CROCHE), NOTE(SILENCE, 2 * CROCHE)};
+
+static const piste_t pistes[] = {
+	{pisteA, sizeof(pisteA) / sizeof(pisteA[0])},
+	{pisteB, sizeof(pisteB) / sizeof(pisteB[0])},
+	{pisteC, sizeof(pisteC) / sizeof(pisteC[0])},
+};
+
+static const uint8_t ordreMarche[] = {0, 1, 2, 1, 2};
+static const morceau_t marche = {ordreMarche, sizeof(ordreMarche), 27778, TRUE}; //unite d'1/36 s : croche de 83 ms, triolet de 111 ms
+
+//Periode (en µs) de chaque note a l'octave 0, les octaves superieures s'obtiennent par decalage
+static const uint16_t periodesOctave0[12] = {61162, 57737, 54496, 51414, 48544, 45809, 43253, 40816, 38521, 36364, 34317, 32394};
+
+static const morceau_t *morceau = NULL; //morceau en cours, NULL : aucun
+static uint8_t section = 0;				//position dans l'ordre des pistes du morceau
+static uint8_t note = 0;				//position dans la piste
+static uint32_t resteUs = 0;			//fraction de ms reportee sur la note suivante, evite toute derive du tempo
+static uint16_t tempo = 100;			//en % du tempo d'origine
+static minuterie_t HP_minuterie;
+
+static uint32_t HP_debut = 0; //date de la derniere remise a zero du timer du HP
+
+static void HP_sortie(uint8_t);
+static void HP_ecrire(uint32_t, uint8_t);
+static void HP_note_suivante(void);
+static void HP_arreter_morceau(void);
+
+/**
+ * @brief Accesseur en lecture du timer du HP
+ * @retval le temps ecoule depuis la derniere remise a zero (en ms)
+ */
+uint32_t HP_getTimer(void)
+{
+	return MINUTERIE_maintenant() - HP_debut;
+}
+
+/**
+ * @brief Fonction permettant de changer la valeur du timer
+ * @param newTimer : entier positif correspondant a la valeur du nouveau timer
+ */
+void HP_setTimer(uint32_t newTimer)
+{
+	HP_debut = MINUTERIE_maintenant() - newTimer;
+}
+
+/**
+ * @brief Fonction forcant la mise au niveau bas de la broche pilotant le HP
+ */
+void HP_init(void)
+{
+	PWM_run(TIMER, CHANNEL, FALSE, DO, 0, FALSE);
+	//PWM_run laisse TIM4 compter a 1 MHz (periode < 65536 µs) : ARR et CCR1 sont ensuite ecrits directement,
+	//avec prechargement, la nouvelle note part a la fin de la periode en cours, sans reinitialiser le timer
+	TIM4->CR1 |= TIM_CR1_ARPE;
+	TIM4->CCMR1 |= TIM_CCMR1_OC1PE;
+	//Les sons sont joues par le sequenceur a la demande de la machine a etats du main, la melodie par la minuterie du HP
+	SEQUENCEUR_canal(SEQUENCEUR_HP, &HP_sortie);
+}
+
+/**
+ * @brief 	Fonction permettant de tester le bon fonctionnement de la LED RGB,
+ * 			celle-ci fera DO RE MI FA SOL LA SI DO
+ */
+void HP_process_test(void)
+{
+	uint32_t timer = HP_getTimer();
+	static bool_e on = FALSE;
+
+	if (!on && timer < 10)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, DO, POWER);
+		on = TRUE;
+	}
+	else if (on && timer >= 500 && timer < 1000)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, RE, POWER);
+		on = FALSE;
+	}
+	else if (!on && timer >= 1000 && timer < 1500)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, MI, POWER);
+		on = TRUE;
+	}
+	else if (on && timer >= 1500 && timer < 2000)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, FA, POWER);
+		on = FALSE;
+	}
+	else if (!on && timer >= 2000 && timer < 2500)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, SOL, POWER);
+		on = TRUE;
+	}
+	else if (on && timer >= 2500 && timer < 3000)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, LA, POWER);
+		on = FALSE;
+	}
+	else if (!on && timer >= 3000 && timer < 3500)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, SI, POWER);
+		on = TRUE;
+	}
+	else if (on && timer >= 3500 && timer < 4000)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, DO, POWER);
+		on = FALSE;
+	}
+	else if (timer >= 4000)
+	{
+		PWM_set_period_and_duty(TIMER, CHANNEL, DO, 0);
+		HP_setTimer(0);
+		REGISTRE_desactiver(&HP_process_test);
+	}
+}
+/**
+ * @brief Sortie du canal HP du sequenceur
+ * @param etat : son a emettre (SON_xxx), 0 : silence
+ */
+static void HP_sortie(uint8_t etat)
+{
+	switch (etat)
+	{
+	case SON_KLAXON:
+		AUDIO_jouer(AUDIO_ALERTE, &SON_klaxon, TRUE);
+		break;
+	case SON_BIP:
+		AUDIO_jouer(AUDIO_FOND, &SON_bip, TRUE);
+		break;
+	default:
+		//Les sons carres reprennent TIM4 : les sons echantillonnes sont coupes d'abord
+		AUDIO_arreter(AUDIO_ALERTE);
+		AUDIO_arreter(AUDIO_FOND);
+		HP_ecrire((etat == SON_DETRESSE) ? DETRESSE : 0, (etat == SON_DETRESSE) ? POWER : 0);
+	}
+}
+
+/**
+ * @brief Precharge la periode et le rapport cyclique de TIM4, pris en compte a la prochaine mise a jour
+ * @param periode : periode du son (en µs), 0 : periode inchangee
+ * @param puissance : amplitude en %, 0 : silence
+ */
+static void HP_ecrire(uint32_t periode, uint8_t puissance)
+{
+	if (periode)
+		TIM4->ARR = periode - 1;
+	TIM4->CCR1 = (TIM4->ARR + 1) * puissance / 100;
+}
+
+/**
+ * @brief Fonction permettant d'indiquer que la voiture fait une marche arriere
+ * 			le HP bip
+ */
+void HP_arriere(void)
+{
+	HP_arreter_morceau();
+	SEQUENCEUR_jouer(SEQUENCEUR_HP, &arriere);
+}
+
+/**
+ * @brief Fonction allument le HP afin d'indiquer que la voiture est bloque
+ * 			celui-ci fait un SOS en morse, en phase avec LED_detresse s'il est lance dans la meme ms
+ */
+void HP_detresse(void)
+{
+	HP_arreter_morceau();
+	SEQUENCEUR_jouer(SEQUENCEUR_HP, &detresse);
+}
+
+/**
+ * @brief Fonction faisant klaxonner la voiture, le HP se tait de lui-meme a la fin du motif
+ */
+void HP_klaxon(void)
+{
+	HP_arreter_morceau();
+	SEQUENCEUR_jouer(SEQUENCEUR_HP, &klaxon);
+}
+
+/**
+ * @brief Interrompt le son joue par le sequenceur ou la melodie
+ */
+void HP_silence(void)
+{
+	HP_arreter_morceau();
+	SEQUENCEUR_arreter(SEQUENCEUR_HP);
+}
+
+/**
+ * @brief Fin de note : precharge la note suivante dans TIM4 et reprogramme la minuterie pour sa duree
+ * @note  Appelee sous interruption Systick une fois par note, aucun traitement entre deux notes
+ */
+static void HP_note_suivante(void)
+{
+	const piste_t *piste;
+	uint16_t n;
+	uint8_t hauteur, octave;
+	uint32_t duree;
+
+	if (morceau == NULL)
+		return;
+	piste = &pistes[morceau->ordre[section]];
+	if (note >= piste->nb)
+	{
+		note = 0;
+		section++;
+		if (section >= morceau->nb)
+		{
+			if (!morceau->boucle)
+			{
+				morceau = NULL;
+				HP_ecrire(0, 0);
+				return;
+			}
+			section = 0;
+		}
+		piste = &pistes[morceau->ordre[section]];
+	}
+
+	n = piste->notes[note++];
+	hauteur = n >> 8;
+	if (hauteur != SILENCE)
+	{
+		octave = (hauteur - 1) / 12;
+		HP_ecrire((periodesOctave0[(hauteur - 1) % 12] + (1U << octave >> 1)) >> octave, POWER); //division arrondie
+	}
+	else
+		HP_ecrire(0, 0);
+
+	duree = (n & 0xFF) * (morceau->unite_us * 100 / tempo) + resteUs;
+	resteUs = duree % 1000;
+	MINUTERIE_armer(&HP_minuterie, (duree >= 1000) ? duree / 1000 : 1, 0, &HP_note_suivante);
+}
+
+static void HP_arreter_morceau(void)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	MINUTERIE_annuler(&HP_minuterie);
+	morceau = NULL;
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Change le tempo de la melodie, effectif des la note suivante
+ * @param pourcent : tempo en % du tempo d'origine (100 : inchange, 200 : deux fois plus vite)
+ */
+void HP_tempo(uint16_t pourcent)
+{
+	if (pourcent)
+		tempo = pourcent;
+}
+
+/**
+ * @brief Fonction lançant la musique Mario losque que la voiture est en marche
+ * @note  Le sons est horrible et agassant, par defaut la fonction n'est pas appele
+ * 			Seules les fins de note coutent du temps processeur, le timer joue la note seul
+ * @pre   Il faut avoir active la music dans le main
+ */
+void HP_marche(void)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	SEQUENCEUR_arreter(SEQUENCEUR_HP);
+	__disable_irq();
+	MINUTERIE_annuler(&HP_minuterie);
+	morceau = &marche;
+	section = 0;
+	note = 0;
+	resteUs = 0;
+	HP_note_suivante();
+	if (!primask)
+		__enable_irq();
+}
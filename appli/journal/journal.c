@@ -0,0 +1,220 @@
+/**
+ ******************************************************************************
+ * @file 	journal.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Journal binaire differe : chaque message est un enregistrement compact
+ * 			(synchro, numero de format, nombre d'arguments, date en ms, arguments sur 32 bits)
+ * 			ecrit sans verrou dans un tampon circulaire, puis emis en tache de fond sur l'UART2 par DMA.
+ * 			Le texte est reconstitue sur le PC par outils/decodeur_journal.c.
+ * @note	Ecriture depuis n'importe quel contexte (boucle principale ou interruption) :
+ * 			la place est reservee par LDREX/STREX, l'octet de synchro est ecrit en dernier et vaut validation.
+ * 			Quand le tampon est plein, l'enregistrement est perdu et compte, l'appelant n'attend jamais.
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "registre/registre.h"
+#include "journal.h"
+
+#define TAILLE_TAMPON 1024 /** @def Taille du tampon circulaire, puissance de 2 (en octets)*/
+#define MASQUE_TAMPON (TAILLE_TAMPON - 1)
+#define TEXTE_MAX 64	  /** @def Longueur maximale d'un enregistrement de texte*/
+
+static uint8_t tampon[TAILLE_TAMPON];
+static volatile uint32_t reserve = 0;	//fin de la derniere place reservee par un ecrivain
+static volatile uint32_t frontiere = 0; //fin du dernier enregistrement valide vu par la vidange
+static volatile uint32_t lecture = 0;	//debut de la zone non encore emise
+static volatile uint32_t enVol = 0;		//octets confies au DMA, 0 si le DMA est libre
+static volatile uint32_t perdus = 0;
+static DMA_HandleTypeDef hdma;
+
+static bool_e reserver(uint32_t, uint32_t *);
+static void copier(uint32_t, const void *, uint32_t);
+static void valider(uint32_t, uint8_t, uint8_t);
+static uint32_t longueur(uint32_t);
+static void vidanger(void);
+static void JOURNAL_process_ms(void);
+static void fin_transfert(DMA_HandleTypeDef *);
+
+/**
+ * @brief Reserve une place dans le tampon, sans masquer les interruptions
+ * @param taille : taille de l'enregistrement
+ * @param debut : position de la place reservee
+ * @retval FALSE si le tampon est plein (l'enregistrement est compte comme perdu)
+ */
+static bool_e reserver(uint32_t taille, uint32_t *debut)
+{
+	uint32_t r;
+
+	do
+	{
+		r = __LDREXW(&reserve);
+		if (TAILLE_TAMPON - (r - lecture) < taille)
+		{
+			__CLREX();
+			do
+				r = __LDREXW(&perdus);
+			while (__STREXW(r + 1, &perdus));
+			return FALSE;
+		}
+	} while (__STREXW(r + taille, &reserve));
+	*debut = r;
+	return TRUE;
+}
+
+static void copier(uint32_t position, const void *source, uint32_t taille)
+{
+	const uint8_t *octets = source;
+
+	for (uint32_t i = 0; i < taille; i++)
+		tampon[(position + i) & MASQUE_TAMPON] = octets[i];
+}
+
+/**
+ * @brief Ecrit l'entete puis, en dernier, l'octet de synchro qui rend l'enregistrement visible a la vidange
+ */
+static void valider(uint32_t debut, uint8_t format, uint8_t nb)
+{
+	uint32_t date = MINUTERIE_maintenant();
+
+	tampon[(debut + 1) & MASQUE_TAMPON] = format;
+	tampon[(debut + 2) & MASQUE_TAMPON] = nb;
+	copier(debut + 3, &date, sizeof(date)); //petit-boutiste, comme le PC qui decode
+	__DMB();
+	tampon[debut & MASQUE_TAMPON] = JOURNAL_SYNCHRO;
+}
+
+/**
+ * @brief Ajoute un message au journal, sans formatage ni attente
+ * @param format : numero du message (journal_formats.h)
+ * @param nb : nombre d'arguments utilises, de 0 a 4
+ * @note  Utiliser les macros JOURNAL_0 a JOURNAL_4
+ */
+void JOURNAL_ecrire(journal_format_e format, uint8_t nb, uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+	uint32_t arguments[4] = {a, b, c, d};
+	uint32_t debut;
+
+	if (nb > 4)
+		nb = 4;
+	if (!reserver(JOURNAL_ENTETE + 4 * nb, &debut))
+		return;
+	copier(debut + JOURNAL_ENTETE, arguments, 4 * nb);
+	valider(debut, (uint8_t)format, nb);
+}
+
+/**
+ * @brief Ajoute un texte brut au journal, pour les noms et messages d'initialisation
+ * @param texte : chaine recopiee, tronquee a TEXTE_MAX caracteres
+ */
+void JOURNAL_texte(const char *texte)
+{
+	uint32_t taille = strlen(texte);
+	uint32_t debut;
+
+	if (taille > TEXTE_MAX)
+		taille = TEXTE_MAX;
+	if (!reserver(JOURNAL_ENTETE + taille, &debut))
+		return;
+	copier(debut + JOURNAL_ENTETE, texte, taille);
+	valider(debut, JOURNAL_TEXTE, (uint8_t)taille);
+}
+
+/**
+ * @retval la taille de l'enregistrement valide commencant a une position
+ */
+static uint32_t longueur(uint32_t position)
+{
+	uint8_t format = tampon[(position + 1) & MASQUE_TAMPON];
+	uint8_t nb = tampon[(position + 2) & MASQUE_TAMPON];
+
+	return JOURNAL_ENTETE + ((format == JOURNAL_TEXTE) ? nb : 4 * (uint32_t)nb);
+}
+
+/**
+ * @brief Confie au DMA les enregistrements valides, d'un seul tenant jusqu'a la fin du tampon
+ * @note  Appele par le Systick et par la fin de transfert, que le Systick peut interrompre :
+ * 			le test de enVol et le lancement du DMA se font interruptions masquees
+ */
+static void vidanger(void)
+{
+	uint32_t debut, taille;
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if (!enVol)
+	{
+		//Un enregistrement reserve mais pas encore valide arrete la vidange, les suivants attendront
+		while (frontiere != reserve && tampon[frontiere & MASQUE_TAMPON] == JOURNAL_SYNCHRO)
+			frontiere += longueur(frontiere);
+		if (frontiere != lecture)
+		{
+			debut = lecture & MASQUE_TAMPON;
+			taille = frontiere - lecture;
+			if (debut + taille > TAILLE_TAMPON)
+				taille = TAILLE_TAMPON - debut;
+			enVol = taille;
+			HAL_DMA_Start_IT(&hdma, (uint32_t)(uintptr_t)&tampon[debut], (uint32_t)(uintptr_t)&USART2->DR, taille);
+		}
+	}
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Fin de transfert DMA : la place emise est effacee puis rendue aux ecrivains
+ * @note  L'effacement garantit qu'une place reservee ne porte jamais une ancienne synchro
+ */
+static void fin_transfert(DMA_HandleTypeDef *h)
+{
+	(void)h;
+	memset(&tampon[lecture & MASQUE_TAMPON], 0, enVol);
+	__DMB();
+	lecture += enVol;
+	enVol = 0;
+	vidanger();
+}
+
+static void JOURNAL_process_ms(void)
+{
+	vidanger();
+}
+
+void DMA1_Channel7_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&hdma);
+}
+
+/**
+ * @brief Configure le canal DMA de l'emission UART2, a appeler apres UART_init et REGISTRE_init
+ */
+void JOURNAL_init(void)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	hdma.Instance = DMA1_Channel7; //USART2_TX
+	hdma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma.Init.MemInc = DMA_MINC_ENABLE;
+	hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma.Init.Mode = DMA_NORMAL;
+	hdma.Init.Priority = DMA_PRIORITY_LOW;
+	HAL_DMA_Init(&hdma);
+	hdma.XferCpltCallback = &fin_transfert;
+	HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 3, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+	USART2->CR3 |= USART_CR3_DMAT; //l'UART2 reste initialisee par la librairie, seule l'emission passe par le DMA
+	REGISTRE_reserver(&JOURNAL_process_ms, "JOURNAL_process_ms", TRUE);
+}
+
+/**
+ * @retval le nombre d'enregistrements perdus faute de place depuis le demarrage
+ */
+uint32_t JOURNAL_get_perdus(void)
+{
+	return perdus;
+}
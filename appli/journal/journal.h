@@ -0,0 +1,33 @@
+/**
+ ******************************************************************************
+ * @file 	journal.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef JOURNAL_H_
+#define JOURNAL_H_
+
+#include "journal_formats.h"
+
+#define JOURNAL_ENUM(nom, texte) nom,
+
+typedef enum
+{
+	JOURNAL_FORMATS(JOURNAL_ENUM)
+	JOURNAL_NB_FORMATS
+} journal_format_e; /** @enum Numero des messages, voir journal_formats.h*/
+
+#define JOURNAL_0(f) JOURNAL_ecrire((f), 0, 0, 0, 0, 0)
+#define JOURNAL_1(f, a) JOURNAL_ecrire((f), 1, (uint32_t)(a), 0, 0, 0)
+#define JOURNAL_2(f, a, b) JOURNAL_ecrire((f), 2, (uint32_t)(a), (uint32_t)(b), 0, 0)
+#define JOURNAL_3(f, a, b, c) JOURNAL_ecrire((f), 3, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), 0)
+#define JOURNAL_4(f, a, b, c, d) JOURNAL_ecrire((f), 4, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+
+void JOURNAL_init(void);
+void JOURNAL_ecrire(journal_format_e, uint8_t, uint32_t, uint32_t, uint32_t, uint32_t);
+void JOURNAL_texte(const char *);
+uint32_t JOURNAL_get_perdus(void);
+
+#endif /* JOURNAL_H_ */
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file 	journal_formats.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Table des messages du journal, partagee avec le decodeur hote (outils/decodeur_journal.c).
+ * 			Le numero d'un message est sa position dans la table : on ajoute a la fin, on ne retire rien.
+ * @note	Les arguments sont des entiers 32 bits : seuls %d, %u, %x et %c sont autorises.
+ * 			Ce fichier ne doit inclure aucun en-tete de la cible.
+ ******************************************************************************
+ */
+
+#ifndef JOURNAL_FORMATS_H_
+#define JOURNAL_FORMATS_H_
+
+#define JOURNAL_SYNCHRO 0xA5 /** @def Premier octet de chaque enregistrement*/
+#define JOURNAL_TEXTE 0xFF	 /** @def Numero de format d'un enregistrement contenant du texte brut*/
+#define JOURNAL_ENTETE 7	 /** @def Synchro, format, nombre d'arguments (ou d'octets de texte), date sur 4 octets*/
+
+#define JOURNAL_FORMATS(X)                                                                   \
+	X(JOURNAL_CAPTEURS_AJOUTES, "Tout les capteurs ont ete ajoutes avec succes\n")           \
+	X(JOURNAL_ERREUR_AJOUT_CAPTEUR, "Erreur ajout capteur %u\n")                             \
+	X(JOURNAL_RELEVE, "sensor %u - distance : %u, age %u ms, %u mesures/s\n")               \
+	X(JOURNAL_RELEVE_INVALIDE, "sensor %u - invalide, age %u ms, %u mesures/s\n")           \
+	X(JOURNAL_REGISTRE_PLEIN, " : registre plein (%u places), non reserve\n")                \
+	X(JOURNAL_REGISTRE_PLACE, " : %u appels, min %u us, moy %u us, max %u us\n")             \
+	X(JOURNAL_REGISTRE_DEPASSEMENTS, "depassements du tick : %u\n")                          \
+	X(JOURNAL_AUTOMATE_TRANSITION, " -> etat %u a %u ms (evenement %u, ligne %u)\n")       \
+	X(JOURNAL_AUTOMATE_COUT, "automate : %u pas, %u transitions, decision moy %u cycles, max %u cycles\n") \
+	X(JOURNAL_TACHE, " : %u appels, moy %u us, max %u us, retard max %u ms\n")                     \
+	X(JOURNAL_ORDONNANCEUR, "ordonnanceur : %u passages, %u commutations, surcout moy %u cycles\n") \
+	X(JOURNAL_TELEMETRIE, "x %d mm, y %d mm, cap %d deg, repos %u %%\n")                   \
+	X(JOURNAL_AUTOMATE_TABLE, "automate : table invalide (%u etats, %u transitions), voiture a l'arret\n")
+
+#endif /* JOURNAL_FORMATS_H_ */
@@ -1,221 +1,782 @@
-/**
-  ******************************************************************************
-  * @file    main.c
-  * @author  Gautier - Dufourmantelle
-  * @date    27-January-2020
-  * @brief   Default main function.
-  ******************************************************************************
-*/
-
-#include "stm32f1xx_hal.h"
-#include "stm32f1_uart.h"
-#include "stm32f1_sys.h"
-#include "stm32f1_gpio.h"
-#include "macro_types.h"
-#include "systick.h"
-
-#include "led/led.h"
-#include "hp/hp.h"
-#include "moteur/moteur.h"
-#include "capteur/capteur.h"
-
-#define DELAY_COTE 3000	/** @def Temps maximale ou la voiture peut tourner, evite de tourner en rond (en ms)*/
-#define DELAY_ARRIERE 5000 /** @def Temmps maximale ou la voiture peut reculer (en ms)*/
-
-#define TEST 0  /** @def Variable indiquant si l'ont souhaite proceder aux testes des différents element de la voiture*/
-#define MUSIC 1 /** @def Variable indiquant si l'on souhaite ou non la musique lorsque la voiture est en marche avant*/
-
-typedef enum
-{
-	ARRET = 0,
-	MARCHE,
-	GAUCHE,
-	DROITE,
-	ARRIERE,
-	INIT
-} state_e; /** @enum Enumeration contenant les differents etats possiblde de la voiture*/
-
-typedef struct
-{
-	uint8_t AVANT;
-	uint8_t DROIT;
-	uint8_t GAUCHE;
-	uint8_t ARRIERE;
-} capteur_s; /** @struct Structure regroupant les id des capteurs*/
-
-static const capteur_s capteurID = (capteur_s){0, 1, 2, 3};
-static volatile state_e etatVoiture = INIT;
-static volatile bool_e on = FALSE;
-static volatile uint32_t MAIN_timer = 0;
-
-static void MAIN_process_ms(void);
-
-/**
- * @brief Fonction permettant d'avoir un compte du temps passe
- */
-static void MAIN_process_ms(void)
-{
-	MAIN_timer++;
-}
-
-int main(void)
-{
-	//Initialisation de la couche logicielle HAL (Hardware Abstraction Layer)
-	//Cette ligne doit rester la premi�re �tape de la fonction main().
-	HAL_Init();
-
-	//Initialisation de l'UART2 � la vitesse de 115200 bauds/secondes (92kbits/s) PA2 : Tx  | PA3 : Rx.
-	//Attention, les pins PA2 et PA3 ne sont pas reli�es jusqu'au connecteur de la Nucleo.
-	//Ces broches sont redirig�es vers la sonde de d�bogage, la liaison UART �tant ensuite encapsul�e sur l'USB vers le PC de d�veloppement.
-	UART_init(UART2_ID, 115200);
-
-	//"Indique que les printf sortent vers le p�riph�rique UART2."
-	SYS_set_std_usart(UART2_ID, UART2_ID, UART2_ID);
-
-	//On ajoute la fonction MAIN_process_ms � la liste des fonctions appel�es automatiquement chaque ms par la routine d'interruption du p�riph�rique SYSTICK
-	Systick_add_callback_function(&MAIN_process_ms);
-
-	MOTEUR_init();  //Initialisation des moteurs
-	HP_init();		//Initialisation du Haut-Parleur
-	CAPTEUR_init(); //Initialisation des capteurs
-	LED_init();		//Initialisation de la LED RGB
-
-#if TEST
-	MAIN_timer = 0;
-	Systick_add_callback_function(&MOTEUR_process_test); //Prend 4s avant de finir
-	//Systick_add_callback_function(&HP_process_test);	 //Prend 4s avant de finir
-	CAPTEUR_process_test();								 //Prend 4s avant de finir
-	//Systick_add_callback_function(&LED_process_test);	//Prend 4s avant de finir
-
-	while (MAIN_timer <= 5000)
-	{ //Boucle d'attente, permettant de réaliser l'ensemble des test sans difficulté
-		continue;
-	}
-	MAIN_timer = 0;
-#endif
-
-	while (1)
-	{
-		switch (etatVoiture)
-		{
-		case INIT:   //Cas au demarage de la voiture
-		case MARCHE: //Cas ou la voiture est en marche avant
-			if (!obstacle(capteurID.AVANT))
-			{ //Absence obstacle
-				if (!on)
-				{
-					marcheAvant();							   //Mise en marche des moteurs
-					Systick_add_callback_function(&LED_avant); //Ajout dans la file des interruption de l'allumage de la LED
-#if MUSIC
-					Systick_add_callback_function(&HP_marche);
-#endif
-					on = TRUE; //Variable permettant de ne pas rallumer des moteurs d�j� allum�s
-					etatVoiture = MARCHE;
-				}
-				if (MAIN_timer > 15000)
-				{ //Permet d'eviter que la voiture aille tout le temps tout droit
-					arret();
-					on = FALSE;
-					etatVoiture = DROITE;
-				}
-				break;
-			}
-			else
-			{
-				MAIN_timer = 0;
-				arret();
-				on = FALSE;
-				bool_e routeLibere = FALSE;
-#if MUSIC
-				Systick_remove_callback_function(&HP_marche);
-#endif
-				Systick_add_callback_function(&HP_klaxon);
-				while (MAIN_timer < 5000 && !routeLibere)
-				{ //Boucle laissant 5s a l'operateur de deplacer l'obstacle devant la voiture
-					if (!obstacle(capteurID.AVANT))
-					{
-						routeLibere = TRUE;
-						Systick_remove_callback_function(&HP_klaxon);
-					}
-				}
-				Systick_remove_callback_function(&LED_avant);
-				if (routeLibere)
-					break;
-			}
-			//Si obstacle se trouve devant la voiture, celle-ci regarde ensuite sur la droite immediatement
-			/* no break */
-
-		case DROITE:
-			if (!obstacle(capteurID.DROIT))
-			{ //Absence obstacle
-				if (!on)
-				{
-					tourneDroite();
-					Systick_add_callback_function(&LED_cote);
-					on = TRUE;
-					etatVoiture = DROITE;
-					MAIN_timer = 0;
-				}
-				else if (MAIN_timer > DELAY_COTE)
-					etatVoiture = INIT; //La voiture regardere de nouveau devant elle
-				break;
-			}
-			on = FALSE;
-			Systick_remove_callback_function(&LED_cote);
-			//Si obstacle se trouve a droite de la voiture, celle-ci regarde ensuite sur la gauche immediatement
-			/* no break */
-
-		case GAUCHE:
-			if (!obstacle(capteurID.GAUCHE))
-			{ //Absence obstacle
-				if (!on)
-				{
-					tourneGauche();
-					Systick_add_callback_function(&LED_cote);
-					on = TRUE;
-					etatVoiture = GAUCHE;
-					MAIN_timer = 0;
-				}
-				else if (MAIN_timer > DELAY_COTE)
-					etatVoiture = INIT;
-				break;
-			}
-			on = FALSE;
-			Systick_remove_callback_function(&LED_cote);
-			//Si obstacle se trouve a gauche de la voiture, celle-ci regarde ensuite a l'arriere immediatement
-			/* no break */
-
-		case ARRIERE:
-			if (!obstacle(capteurID.ARRIERE))
-			{ //Absence obstacle
-				if (!on)
-				{
-					marcheArriere();
-					Systick_add_callback_function(&LED_arriere);
-					Systick_add_callback_function(&HP_arriere);
-					on = TRUE;
-					etatVoiture = ARRIERE;
-					MAIN_timer = 0;
-				}
-				else if (MAIN_timer > DELAY_ARRIERE)
-					etatVoiture = INIT;
-				break;
-			}
-			on = FALSE;
-			Systick_remove_callback_function(&LED_arriere);
-			Systick_remove_callback_function(&HP_arriere);
-			//Si obstacle se trouve derriere la voiture, celle-ci regarde s'arrete immediatement
-			/* no break */
-
-		default:
-			if (!on)
-			{
-				arret(); //Arret des moteurs
-				Systick_add_callback_function(&LED_detresse);
-				Systick_add_callback_function(&HP_detresse);
-				etatVoiture = ARRET;
-				on = TRUE;
-			}
-		}
-	}
-}
+/**
+  ******************************************************************************
+  * @file    main.c
+  * @author  Gautier - Dufourmantelle
+  * @date    27-January-2020
+  * @brief   Default main function.
+  ******************************************************************************
+*/
+
+#include "stm32f1xx_hal.h"
+#include "stm32f1_uart.h"
+#include "stm32f1_sys.h"
+#include "stm32f1_gpio.h"
+#include "macro_types.h"
+#include "systick.h"
+#include "config.h"
+
+#include "led/led.h"
+#include "hp/hp.h"
+#include "moteur/moteur.h"
+#include "capteur/capteur.h"
+#include "evenement/evenement.h"
+#include "minuterie/minuterie.h"
+#include "registre/registre.h"
+#include "journal/journal.h"
+#include "sequenceur/sequenceur.h"
+#include "audio/audio.h"
+#include "croisiere/croisiere.h"
+#include "automate/automate.h"
+#include "comportement/comportement.h"
+#include "champ/champ.h"
+#include "mur/mur.h"
+#include "odometrie/odometrie.h"
+#include "gyro/gyro.h"
+#include "grille/grille.h"
+#include "historique/historique.h"
+#include "tache/tache.h"
+
+#define DELAY_COTE 3000	/** @def Temps maximale ou la voiture peut tourner, evite de tourner en rond (en ms)*/
+#define DELAY_ARRIERE 5000 /** @def Temmps maximale ou la voiture peut reculer (en ms)*/
+#define DELAY_MARCHE 15000	/** @def Temps apres lequel la voiture change de direction meme sans obstacle (en ms)*/
+#define DELAY_KLAXON 5000	/** @def Temps laisse a l'operateur pour retirer l'obstacle devant la voiture (en ms)*/
+
+#define TEST 0  /** @def Variable indiquant si l'ont souhaite proceder aux testes des différents element de la voiture*/
+#define MUSIC 1 /** @def Variable indiquant si l'on souhaite ou non la musique lorsque la voiture est en marche avant*/
+
+#define NAVIGATION_AUTOMATE 0	   /** @def Navigation par la machine a etats pilotee par table*/
+#define NAVIGATION_COMPORTEMENTS 1 /** @def Navigation par arbitrage de comportements*/
+#define NAVIGATION_CHAMP 2		   /** @def Comportements, la croisiere contournant les obstacles en arc par champ de repulsion*/
+#define NAVIGATION_MUR 3		   /** @def Comportements, la croisiere longeant un mur par correcteur PD, pour les couloirs*/
+#ifndef NAVIGATION
+#define NAVIGATION NAVIGATION_CHAMP /** @def Mode de navigation compile*/
+#endif
+#ifndef GYRO
+#define GYRO ((USE_MPU6050 || USE_SENSOR_LSM6DS3) && (CAPTURE_MATERIELLE || I2C1_ON_PB6_PB7)) /** @def Virages arretes sur le cap du gyroscope, sinon sur leur duree (automate) ou l'odometrie (comportements)*/
+#endif
+#if GYRO && !CAPTURE_MATERIELLE && !I2C1_ON_PB6_PB7
+#error "I2C1 remappe sur PB8/PB9 : le gyroscope exige CAPTURE_MATERIELLE, le pilote EXTI y lit deux echos"
+#endif
+#ifndef ANTI_BOUCLE
+#define ANTI_BOUCLE 1 /** @def Sortie des boucles de manoeuvres : une suite d'echecs repetee fait planifier une manoeuvre pas encore essayee*/
+#endif
+#define ANGLE_VIRAGE ODOMETRIE_DEGRES(90) /** @def Rotation des etats DROITE et GAUCHE quand le gyroscope est present*/
+#define ANGLE_DEMI_TOUR ODOMETRIE_DEGRES(176) /** @def Rotation visee par un demi-tour d'evasion : la rampe des moteurs acheve les derniers degres, 180 rendrait le sens de l'ecart ambigu*/
+#define PERIODE_CONTROLE 20 /** @def Periode de l'arbitrage des comportements (en ms)*/
+#define PUISSANCE_TOURNE 50 /** @def Puissance des roues pour tourner sur place, celle de tourneDroite (en %)*/
+#define PUISSANCE_RECUL 65	/** @def Puissance des roues en marche arriere, celle de marcheArriere (en %)*/
+#define ANGLE_FLANERIE ODOMETRIE_DEGRES(45)	  /** @def Rotation d'une flanerie*/
+#define DEGAGEMENT_MIN 400 /** @def Distance libre que la grille doit promettre pour qu'un degagement tourne vers elle (en mm)*/
+#define MUR_SUIVI MUR_DROITE /** @def Cote du mur longe en NAVIGATION_MUR*/
+#define DISTANCE_MUR 400	  /** @def Distance au mur longe a tenir en NAVIGATION_MUR (en mm)*/
+#define PERIODE_TELEMETRIE 1000 /** @def Periode de la tache de telemetrie (en ms)*/
+#define SANS_CAPTEUR 0xFF  /** @def Manoeuvre qu'aucun capteur n'interrompt : obstacle() est faux pour un identifiant inconnu*/
+#define DISTANCE_LIBRE 0xFFFF /** @def Espace vu par un capteur sans obstacle (en mm)*/
+#define DISTANCE_PIVOT 60	  /** @def Obstacle au flanc qu'un coin de la voiture heurterait en tournant sur place (en mm)*/
+#define TEMPO_ARRET 60		  /** @def Tempo de la musique de marche a puissance nulle (en % du tempo d'origine), 100 a pleine puissance*/
+
+typedef struct
+{
+	uint8_t AVANT;
+	uint8_t DROIT;
+	uint8_t GAUCHE;
+	uint8_t ARRIERE;
+} capteur_s; /** @struct Structure regroupant les id des capteurs*/
+
+static const capteur_s capteurID = (capteur_s){0, 1, 2, 3};
+static uint8_t puissance; //puissance de marche avant donnee par le regulateur de croisiere au dernier pas (en %)
+static tache_t navigation, telemetrie;
+#if TEST
+static tache_t test;
+#endif
+
+/**
+ * @retval le cap du gyroscope une fois etalonne, sinon celui de l'odometrie
+ */
+static int16_t cap(void)
+{
+#if GYRO
+	if (GYRO_pret())
+		return GYRO_get_cap();
+#endif
+	return ODOMETRIE_get_pose().cap;
+}
+
+/**
+ * @retval la position de l'odometrie, orientee par cap()
+ */
+static pose_t pose(void)
+{
+	pose_t p = ODOMETRIE_get_pose();
+
+	p.cap = cap();
+	return p;
+}
+
+/**
+ * @retval 1 pour tourner a gauche, -1 a droite : du cote de l'obstacle lateral le plus lointain
+ */
+static int8_t cote_degage(void)
+{
+	return (CAPTEUR_get_distance(capteurID.GAUCHE, DISTANCE_LIBRE) > CAPTEUR_get_distance(capteurID.DROIT, DISTANCE_LIBRE)) ? 1 : -1;
+}
+
+#if MUSIC
+/**
+ * @brief La musique de marche ralentit avec la voiture : son tempo suit la puissance du regulateur de croisiere
+ */
+static void accorder_tempo(void)
+{
+	HP_tempo(TEMPO_ARRET + (100 - TEMPO_ARRET) * puissance / 100);
+}
+#endif
+
+#if NAVIGATION == NAVIGATION_AUTOMATE
+typedef enum
+{
+	MARCHE = 0, //marche avant, puissance reglee par le regulateur de croisiere
+	KLAXON,		//obstacle devant : laisse DELAY_KLAXON a l'operateur pour le retirer
+	CHOIX,		//etat de passage : choisit le premier cote libre parmi droite, gauche, arriere
+	EVASION,	//etat de passage : la voiture boucle, suit la manoeuvre planifiee par l'historique
+	DROITE,
+	GAUCHE,
+	ARRIERE,
+	DEMI_TOUR,	//tourne sur place du cote le plus degage, de ANGLE_DEMI_TOUR au plus : s'arrete sur la voie libre
+	ARRET,		//bloque de toutes parts : detresse jusqu'a la remise sous tension
+	NB_ETATS
+} etat_voiture_e; /** @enum Etats de la voiture*/
+
+typedef enum
+{
+	RELEVE = 0, //un capteur a publie un releve
+	DELAI,		//le delai de l'etat courant est ecoule
+	VIRAGE		//le gyroscope a vu la voiture tourner de ANGLE_VIRAGE
+} evenement_voiture_e; /** @enum Evenements presentes a l'automate*/
+
+static int16_t capDemiTour; //cap a l'entree dans DEMI_TOUR
+static int8_t sensDemiTour; //1 a gauche, -1 a droite
+#if ANTI_BOUCLE
+static uint8_t plan = HISTORIQUE_AUCUNE; //manoeuvre choisie par le planificateur pour l'etat EVASION
+#endif
+
+//Gardes de l'automate, sans effet de bord : puissance est lue une fois avant chaque pas
+static bool_e devant_bloque(void)
+{
+	return puissance == 0;
+}
+static bool_e devant_libre(void)
+{
+	return puissance != 0;
+}
+static bool_e droite_bloquee(void)
+{
+	return obstacle(capteurID.DROIT);
+}
+static bool_e droite_libre(void)
+{
+	return !obstacle(capteurID.DROIT);
+}
+static bool_e gauche_bloquee(void)
+{
+	return obstacle(capteurID.GAUCHE);
+}
+static bool_e gauche_libre(void)
+{
+	return !obstacle(capteurID.GAUCHE);
+}
+static bool_e arriere_bloque(void)
+{
+	return obstacle(capteurID.ARRIERE);
+}
+static bool_e arriere_libre(void)
+{
+	return !obstacle(capteurID.ARRIERE);
+}
+static bool_e voie_libre(void)
+{
+	return !obstacle(capteurID.AVANT);
+}
+static bool_e flanc_frole(void)
+{
+	return CAPTEUR_get_distance((sensDemiTour > 0) ? capteurID.GAUCHE : capteurID.DROIT, DISTANCE_LIBRE) < DISTANCE_PIVOT;
+}
+static bool_e demi_tour_fait(void)
+{
+	int16_t tourne = cap() - capDemiTour;
+
+	return (uint16_t)((tourne < 0) ? -tourne : tourne) >= ANGLE_DEMI_TOUR;
+}
+#if ANTI_BOUCLE
+static bool_e en_boucle(void)
+{
+	return HISTORIQUE_boucle() != 0;
+}
+static bool_e demi_tour_inedit(void)
+{
+	return !HISTORIQUE_essayee(DEMI_TOUR);
+}
+static bool_e plan_droite(void)
+{
+	return plan == DROITE;
+}
+static bool_e plan_gauche(void)
+{
+	return plan == GAUCHE;
+}
+static bool_e plan_arriere(void)
+{
+	return plan == ARRIERE;
+}
+#endif
+
+//Actions, entrees et sorties : elles seules touchent aux moteurs, a la LED et au HP
+static void avancer(void)
+{
+	MOTEUR_avancer(puissance); //La rampe des moteurs lisse les variations de consigne
+#if MUSIC
+	accorder_tempo();
+#endif
+}
+static void entree_marche(void)
+{
+	LED_avant(); //Lancement du clignotement de la LED par le sequenceur
+#if MUSIC
+	HP_marche();
+#endif
+}
+static void entree_klaxon(void)
+{
+	HP_klaxon();
+}
+static void entree_choix(void)
+{
+	HISTORIQUE_bloque(pose()); //Juge la derniere manoeuvre avant que les gardes de CHOIX ne cherchent une boucle
+}
+#if ANTI_BOUCLE
+static void planifier(void)
+{
+	uint8_t candidats[4];
+	uint8_t nb = 0;
+
+	if (droite_libre())
+		candidats[nb++] = DROITE;
+	if (gauche_libre())
+		candidats[nb++] = GAUCHE;
+	if (arriere_libre())
+		candidats[nb++] = ARRIERE;
+	candidats[nb++] = DEMI_TOUR;
+	plan = HISTORIQUE_planifier(candidats, nb);
+}
+#endif
+static void entree_droite(void)
+{
+	HISTORIQUE_debut(DROITE, pose());
+#if GYRO
+	GYRO_viser(-ANGLE_VIRAGE);
+#endif
+	tourneDroite();
+	LED_cote();
+}
+static void entree_gauche(void)
+{
+	HISTORIQUE_debut(GAUCHE, pose());
+#if GYRO
+	GYRO_viser(ANGLE_VIRAGE);
+#endif
+	tourneGauche();
+	LED_cote();
+}
+static void entree_arriere(void)
+{
+	HISTORIQUE_debut(ARRIERE, pose());
+	marcheArriere();
+	LED_arriere();
+	HP_arriere();
+}
+static void entree_demi_tour(void)
+{
+	HISTORIQUE_debut(DEMI_TOUR, pose());
+	capDemiTour = cap();
+	sensDemiTour = cote_degage();
+	if (sensDemiTour > 0)
+		tourneGauche();
+	else
+		tourneDroite();
+	LED_cote();
+}
+static void entree_arret(void)
+{
+	LED_detresse(); //Lances dans la meme ms, la LED et le HP font le SOS en phase
+	HP_detresse();
+	AUTOMATE_afficher_trace(); //La voiture est bloquee : le journal garde le chemin qui y a mene
+}
+static void sortie_manoeuvre(void)
+{
+#if GYRO
+	GYRO_annuler(); //Virage interrompu par un obstacle ou son delai
+#endif
+	arret(); //Arret des moteurs
+	LED_eteindre();
+	HP_silence();
+}
+
+static const etat_t etats[NB_ETATS] = {
+	[MARCHE] = {"MARCHE", &entree_marche, &sortie_manoeuvre, DELAY_MARCHE},
+	[KLAXON] = {"KLAXON", &entree_klaxon, &sortie_manoeuvre, DELAY_KLAXON},
+	[CHOIX] = {"CHOIX", &entree_choix, NULL, 0},
+	[EVASION] = {"EVASION", NULL, NULL, 0},
+	[DROITE] = {"DROITE", &entree_droite, &sortie_manoeuvre, DELAY_COTE},
+	[GAUCHE] = {"GAUCHE", &entree_gauche, &sortie_manoeuvre, DELAY_COTE},
+	[ARRIERE] = {"ARRIERE", &entree_arriere, &sortie_manoeuvre, DELAY_ARRIERE},
+	[DEMI_TOUR] = {"DEMI_TOUR", &entree_demi_tour, &sortie_manoeuvre, DELAY_COTE},
+	[ARRET] = {"ARRET", &entree_arret, NULL, 0},
+};
+
+/*
+ * Table des transitions, groupee par etat de depart. Dans un etat, la premiere ligne
+ * dont la garde est vraie l'emporte : l'ordre des lignes fixe les priorites.
+ */
+static const transition_t transitions[] = {
+	{MARCHE, AUTOMATE_TOUS, &devant_bloque, NULL, KLAXON},
+	{MARCHE, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, CHOIX}, //Evite que la voiture aille tout le temps tout droit
+	{MARCHE, AUTOMATE_TOUS, NULL, &avancer, AUTOMATE_RESTE},
+
+	{KLAXON, AUTOMATE_TOUS, &devant_libre, NULL, MARCHE},
+	{KLAXON, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, CHOIX},
+
+#if ANTI_BOUCLE
+	{CHOIX, AUTOMATE_TOUS, &en_boucle, &planifier, EVASION}, //Les manoeuvres ordinaires echouent en boucle a cet endroit
+#endif
+	{CHOIX, AUTOMATE_TOUS, &droite_libre, NULL, DROITE},
+	{CHOIX, AUTOMATE_TOUS, &gauche_libre, NULL, GAUCHE},
+	{CHOIX, AUTOMATE_TOUS, &arriere_libre, NULL, ARRIERE},
+#if ANTI_BOUCLE
+	{CHOIX, AUTOMATE_TOUS, &demi_tour_inedit, NULL, DEMI_TOUR}, //Bloque de toutes parts, il reste a tourner sur place : une fois par endroit
+#endif
+	{CHOIX, AUTOMATE_TOUS, NULL, NULL, ARRET},
+
+#if ANTI_BOUCLE
+	{EVASION, AUTOMATE_TOUS, &plan_droite, NULL, DROITE},
+	{EVASION, AUTOMATE_TOUS, &plan_gauche, NULL, GAUCHE},
+	{EVASION, AUTOMATE_TOUS, &plan_arriere, NULL, ARRIERE},
+	{EVASION, AUTOMATE_TOUS, NULL, NULL, DEMI_TOUR},
+#endif
+
+	{DROITE, AUTOMATE_TOUS, &droite_bloquee, NULL, CHOIX},
+	{DROITE, VIRAGE, NULL, NULL, MARCHE},
+	{DROITE, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, MARCHE},
+
+	{GAUCHE, AUTOMATE_TOUS, &gauche_bloquee, NULL, CHOIX},
+	{GAUCHE, VIRAGE, NULL, NULL, MARCHE},
+	{GAUCHE, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, MARCHE},
+
+#if ANTI_BOUCLE
+	{ARRIERE, AUTOMATE_TOUS, &arriere_bloque, NULL, CHOIX}, //Recul juge par l'historique, CHOIX ne s'arrete que bloque de toutes parts
+#else
+	{ARRIERE, AUTOMATE_TOUS, &arriere_bloque, NULL, ARRET},
+#endif
+	{ARRIERE, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, MARCHE},
+
+	{DEMI_TOUR, AUTOMATE_TOUS, &flanc_frole, NULL, CHOIX},
+	{DEMI_TOUR, AUTOMATE_TOUS, &voie_libre, NULL, MARCHE}, //Premiere direction libre : la voiture s'ecarte de l'obstacle au lieu de le longer
+	{DEMI_TOUR, AUTOMATE_TOUS, &demi_tour_fait, NULL, MARCHE},
+	{DEMI_TOUR, AUTOMATE_TOUS, &AUTOMATE_delai_ecoule, NULL, MARCHE},
+};
+
+#else
+typedef enum
+{
+	EVADER = 0,	 //la voiture boucle et l'historique a planifie un demi-tour : pivote de ANGLE_DEMI_TOUR au plus, en au plus DELAY_COTE
+	RECULER,	 //coince devant et des deux cotes : recule au plus DELAY_ARRIERE
+	DEGAGER,	 //bloque devant depuis DELAY_KLAXON : pivote vers la direction la plus degagee de la grille, en au plus DELAY_COTE
+	EVITER,		 //obstacle devant : arrete la voiture et klaxonne
+	FLANER,		 //DELAY_MARCHE tout droit : inflechit la marche avant vers un cote libre
+	CROISER,	 //marche avant a la puissance du regulateur de croisiere
+	NB_COMPORTEMENTS
+} comportement_e; /** @enum Comportements de la voiture*/
+
+typedef struct
+{
+	uint32_t debut;		 //date du lancement (en ms)
+	uint8_t capteur;	 //capteur dont un obstacle interrompt la manoeuvre
+	uint8_t flanc;		 //capteur du cote ou la voiture pivote, un obstacle a DISTANCE_PIVOT l'interrompt
+	uint8_t guide;		 //capteur dont la voie libre acheve la manoeuvre, SANS_CAPTEUR si aucun
+	commande_t commande; //commande des roues pendant la manoeuvre
+	int16_t capDepart;	 //cap estime au lancement
+	uint16_t angle;		 //rotation au bout de laquelle la manoeuvre s'arrete, 0 si elle n'est limitee qu'en duree (angle binaire)
+	bool_e enCours;
+} manoeuvre_t; /** @struct Manoeuvre de duree limitee d'un comportement*/
+
+static bool_e devantBloque = FALSE;
+static uint32_t devantBloqueDepuis; //date de debut du blocage avant, repoussee a la fin d'une manoeuvre (en ms)
+static uint32_t finManoeuvre;		//date de fin de la derniere manoeuvre (en ms)
+static manoeuvre_t demiTour, recul, degagement, flanerie;
+static uint8_t plan = HISTORIQUE_AUCUNE; //manoeuvre de degagement imposee par le planificateur, lancee au meme pas
+
+//Capteurs vus par la grille d'occupation, dans l'ordre de capteurID
+static const monture_t montures[] = {
+	{0, 100, 0, ODOMETRIE_DEGRES(0)},
+	{1, 0, -80, ODOMETRIE_DEGRES(-90)},
+	{2, 0, 80, ODOMETRIE_DEGRES(90)},
+	{3, -100, 0, ODOMETRIE_DEGRES(180)},
+};
+
+/**
+ * @retval TRUE si l'obstacle avant est reste DELAY_KLAXON sans etre retire. Un releve avant anterieur a la fin
+ * 			de la derniere manoeuvre ne dit rien de la nouvelle direction : il ne fait pas enchainer une autre manoeuvre.
+ */
+static bool_e coince(void)
+{
+	uint32_t maintenant = MINUTERIE_maintenant();
+
+	return devantBloque && maintenant - devantBloqueDepuis >= DELAY_KLAXON && CAPTEUR_get_releve(capteurID.AVANT).age < maintenant - finManoeuvre;
+}
+
+/**
+ * @retval TRUE si une manoeuvre de degagement est en cours : une seule a la fois, pour que l'historique suive celle qui a les moteurs
+ */
+static bool_e manoeuvrant(void)
+{
+	return demiTour.enCours || recul.enCours || degagement.enCours;
+}
+
+/**
+ * @brief Lecture des capteurs commune a tous les comportements, faite avant chaque pas de controle.
+ * 		Coincee entre deux manoeuvres, la voiture juge la derniere ; si les echecs se repetent,
+ * 		le planificateur choisit la manoeuvre suivante parmi celles possibles.
+ */
+static void percevoir(void)
+{
+	puissance = CROISIERE_puissance();
+	if (puissance == 0 && !devantBloque)
+		devantBloqueDepuis = MINUTERIE_maintenant();
+	devantBloque = (puissance == 0);
+	if (!coince() || manoeuvrant())
+		return;
+	HISTORIQUE_bloque(pose());
+#if ANTI_BOUCLE
+	if (HISTORIQUE_boucle())
+	{
+		uint8_t candidats[3];
+		uint8_t nb = 0;
+		uint16_t libre;
+
+		if (!obstacle(capteurID.ARRIERE))
+			candidats[nb++] = RECULER;
+		if (GRILLE_direction_libre(pose(), &libre) != 0 && libre >= DEGAGEMENT_MIN)
+			candidats[nb++] = DEGAGER;
+		candidats[nb++] = EVADER;
+		plan = HISTORIQUE_planifier(candidats, nb);
+	}
+#endif
+}
+
+static void lancer(manoeuvre_t *m, uint8_t capteur, int8_t droite, int8_t gauche, uint16_t angle)
+{
+	m->debut = MINUTERIE_maintenant();
+	m->capteur = capteur;
+	m->flanc = SANS_CAPTEUR;
+	m->guide = SANS_CAPTEUR;
+	m->commande = (commande_t){droite, gauche};
+	m->capDepart = cap();
+	m->angle = angle;
+	m->enCours = TRUE;
+}
+
+/**
+ * @brief Lance une rotation sur place qui s'arrete sur la premiere direction libre devant,
+ * 		ou des que le flanc qui tourne frole un obstacle
+ * @param sens : 1 a gauche, -1 a droite
+ */
+static void pivoter(manoeuvre_t *m, int8_t sens, uint16_t angle)
+{
+	lancer(m, SANS_CAPTEUR, (int8_t)(sens * PUISSANCE_TOURNE), (int8_t)(-sens * PUISSANCE_TOURNE), angle);
+	m->flanc = (sens > 0) ? capteurID.GAUCHE : capteurID.DROIT;
+	m->guide = capteurID.AVANT;
+}
+
+/**
+ * @brief Inscrit dans l'historique une manoeuvre de degagement qui se lance, le plan eventuel est consomme
+ */
+static void entreprendre(comportement_e comportement)
+{
+	HISTORIQUE_debut(comportement, pose());
+	plan = HISTORIQUE_AUCUNE;
+}
+
+/**
+ * @brief Poursuit une manoeuvre tant que son capteur et son flanc sont libres, que son guide voit
+ * 		encore un obstacle, que sa rotation n'est pas faite et que sa duree n'est pas ecoulee.
+ * 		Au bout de sa duree, l'obstacle avant eventuel a de nouveau DELAY_KLAXON pour etre retire ;
+ * 		interrompue par un obstacle, la voie libre ou sa rotation faite, elle laisse aussitot la main
+ * 		a une autre manoeuvre.
+ * @retval TRUE si la manoeuvre propose encore sa commande
+ */
+static bool_e poursuivre(manoeuvre_t *m, uint32_t duree, commande_t *c)
+{
+	int16_t tourne = cap() - m->capDepart;
+	bool_e enCours = m->enCours;
+
+	if (m->enCours && (obstacle(m->capteur) || CAPTEUR_get_distance(m->flanc, DISTANCE_LIBRE) < DISTANCE_PIVOT))
+		m->enCours = FALSE;
+	else if (m->enCours && m->guide != SANS_CAPTEUR && !obstacle(m->guide))
+		m->enCours = FALSE;
+	else if (m->enCours && m->angle && (uint16_t)((tourne < 0) ? -tourne : tourne) >= m->angle)
+		m->enCours = FALSE;
+	else if (m->enCours && MINUTERIE_maintenant() - m->debut >= duree)
+	{
+		m->enCours = FALSE;
+		devantBloqueDepuis = MINUTERIE_maintenant();
+	}
+	if (m->enCours)
+		*c = m->commande;
+	else if (enCours)
+		finManoeuvre = MINUTERIE_maintenant();
+	return m->enCours;
+}
+
+//Propositions des comportements
+static bool_e evader(commande_t *c)
+{
+	if (plan == EVADER)
+	{
+		entreprendre(EVADER);
+		pivoter(&demiTour, cote_degage(), ANGLE_DEMI_TOUR);
+	}
+	return poursuivre(&demiTour, DELAY_COTE, c);
+}
+static bool_e reculer(commande_t *c)
+{
+	bool_e cotesBloques = obstacle(capteurID.DROIT) && obstacle(capteurID.GAUCHE);
+
+	if (!manoeuvrant() && coince() && !obstacle(capteurID.ARRIERE) && (plan == RECULER || (plan == HISTORIQUE_AUCUNE && cotesBloques)))
+	{
+		entreprendre(RECULER);
+		lancer(&recul, capteurID.ARRIERE, -PUISSANCE_RECUL, -PUISSANCE_RECUL, 0);
+	}
+	return poursuivre(&recul, DELAY_ARRIERE, c);
+}
+static bool_e degager(commande_t *c)
+{
+	if (!manoeuvrant() && coince() && (plan == DEGAGER || plan == HISTORIQUE_AUCUNE))
+	{
+		//La grille se souvient de ce que les capteurs ont vu en approchant : la voiture tourne d'emblee
+		//vers la direction la plus degagee
+		uint16_t libre;
+		int16_t direction = GRILLE_direction_libre(pose(), &libre);
+
+		if (libre >= DEGAGEMENT_MIN && direction != 0)
+			entreprendre(DEGAGER);
+		if (libre >= DEGAGEMENT_MIN && direction < 0)
+			pivoter(&degagement, -1, (uint16_t)-direction);
+		else if (libre >= DEGAGEMENT_MIN && direction > 0)
+			pivoter(&degagement, 1, (uint16_t)direction);
+	}
+	return poursuivre(&degagement, DELAY_COTE, c);
+}
+static bool_e eviter(commande_t *c)
+{
+	*c = (commande_t){0, 0};
+	return devantBloque;
+}
+static bool_e flaner(commande_t *c)
+{
+	if (devantBloque || NAVIGATION == NAVIGATION_MUR)
+		flanerie.enCours = FALSE; //Le long d'un mur, la flanerie ne ferait qu'ecarter la voiture de sa consigne
+	else if (!flanerie.enCours && COMPORTEMENT_get_maitre() == CROISER && COMPORTEMENT_duree() >= DELAY_MARCHE)
+	{
+		//Evite que la voiture aille tout le temps tout droit : melangee a la croisiere, la rotation courbe la trajectoire
+		//vers le cote que la grille sait le plus degage
+		pose_t p = pose();
+		bool_e droite = GRILLE_degagement(p, -ANGLE_FLANERIE) >= GRILLE_degagement(p, ANGLE_FLANERIE);
+
+		if (!obstacle(capteurID.DROIT) && (droite || obstacle(capteurID.GAUCHE)))
+			lancer(&flanerie, capteurID.DROIT, -PUISSANCE_TOURNE, PUISSANCE_TOURNE, ANGLE_FLANERIE);
+		else if (!obstacle(capteurID.GAUCHE))
+			lancer(&flanerie, capteurID.GAUCHE, PUISSANCE_TOURNE, -PUISSANCE_TOURNE, ANGLE_FLANERIE);
+	}
+	return poursuivre(&flanerie, DELAY_COTE, c);
+}
+static bool_e croiser(commande_t *c)
+{
+#if NAVIGATION == NAVIGATION_CHAMP
+	*c = CHAMP_commande(puissance);
+#elif NAVIGATION == NAVIGATION_MUR
+	*c = MUR_commande(puissance);
+#else
+	*c = (commande_t){(int8_t)puissance, (int8_t)puissance};
+#endif
+#if MUSIC
+	accorder_tempo(); //le tempo d'une melodie deja lancee par prise_croisiere
+#endif
+	return puissance != 0;
+}
+
+//Prises des moteurs : elles seules touchent a la LED et au HP
+static void prise_recul(void)
+{
+	LED_arriere();
+	HP_arriere();
+}
+static void prise_virage(void)
+{
+	LED_cote();
+	HP_silence();
+}
+static void prise_arret(void)
+{
+	LED_eteindre();
+	HP_klaxon();
+}
+static void prise_croisiere(void)
+{
+	LED_avant();
+#if MUSIC
+	HP_marche();
+#else
+	HP_silence();
+#endif
+}
+
+/*
+ * Du plus prioritaire au moins prioritaire. La flanerie et la croisiere ont la meme priorite :
+ * leurs commandes sont melangees, la flanerie pesant deux fois plus.
+ */
+static const comportement_t comportements[NB_COMPORTEMENTS] = {
+	[EVADER] = {"evader", &evader, &prise_virage, 5, 1},
+	[RECULER] = {"reculer", &reculer, &prise_recul, 4, 1},
+	[DEGAGER] = {"degager", &degager, &prise_virage, 3, 1},
+	[EVITER] = {"eviter", &eviter, &prise_arret, 2, 1},
+	[FLANER] = {"flaner", &flaner, &prise_virage, 1, 2},
+	[CROISER] = {"croiser", &croiser, &prise_croisiere, 1, 1},
+};
+#endif
+
+/**
+ * @brief Tache de navigation : initialise le mode compile, puis fait un pas a chaque evenement qui la reveille
+ */
+static etat_tache_e naviguer(tache_t *t)
+{
+	TACHE_DEBUT(t);
+#if NAVIGATION == NAVIGATION_AUTOMATE
+	ODOMETRIE_init(); //Positions des manoeuvres de l'historique
+	HISTORIQUE_init();
+	//La voiture demarre en marche avant : l'entree dans MARCHE lance la LED et la musique
+	puissance = CROISIERE_puissance();
+	if (!AUTOMATE_init(etats, NB_ETATS, transitions, sizeof(transitions) / sizeof(transitions[0]), MARCHE))
+		JOURNAL_2(JOURNAL_AUTOMATE_TABLE, NB_ETATS, sizeof(transitions) / sizeof(transitions[0]));
+#else
+	ODOMETRIE_init();
+	GRILLE_init(montures, sizeof(montures) / sizeof(montures[0]));
+	HISTORIQUE_init();
+	CHAMP_init(capteurID.AVANT, capteurID.DROIT, capteurID.GAUCHE);
+	MUR_init(capteurID.AVANT, (MUR_SUIVI == MUR_DROITE) ? capteurID.DROIT : capteurID.GAUCHE, MUR_SUIVI, DISTANCE_MUR);
+	COMPORTEMENT_init(comportements, NB_COMPORTEMENTS, PERIODE_CONTROLE);
+#endif
+	for (;;)
+	{
+		TACHE_CEDER(t);
+#if NAVIGATION == NAVIGATION_AUTOMATE
+		ODOMETRIE_pas();
+		puissance = CROISIERE_puissance(); //une fois par pas, avant les gardes qui la lisent
+		if (t->recus & EVENEMENT_MASQUE(EVENEMENT_CAPTEUR))
+			AUTOMATE_pas(RELEVE);
+		if (t->recus & EVENEMENT_MASQUE(EVENEMENT_TIMER))
+			AUTOMATE_pas(DELAI);
+		if (t->recus & EVENEMENT_MASQUE(EVENEMENT_VIRAGE))
+			AUTOMATE_pas(VIRAGE);
+#else
+		ODOMETRIE_pas();
+		GRILLE_pas(pose());
+		percevoir();
+		COMPORTEMENT_pas();
+#endif
+	}
+	TACHE_FIN(t);
+}
+
+/**
+ * @brief Tache de telemetrie : journalise la pose estimee et le temps de repos du processeur
+ */
+static etat_tache_e telemetrer(tache_t *t)
+{
+	pose_t p = pose();
+
+	(void)t;
+	JOURNAL_4(JOURNAL_TELEMETRIE, p.x, p.y, (int32_t)p.cap * 180 / ODOMETRIE_DEMI_TOUR, EVENEMENT_get_stat().repos);
+	return TACHE_EN_COURS;
+}
+
+#if TEST
+/**
+ * @brief Tache des tests : moteurs et capteurs tournent pendant 4s, les mesures et le cout des traitements
+ * 		sont journalises, puis la navigation demarre. La boucle principale dort pendant les attentes.
+ */
+static etat_tache_e tester(tache_t *t)
+{
+	TACHE_DEBUT(t);
+	REGISTRE_reserver(&MOTEUR_process_test, "MOTEUR_process_test", TRUE); //Prend 4s avant de finir
+	//REGISTRE_reserver(&HP_process_test, "HP_process_test", TRUE);	 //Prend 4s avant de finir
+	//REGISTRE_reserver(&LED_process_test, "LED_process_test", TRUE); //Prend 4s avant de finir
+	TACHE_DORMIR(t, 4000);
+	CAPTEUR_process_test();
+	TACHE_DORMIR(t, 1000); //Laisse les moteurs finir leur sequence
+	REGISTRE_afficher();
+	TACHE_afficher();
+	TACHE_activer(&navigation);
+	TACHE_FIN(t);
+}
+#endif
+
+int main(void)
+{
+	//Initialisation de la couche logicielle HAL (Hardware Abstraction Layer)
+	//Cette ligne doit rester la premi�re �tape de la fonction main().
+	HAL_Init();
+
+	//Initialisation de l'UART2 � la vitesse de 115200 bauds/secondes (92kbits/s) PA2 : Tx  | PA3 : Rx.
+	//Attention, les pins PA2 et PA3 ne sont pas reli�es jusqu'au connecteur de la Nucleo.
+	//Ces broches sont redirig�es vers la sonde de d�bogage, la liaison UART �tant ensuite encapsul�e sur l'USB vers le PC de d�veloppement.
+	UART_init(UART2_ID, 115200);
+
+	//"Indique que les printf sortent vers le p�riph�rique UART2."
+	SYS_set_std_usart(UART2_ID, UART2_ID, UART2_ID);
+
+	//Registre des traitements Systick : les modules y reservent leurs places a l'initialisation
+	REGISTRE_init();
+	//Base de temps unique, les modules y arment leurs minuteries
+	MINUTERIE_init();
+	//Les messages sont journalises en binaire et emis par DMA, voir outils/decodeur_journal.c
+	JOURNAL_init();
+	//Motifs lumineux et sonores joues depuis une seule place du registre
+	SEQUENCEUR_init();
+
+	MOTEUR_init();  //Initialisation des moteurs
+	HP_init();		//Initialisation du Haut-Parleur
+	AUDIO_init();	//Sons echantillonnes du HP, par DMA
+	CAPTEUR_init(); //Initialisation des capteurs
+	LED_init();		//Initialisation de la LED RGB
+	EVENEMENT_init();
+	CROISIERE_init(capteurID.AVANT); //La puissance de marche avant suit la distance devant la voiture
+#if GYRO
+	GYRO_init(); //Cap integre sous interruption, etalonne pendant la premiere seconde de marche avant
+#endif
+
+	//Les taches de la boucle principale : la navigation attend la fin des tests s'ils sont compiles
+	TACHE_init();
+#if NAVIGATION == NAVIGATION_AUTOMATE
+	TACHE_creer(&navigation, "navigation", &naviguer, 0, EVENEMENT_MASQUE(EVENEMENT_CAPTEUR) | EVENEMENT_MASQUE(EVENEMENT_TIMER) | EVENEMENT_MASQUE(EVENEMENT_VIRAGE), 2, !TEST);
+#else
+	TACHE_creer(&navigation, "navigation", &naviguer, 0, EVENEMENT_MASQUE(EVENEMENT_CONTROLE), 2, !TEST);
+#endif
+#if TEST
+	TACHE_creer(&test, "test", &tester, 0, 0, 1, TRUE);
+#endif
+	TACHE_creer(&telemetrie, "telemetrie", &telemetrer, PERIODE_TELEMETRIE, 0, 0, TRUE);
+
+	while (1)
+	{
+		//Le processeur dort jusqu'a un nouveau releve ou une echeance, puis les taches reveillees font un pas
+		TACHE_ordonnancer(EVENEMENT_attendre());
+	}
+}
@@ -0,0 +1,177 @@
+/**
+ ******************************************************************************
+ * @file 	minuterie.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Base de temps unique et minuteries logicielles, rangees dans une roue hierarchique
+ * 			a trois niveaux de 64 cases : 1 ms, 64 ms puis 4096 ms par case.
+ * 			L'armement et l'annulation sont en temps constant ; a chaque ms seule la case courante
+ * 			du premier niveau est parcourue, les niveaux superieurs y etant redescendus au passage.
+ * @note	Une seule place du registre Systick pour tout le logiciel : un module ajoute des minuteries, pas du travail en interruption.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "registre/registre.h"
+#include "minuterie.h"
+
+#define BITS_NIVEAU 6						   /** @def 64 cases par niveau*/
+#define CASES_NIVEAU (1UL << BITS_NIVEAU)
+#define MASQUE_NIVEAU (CASES_NIVEAU - 1)
+#define NB_NIVEAUX 3
+#define PORTEE_ROUE (1UL << (BITS_NIVEAU * NB_NIVEAUX)) /** @def Delai maximal range directement, 262 s (en ms)*/
+
+static minuterie_t *roue[NB_NIVEAUX][CASES_NIVEAU];
+static volatile uint32_t maintenant = 0;
+
+static void MINUTERIE_process_ms(void);
+static void ranger(minuterie_t *);
+static void retirer(minuterie_t *);
+static void redescendre(uint8_t);
+
+/**
+ * @brief Range une minuterie dans la case correspondant a son echeance
+ * @note  Au dela de la portee de la roue, la minuterie attend dans la case la plus lointaine
+ * 			et sera rangee de nouveau quand cette case redescendra
+ */
+static void ranger(minuterie_t *m)
+{
+	uint32_t delai = m->echeance - maintenant;
+	uint32_t echeance = (delai < PORTEE_ROUE) ? m->echeance : maintenant + PORTEE_ROUE - 1;
+	minuterie_t **tete;
+
+	if (delai < CASES_NIVEAU)
+		tete = &roue[0][echeance & MASQUE_NIVEAU];
+	else if (delai < (1UL << (2 * BITS_NIVEAU)))
+		tete = &roue[1][(echeance >> BITS_NIVEAU) & MASQUE_NIVEAU];
+	else
+		tete = &roue[2][(echeance >> (2 * BITS_NIVEAU)) & MASQUE_NIVEAU];
+
+	m->suivante = *tete;
+	if (m->suivante)
+		m->suivante->precedente = &m->suivante;
+	*tete = m;
+	m->precedente = tete;
+}
+
+static void retirer(minuterie_t *m)
+{
+	*m->precedente = m->suivante;
+	if (m->suivante)
+		m->suivante->precedente = m->precedente;
+	m->suivante = NULL;
+	m->precedente = NULL;
+}
+
+/**
+ * @brief Redescend la case courante d'un niveau vers les niveaux inferieurs
+ */
+static void redescendre(uint8_t niveau)
+{
+	minuterie_t **tete = &roue[niveau][(maintenant >> (niveau * BITS_NIVEAU)) & MASQUE_NIVEAU];
+
+	while (*tete)
+	{
+		minuterie_t *m = *tete;
+		retirer(m);
+		ranger(m);
+	}
+}
+
+/**
+ * @brief Avance la base de temps et appelle les minuteries arrivees a echeance
+ * @note  Appele chaque ms par la routine d'interruption du Systick
+ */
+static void MINUTERIE_process_ms(void)
+{
+	minuterie_t *expirees;
+
+	maintenant++;
+	if ((maintenant & MASQUE_NIVEAU) == 0)
+	{
+		if (((maintenant >> BITS_NIVEAU) & MASQUE_NIVEAU) == 0)
+			redescendre(2);
+		redescendre(1);
+	}
+
+	//La case est detachee avant les appels : un callback peut armer ou annuler n'importe quelle minuterie
+	expirees = roue[0][maintenant & MASQUE_NIVEAU];
+	roue[0][maintenant & MASQUE_NIVEAU] = NULL;
+	if (expirees)
+		expirees->precedente = &expirees;
+	while (expirees)
+	{
+		minuterie_t *m = expirees;
+		retirer(m);
+		if (m->periode)
+		{
+			m->echeance += m->periode;
+			ranger(m);
+		}
+		if (m->callback)
+			(*m->callback)();
+	}
+}
+
+/**
+ * @brief Initialise la base de temps, a appeler juste apres REGISTRE_init, avant tout autre module
+ */
+void MINUTERIE_init(void)
+{
+	REGISTRE_reserver(&MINUTERIE_process_ms, "MINUTERIE_process_ms", TRUE);
+}
+
+/**
+ * @brief Base de temps monotone
+ * @retval le nombre de ms ecoulees depuis MINUTERIE_init
+ */
+uint32_t MINUTERIE_maintenant(void)
+{
+	return maintenant;
+}
+
+/**
+ * @brief Arme (ou rearme) une minuterie
+ * @param m : minuterie, allouee par l'appelant et qui doit survivre tant qu'elle est armee
+ * @param delai : delai avant la premiere expiration (en ms), au moins 1
+ * @param periode : periode de rearmement (en ms), 0 pour une minuterie a un coup
+ * @param callback : fonction appelee sous interruption Systick a chaque expiration
+ * @note  Appelable depuis la boucle principale comme depuis un callback
+ */
+void MINUTERIE_armer(minuterie_t *m, uint32_t delai, uint32_t periode, callback_fun_t callback)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if (m->precedente)
+		retirer(m);
+	m->echeance = maintenant + (delai ? delai : 1);
+	m->periode = periode;
+	m->callback = callback;
+	ranger(m);
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Annule une minuterie, sans effet si elle n'est pas armee
+ */
+void MINUTERIE_annuler(minuterie_t *m)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if (m->precedente)
+		retirer(m);
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @retval TRUE si la minuterie attend son echeance
+ */
+bool_e MINUTERIE_armee(const minuterie_t *m)
+{
+	return m->precedente ? TRUE : FALSE;
+}
@@ -0,0 +1,27 @@
+/**
+ ******************************************************************************
+ * @file 	minuterie.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef MINUTERIE_H_
+#define MINUTERIE_H_
+
+typedef struct minuterie_s
+{
+	struct minuterie_s *suivante;
+	struct minuterie_s **precedente; //lien qui pointe sur cette minuterie, NULL si elle n'est pas armee
+	uint32_t echeance;				 //date d'expiration (en ms, base de temps MINUTERIE_maintenant)
+	uint32_t periode;				 //0 : minuterie a un coup
+	callback_fun_t callback;		 //appelee sous interruption Systick a l'expiration
+} minuterie_t; /** @struct Minuterie logicielle, a allouer en statique par le module qui l'utilise*/
+
+void MINUTERIE_init(void);
+uint32_t MINUTERIE_maintenant(void);
+void MINUTERIE_armer(minuterie_t *, uint32_t, uint32_t, callback_fun_t);
+void MINUTERIE_annuler(minuterie_t *);
+bool_e MINUTERIE_armee(const minuterie_t *);
+
+#endif /* MINUTERIE_H_ */
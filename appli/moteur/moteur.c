@@ -1,121 +1,255 @@
-/**
- ******************************************************************************
- * @file 	moteur.c
- * @date    27-January-2020
- * @author  Gautier - Dufourmantelle
- * @brief   Fonction associe aux moteurs
- ******************************************************************************
- */
-
-#include "macro_types.h"
-#include "stm32f1_motorDC.h"
-#include "systick.h"
-#include "config.h"
-#include "moteur.h"
-
-#define MOTEURD MOTOR1
-#define MOTEURG MOTOR2
-
-#define POWER_AVANT 100  /** @def Puissance des moteurs en marche avant (en %)*/
-#define POWER_ARRIERE 65 /** @def Puissance des moteurs en marche arrierre (en %)*/
-#define POWER_TOURNE 50  /** @def Puissance des moteurs en marche quand la voiture tourne (en %)*/
-
-/**
- * @brief Fonction permettant d'initialiser nos deux moteurs
- */
-void MOTEUR_init(void)
-{
-	MOTOR_init(2);
-}
-/**
- * @brief Fonction permettant de tester le fonctionnment des moteurs suivant une sequence :
- * 		- Avant
- * 		- Droite
- * 		- Gauche
- * 		- Arrierre
- * 		- Arret
- * @pre 	Il faut avoir active les test dans le main
- */
-void MOTEUR_process_test(void)
-{
-	static bool_e launch = FALSE;
-	static uint32_t timer = 0;
-
-	timer++;
-
-	if (!launch && timer < 2)
-	{
-		MOTOR_set_duty(POWER_AVANT, MOTEURD);
-		MOTOR_set_duty(POWER_AVANT, MOTEURG);
-		launch = TRUE;
-	}
-	else if (launch && timer >= 1000 && timer < 2000)
-	{
-		MOTOR_set_duty(-POWER_TOURNE, MOTEURG);
-		MOTOR_set_duty(POWER_TOURNE, MOTEURD);
-		launch = FALSE;
-	}
-	else if (!launch && timer >= 2000 && timer < 3000)
-	{
-		MOTOR_set_duty(-POWER_TOURNE, MOTEURD);
-		MOTOR_set_duty(POWER_TOURNE, MOTEURG);
-		launch = TRUE;
-	}
-	else if (launch && timer >= 3000 && timer < 4000)
-	{
-		MOTOR_set_duty(-POWER_ARRIERE, MOTEURG);
-		MOTOR_set_duty(-POWER_ARRIERE, MOTEURD);
-		launch = FALSE;
-	}
-	else if (timer >= 4000)
-	{
-		MOTOR_set_duty(0, MOTEURD);
-		MOTOR_set_duty(0, MOTEURG);
-		Systick_remove_callback_function(&MOTEUR_process_test);
-	}
-}
-
-/**
- * @brief Fonction mettant les moteurs en marche avant
- */
-void marcheAvant(void)
-{
-	MOTOR_set_duty(POWER_AVANT, MOTEURD);
-	MOTOR_set_duty(POWER_AVANT, MOTEURG);
-}
-
-/**
- * @brief Fonction mettant les moteurs en marche arriere
- */
-void marcheArriere(void)
-{
-	MOTOR_set_duty(-POWER_ARRIERE, MOTEURD);
-	MOTOR_set_duty(-POWER_ARRIERE, MOTEURG);
-}
-
-/**
- * @brief Fonction mettant les moteurs en roue libre (non alimente)
- */
-void arret(void)
-{
-	MOTOR_set_duty(0, MOTEURD);
-	MOTOR_set_duty(0, MOTEURG);
-}
-
-/**
- * @brief Fonction mettant les moteurs en opposition pour tourner a droite
- */
-void tourneDroite(void)
-{
-	MOTOR_set_duty(-POWER_TOURNE, MOTEURD);
-	MOTOR_set_duty(POWER_TOURNE, MOTEURG);
-}
-
-/**
- * @brief Fonction mettant les moteurs en opposition pour tourner a gauche
- */
-void tourneGauche(void)
-{
-	MOTOR_set_duty(POWER_TOURNE, MOTEURD);
-	MOTOR_set_duty(-POWER_TOURNE, MOTEURG);
-}
+/**
+ ******************************************************************************
+ * @file 	moteur.c
+ * @date    27-January-2020
+ * @author  Gautier - Dufourmantelle
+ * @brief   Fonction associe aux moteurs : rampe d'acceleration en virgule fixe et
+ * 			mise a jour simultanee des deux canaux PWM
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "stm32f1_motorDC.h"
+#include "registre/registre.h"
+#include "config.h"
+#include "moteur.h"
+
+#define MOTEURD MOTOR1
+#define MOTEURG MOTOR2
+#define TIM_MOTEURS TIM1 /** @def Timer portant les PWM des deux moteurs (canaux 1 et 2)*/
+
+#define POWER_AVANT 100  /** @def Puissance des moteurs en marche avant (en %)*/
+#define POWER_ARRIERE 65 /** @def Puissance des moteurs en marche arrierre (en %)*/
+#define POWER_TOURNE 50  /** @def Puissance des moteurs en marche quand la voiture tourne (en %)*/
+
+#define ACCELERATION 400   /** @def Variation maximale du rapport cyclique quand une roue prend de la vitesse (en %/s)*/
+#define DECELERATION 10000 /** @def Variation maximale quand une roue ralentit (en %/s) : baisser le rapport cyclique
+									ne tire pas de courant, la rampe reste courte pour ne pas retarder l'arret devant un obstacle*/
+
+#define VIRGULE 8 /** @def Rapports cycliques en virgule fixe Q8 : 100 % vaut 25600*/
+
+typedef struct
+{
+	int16_t cible;	  //rapport cyclique demande (Q8)
+	int16_t actuel;	  //rapport cyclique de la rampe (Q8)
+	int16_t applique; //dernier rapport cyclique ecrit dans le timer (en %)
+} roue_t;
+
+static roue_t roues[2]; //indexees par MOTEURD et MOTEURG
+static volatile int16_t pasAcceleration = (ACCELERATION << VIRGULE) / 1000;
+static volatile int16_t pasDeceleration = (DECELERATION << VIRGULE) / 1000;
+
+static void MOTEUR_process_ms(void);
+static bool_e rampe(roue_t *);
+static void consigne(int16_t, int16_t);
+
+/**
+ * @brief Fonction permettant d'initialiser nos deux moteurs
+ * @pre 	A appeler apres REGISTRE_init : la rampe occupe une place du registre, active seulement pendant les transitions
+ */
+void MOTEUR_init(void)
+{
+	MOTOR_init(2);
+	//Les CCR sont precharges : une valeur ecrite n'est prise en compte qu'a l'evenement de mise a jour suivant
+	TIM_MOTEURS->CCMR1 |= TIM_CCMR1_OC1PE | TIM_CCMR1_OC2PE;
+	REGISTRE_reserver(&MOTEUR_process_ms, "MOTEUR_process_ms", FALSE);
+}
+
+/**
+ * @brief Regle les limites de la rampe
+ * @param acceleration : variation maximale quand une roue prend de la vitesse (en %/s, au moins 1)
+ * @param deceleration : variation maximale quand une roue ralentit (en %/s, au moins 1)
+ */
+void MOTEUR_acceleration(uint16_t acceleration, uint16_t deceleration)
+{
+	int32_t a = ((int32_t)acceleration << VIRGULE) / 1000;
+	int32_t d = ((int32_t)deceleration << VIRGULE) / 1000;
+
+	pasAcceleration = (a < 1) ? 1 : (a > INT16_MAX) ? INT16_MAX : a;
+	pasDeceleration = (d < 1) ? 1 : (d > INT16_MAX) ? INT16_MAX : d;
+}
+
+/**
+ * @brief Rapproche le rapport cyclique d'une roue de sa cible, d'un pas au plus.
+ * 		Une inversion de sens passe par 0 : freinage jusqu'a l'arret puis acceleration.
+ * @retval TRUE si la cible n'est pas encore atteinte
+ */
+static bool_e rampe(roue_t *r)
+{
+	int16_t but = r->cible;
+	int16_t pas = pasAcceleration;
+
+	if (r->actuel == r->cible)
+		return FALSE;
+	if ((r->actuel > 0 && but < r->actuel) || (r->actuel < 0 && but > r->actuel))
+	{
+		pas = pasDeceleration;
+		if ((r->actuel > 0 && but < 0) || (r->actuel < 0 && but > 0))
+			but = 0;
+	}
+	if (but > r->actuel)
+		r->actuel = (but - r->actuel > pas) ? r->actuel + pas : but;
+	else
+		r->actuel = (r->actuel - but > pas) ? r->actuel - pas : but;
+	return r->actuel != r->cible;
+}
+
+/**
+ * @brief Fait avancer la rampe des deux roues et ecrit les rapports cycliques qui ont change.
+ * 		Les deux canaux sont ecrits pendant que UDIS bloque les mises a jour du timer :
+ * 		leurs CCR precharges basculent ensemble au meme evenement de mise a jour.
+ */
+static void MOTEUR_process_ms(void)
+{
+	bool_e enCours = rampe(&roues[MOTEURD]);
+	enCours |= rampe(&roues[MOTEURG]);
+	int16_t d = roues[MOTEURD].actuel / (1 << VIRGULE);
+	int16_t g = roues[MOTEURG].actuel / (1 << VIRGULE);
+
+	if (d != roues[MOTEURD].applique || g != roues[MOTEURG].applique)
+	{
+		TIM_MOTEURS->CR1 |= TIM_CR1_UDIS;
+		MOTOR_set_duty(d, MOTEURD);
+		MOTOR_set_duty(g, MOTEURG);
+		TIM_MOTEURS->CR1 &= ~TIM_CR1_UDIS;
+		roues[MOTEURD].applique = d;
+		roues[MOTEURG].applique = g;
+	}
+	if (!enCours)
+		REGISTRE_desactiver(&MOTEUR_process_ms);
+}
+
+/**
+ * @brief Donne une nouvelle cible aux deux roues et lance la rampe
+ * @param droite : rapport cyclique vise pour la roue droite (en %, signe selon le sens)
+ * @param gauche : rapport cyclique vise pour la roue gauche (en %, signe selon le sens)
+ */
+static void consigne(int16_t droite, int16_t gauche)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	roues[MOTEURD].cible = droite << VIRGULE;
+	roues[MOTEURG].cible = gauche << VIRGULE;
+	if (!primask)
+		__enable_irq();
+	REGISTRE_activer(&MOTEUR_process_ms);
+}
+
+/**
+ * @brief Fonction permettant de tester le fonctionnment des moteurs suivant une sequence :
+ * 		- Avant
+ * 		- Droite
+ * 		- Gauche
+ * 		- Arrierre
+ * 		- Arret
+ * @pre 	Il faut avoir active les test dans le main
+ */
+void MOTEUR_process_test(void)
+{
+	static bool_e launch = FALSE;
+	static uint32_t timer = 0;
+
+	timer++;
+
+	if (!launch && timer < 2)
+	{
+		marcheAvant();
+		launch = TRUE;
+	}
+	else if (launch && timer >= 1000 && timer < 2000)
+	{
+		tourneGauche();
+		launch = FALSE;
+	}
+	else if (!launch && timer >= 2000 && timer < 3000)
+	{
+		tourneDroite();
+		launch = TRUE;
+	}
+	else if (launch && timer >= 3000 && timer < 4000)
+	{
+		marcheArriere();
+		launch = FALSE;
+	}
+	else if (timer >= 4000)
+	{
+		arret();
+		REGISTRE_desactiver(&MOTEUR_process_test);
+	}
+}
+
+/**
+ * @brief Fonction mettant les moteurs en marche avant
+ */
+void marcheAvant(void)
+{
+	consigne(POWER_AVANT, POWER_AVANT);
+}
+
+/**
+ * @brief Met les moteurs en marche avant a une puissance donnee, atteinte par la rampe
+ * @param puissance : rapport cyclique des deux roues (en %, au plus 100)
+ */
+void MOTEUR_avancer(uint8_t puissance)
+{
+	if (puissance > 100)
+		puissance = 100;
+	consigne(puissance, puissance);
+}
+
+/**
+ * @brief Donne a chaque roue sa propre consigne, atteinte par la rampe
+ * @param droite : rapport cyclique de la roue droite (en %, signe selon le sens, borne a +-100)
+ * @param gauche : rapport cyclique de la roue gauche
+ */
+void MOTEUR_commander(int8_t droite, int8_t gauche)
+{
+	droite = (droite > 100) ? 100 : (droite < -100) ? -100 : droite;
+	gauche = (gauche > 100) ? 100 : (gauche < -100) ? -100 : gauche;
+	consigne(droite, gauche);
+}
+
+/**
+ * @brief Rapports cycliques en vigueur, rampe comprise
+ * @param droite : recoit le rapport cyclique de la roue droite (en %, signe selon le sens)
+ * @param gauche : recoit celui de la roue gauche
+ */
+void MOTEUR_get_rapports(int8_t *droite, int8_t *gauche)
+{
+	*droite = (int8_t)roues[MOTEURD].applique;
+	*gauche = (int8_t)roues[MOTEURG].applique;
+}
+
+/**
+ * @brief Fonction mettant les moteurs en marche arriere
+ */
+void marcheArriere(void)
+{
+	consigne(-POWER_ARRIERE, -POWER_ARRIERE);
+}
+
+/**
+ * @brief Fonction mettant les moteurs en roue libre (non alimente)
+ */
+void arret(void)
+{
+	consigne(0, 0);
+}
+
+/**
+ * @brief Fonction mettant les moteurs en opposition pour tourner a droite
+ */
+void tourneDroite(void)
+{
+	consigne(-POWER_TOURNE, POWER_TOURNE);
+}
+
+/**
+ * @brief Fonction mettant les moteurs en opposition pour tourner a gauche
+ */
+void tourneGauche(void)
+{
+	consigne(POWER_TOURNE, -POWER_TOURNE);
+}
@@ -1,21 +1,25 @@
-/**
- ******************************************************************************
- * @file 	moteur.h
- * @date    27-January-2020
- * @author  Gautier - Dufourmantelle
- ******************************************************************************
- */
-
-#ifndef MOTEUR_H_
-#define MOTEUR_H_
-
-
-void MOTEUR_process_test(void);
-void marcheAvant(void);
-void marcheArriere(void);
-void arret(void);
-void tourneDroite(void);
-void tourneGauche(void);
-void MOTEUR_init(void);
-
-#endif /* MOTEUR_H_ */
+/**
+ ******************************************************************************
+ * @file 	moteur.h
+ * @date    27-January-2020
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef MOTEUR_H_
+#define MOTEUR_H_
+
+
+void MOTEUR_process_test(void);
+void marcheAvant(void);
+void marcheArriere(void);
+void arret(void);
+void tourneDroite(void);
+void tourneGauche(void);
+void MOTEUR_init(void);
+void MOTEUR_acceleration(uint16_t, uint16_t);
+void MOTEUR_avancer(uint8_t);
+void MOTEUR_commander(int8_t, int8_t);
+void MOTEUR_get_rapports(int8_t *, int8_t *);
+
+#endif /* MOTEUR_H_ */
@@ -0,0 +1,146 @@
+/**
+ ******************************************************************************
+ * @file 	mur.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Suivi de mur par un correcteur PD en virgule fixe : l'erreur est l'ecart
+ * 			entre la distance laterale du capteur du cote suivi et la consigne, sa
+ * 			derivee la vitesse d'eloignement du mur estimee par le capteur. La correction
+ * 			est retranchee a une roue et ajoutee a l'autre a chaque pas de controle, la
+ * 			voiture longe le mur sans s'arreter. Un mur perdu de vue est recherche en spirale
+ * 			de son cote : l'arc serre qui contourne un angle sortant s'ouvre peu a peu jusqu'a
+ * 			la ligne droite, qui finit par amener un mur a portee. Un obstacle avant fait
+ * 			tourner du cote oppose, ce qui place le mur trouve de face du cote suivi.
+ * 			Tout est en entiers, le calcul est a temps constant.
+ ******************************************************************************
+ */
+
+#include "macro_types.h"
+#include "stm32f1xx_hal.h"
+#include "capteur/capteur.h"
+#include "comportement/comportement.h"
+#include "mur.h"
+
+#define KP 24			  /** @def Gain proportionnel : ecart entre les roues par mm d'erreur (en %/256)*/
+#define KD 24			  /** @def Gain derive : ecart entre les roues par mm/s d'eloignement (en %/256)*/
+#define DERIVEE_MAX 600	  /** @def Vitesse d'eloignement prise en compte au plus, un saut de releve n'est pas une vitesse (en mm/s)*/
+#define ERREUR_MAX 200	  /** @def Erreur prise en compte au plus : au dela la voiture rejoindrait le mur de face (en mm)*/
+#define RECHERCHE 40	  /** @def Ecart entre les roues vers le cote suivi juste apres la perte du mur (en %)*/
+#define ELARGISSEMENT 10  /** @def Pas de controle au bout desquels l'ecart de recherche est divise par deux, puis par trois...*/
+#define PORTEE_AVANT 1000 /** @def Distance au dela de laquelle un obstacle avant ne fait pas tourner (en mm)*/
+#define GAIN_AVANT 100	  /** @def Ecart entre les roues pour un obstacle avant au contact (en %)*/
+#define ECART_MAX 100	  /** @def Ecart maximal entre les roues : la roue interieure s'arrete au pire (en %)*/
+
+static uint8_t capteurAvant, capteurCote;
+static int8_t sens = MUR_DROITE; //cote suivi : ecart a donner pour tourner vers le mur, au signe pres
+static uint16_t consigne;		 //distance au mur a tenir, mesuree par le capteur lateral (en mm)
+static bool_e murVu = FALSE;	 //le mur etait en vue au pas precedent
+static uint16_t perdu = 0;		 //pas de controle depuis la derniere vue du mur
+static uint64_t coutTotal = 0;
+static stat_mur_t stat;
+
+/**
+ * @brief Associe le suivi de mur a ses capteurs
+ * @param avant : identifiant du capteur avant
+ * @param cote : identifiant du capteur lateral du cote suivi
+ * @param s : MUR_DROITE ou MUR_GAUCHE
+ * @param c : distance au mur a tenir (en mm)
+ */
+void MUR_init(uint8_t avant, uint8_t cote, int8_t s, uint16_t c)
+{
+	capteurAvant = avant;
+	capteurCote = cote;
+	sens = s;
+	consigne = c;
+	murVu = FALSE;
+	perdu = 0;
+	coutTotal = 0;
+	stat = (stat_mur_t){0};
+}
+
+/**
+ * @brief Commande des roues d'apres la distance au mur suivi et la distance avant
+ * @param lateral : distance au mur du cote suivi (en mm), MUR_PORTEE s'il n'est pas vu
+ * @param eloignement : vitesse a laquelle la voiture s'eloigne du mur (en mm/s)
+ * @param avant : distance de l'obstacle avant (en mm)
+ * @param puissance : vitesse d'avance voulue (en %)
+ * @param pasPerdu : pas de controle depuis la derniere vue du mur, ouvre l'arc de recherche
+ * @retval la commande des roues, jamais en marche arriere
+ */
+commande_t MUR_calculer(uint16_t lateral, int16_t eloignement, uint16_t avant, uint8_t puissance, uint16_t pasPerdu)
+{
+	int32_t ecart; //positif : la voiture tourne a gauche
+	int32_t erreur, d;
+
+	if (lateral >= MUR_PORTEE)
+	{ //Spirale : le rayon de l'arc croit avec le temps passe sans mur, au lieu de tourner en rond loin de tout
+		ecart = sens * ((RECHERCHE * ELARGISSEMENT) / (ELARGISSEMENT + (int32_t)pasPerdu));
+	}
+	else
+	{
+		//Trop loin du mur, ou s'en eloignant : la voiture tourne vers lui
+		erreur = (int32_t)lateral - consigne;
+		erreur = (erreur > ERREUR_MAX) ? ERREUR_MAX : (erreur < -ERREUR_MAX) ? -ERREUR_MAX : erreur;
+		d = (eloignement > DERIVEE_MAX) ? DERIVEE_MAX : (eloignement < -DERIVEE_MAX) ? -DERIVEE_MAX : eloignement;
+		ecart = (sens * (KP * erreur + KD * d)) >> 8;
+	}
+	if (avant < PORTEE_AVANT)
+	{
+		//Repulsion quadratique comme celle du champ : un coin rentrant se prend en tournant du cote oppose au mur
+		int32_t proche = ((int32_t)(PORTEE_AVANT - avant) << 8) / PORTEE_AVANT;
+		ecart -= sens * ((GAIN_AVANT * ((proche * proche) >> 8)) >> 8);
+	}
+	if (ecart > ECART_MAX)
+		ecart = ECART_MAX;
+	else if (ecart < -ECART_MAX)
+		ecart = -ECART_MAX;
+
+	return COMPORTEMENT_repartir(puissance, ecart);
+}
+
+/**
+ * @brief Commande des roues d'apres les derniers releves du capteur lateral suivi et du capteur avant
+ * @param puissance : vitesse d'avance voulue (en %), typiquement celle du regulateur de croisiere
+ */
+commande_t MUR_commande(uint8_t puissance)
+{
+	uint32_t cycles = DWT->CYCCNT;
+	uint16_t lateral = CAPTEUR_get_distance(capteurCote, MUR_PORTEE);
+	commande_t c;
+
+	//Le rapprochement du mur estime par le capteur est l'oppose de la derivee de l'erreur
+	c = MUR_calculer(lateral, -CAPTEUR_get_approche(capteurCote).vitesse, CAPTEUR_get_distance(capteurAvant, MUR_PORTEE), puissance, perdu);
+	stat.pas++;
+	if (lateral >= MUR_PORTEE)
+	{
+		stat.perdu++;
+		if (murVu)
+			stat.pertes++;
+		if (perdu < UINT16_MAX)
+			perdu++;
+	}
+	else
+		perdu = 0;
+	murVu = (lateral < MUR_PORTEE);
+	cycles = DWT->CYCCNT - cycles;
+	coutTotal += cycles;
+	stat.moy = (uint32_t)(coutTotal / stat.pas);
+	if (cycles > stat.max)
+		stat.max = cycles;
+	return c;
+}
+
+/**
+ * @param s : recoit le cote suivi, MUR_DROITE ou MUR_GAUCHE
+ * @retval la distance au mur a tenir (en mm)
+ */
+uint16_t MUR_get_consigne(int8_t *s)
+{
+	*s = sens;
+	return consigne;
+}
+
+stat_mur_t MUR_get_stat(void)
+{
+	return stat;
+}
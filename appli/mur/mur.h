@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file 	mur.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef MUR_MUR_H_
+#define MUR_MUR_H_
+
+#define MUR_DROITE (-1)	 /** @def Mur suivi a droite de la voiture*/
+#define MUR_GAUCHE 1	 /** @def Mur suivi a gauche de la voiture*/
+#define MUR_PORTEE 1200	 /** @def Distance laterale au dela de laquelle le mur est perdu de vue (en mm)*/
+
+typedef struct
+{
+	uint32_t pas;	 //commandes calculees
+	uint32_t perdu;	 //commandes calculees sans mur en vue
+	uint32_t pertes; //passages du mur en vue au mur perdu
+	uint32_t moy;	 //cout moyen d'une commande (en cycles)
+	uint32_t max;
+} stat_mur_t;		 /** @struct Compteurs du suivi de mur*/
+
+void MUR_init(uint8_t, uint8_t, int8_t, uint16_t);
+commande_t MUR_calculer(uint16_t, int16_t, uint16_t, uint8_t, uint16_t);
+commande_t MUR_commande(uint8_t);
+uint16_t MUR_get_consigne(int8_t *);
+stat_mur_t MUR_get_stat(void);
+
+#endif /* MUR_MUR_H_ */
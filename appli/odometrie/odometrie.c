@@ -0,0 +1,148 @@
+/**
+ ******************************************************************************
+ * @file 	odometrie.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Estimation de la pose (x, y, cap) d'une voiture a deux roues differentielles
+ * 			par integration des rapports cycliques en vigueur, a la cadence de controle.
+ * 			La voiture n'a pas de codeurs : la vitesse d'une roue est supposee proportionnelle
+ * 			a son rapport cyclique, les constantes viennent de l'etalonnage :
+ * 			- vitesse : ligne droite a 100 % chronometree sur une distance connue,
+ * 			- correction : derive laterale sur cette ligne droite, reportee sur la roue droite,
+ * 			- voie : nombre de tours mesure apres une rotation sur place de duree connue.
+ * 			Positions en mm Q8, cap en angle binaire : le debordement d'un tour est naturel.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "moteur/moteur.h"
+#include "odometrie.h"
+
+#define VITESSE_DEFAUT 800 /** @def Vitesse d'une roue a 100 % de rapport cyclique (en mm/s)*/
+#define VOIE_DEFAUT 150	   /** @def Ecart entre les points de contact des deux roues (en mm)*/
+#define RADIAN 10430	   /** @def Angle binaire d'un radian (65536 / 2 pi)*/
+#define VIRGULE 8		   /** @def Positions en virgule fixe Q8*/
+
+static int32_t x, y;			  //position (en mm Q8)
+static uint16_t cap;			  //angle binaire
+static int64_t resteCap;		  //reste de la division du pas de cap, reporte au pas suivant
+static uint32_t parcours;		  //distance parcourue par le centre de la voiture, toutes directions (en mm Q8)
+static int32_t kDroite, kGauche;  //vitesse de chaque roue par % de rapport cyclique (en mm/s Q16, le Q8 arrondit trop la correction)
+static int32_t voie = VOIE_DEFAUT << VIRGULE;
+static uint32_t dernier;		  //date du pas precedent (en ms)
+static int8_t precedentD, precedentG; //rapports cycliques lus au pas precedent
+
+//Quart d'onde du sinus en Q15, 64 intervalles
+static const int16_t quartSinus[65] = {
+	0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+	12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+	23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+	30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+	32767};
+
+/**
+ * @brief Sinus d'un angle binaire, par interpolation lineaire dans le quart d'onde, partage avec la grille
+ * @retval le sinus en Q15
+ */
+int32_t ODOMETRIE_sinus(uint16_t angle)
+{
+	uint16_t a = angle & 0x3FFF; //position dans le quart
+	uint8_t i;
+	int32_t s;
+
+	if (angle & 0x4000)
+		a = 0x4000 - a; //deuxieme et quatrieme quarts : symetrie
+	i = a >> 8;
+	s = (i == 64) ? quartSinus[64] : quartSinus[i] + (((quartSinus[i + 1] - quartSinus[i]) * (int32_t)(a & 0xFF)) >> 8);
+	return (angle & 0x8000) ? -s : s;
+}
+
+/**
+ * @brief Remet la pose a l'origine et prend l'etalonnage par defaut
+ */
+void ODOMETRIE_init(void)
+{
+	x = y = 0;
+	cap = 0;
+	resteCap = 0;
+	parcours = 0;
+	precedentD = precedentG = 0;
+	ODOMETRIE_etalonner(VITESSE_DEFAUT, VOIE_DEFAUT, 0);
+	dernier = MINUTERIE_maintenant();
+}
+
+/**
+ * @brief Regle les constantes d'etalonnage
+ * @param vitesse : vitesse d'une roue a 100 % de rapport cyclique (en mm/s)
+ * @param voieMm : ecart effectif entre les roues, glissement en rotation compris (en mm, non nul)
+ * @param correction : ecart de vitesse de la roue droite par rapport a la gauche (en pour mille)
+ */
+void ODOMETRIE_etalonner(uint16_t vitesse, uint16_t voieMm, int16_t correction)
+{
+	kGauche = ((int32_t)vitesse << 16) / 100;
+	kDroite = (int32_t)(((int64_t)vitesse * (1000 + correction) << 16) / 100000);
+	voie = (voieMm ? voieMm : VOIE_DEFAUT) << VIRGULE;
+}
+
+/**
+ * @brief Integre un mouvement a rapports cycliques constants : arc de cercle approche par sa corde
+ * 			dans la direction du cap a mi-parcours
+ * @param droite : rapport cyclique de la roue droite (en %, signe selon le sens)
+ * @param gauche : rapport cyclique de la roue gauche
+ * @param duree : duree du mouvement (en ms, au plus 1000)
+ */
+void ODOMETRIE_integrer(int8_t droite, int8_t gauche, uint16_t duree)
+{
+	int32_t dd = (int32_t)(((int64_t)droite * kDroite * duree / 1000) >> (16 - VIRGULE)); //chemin de chaque roue (en mm Q8)
+	int32_t dg = (int32_t)(((int64_t)gauche * kGauche * duree / 1000) >> (16 - VIRGULE));
+	int32_t ds = (dd + dg) / 2;
+	int32_t pas;
+	uint16_t milieu;
+
+	resteCap += (int64_t)(dd - dg) * RADIAN;
+	pas = (int32_t)(resteCap / voie);
+	resteCap -= (int64_t)pas * voie;
+	milieu = cap + pas / 2;
+	x += (int32_t)(((int64_t)ds * ODOMETRIE_sinus(milieu + 0x4000)) >> 15);
+	y += (int32_t)(((int64_t)ds * ODOMETRIE_sinus(milieu)) >> 15);
+	cap += pas;
+	parcours += (ds < 0) ? -ds : ds;
+}
+
+/**
+ * @brief Pas de l'estimateur, a appeler a la cadence de controle : les rapports cycliques sont
+ * 			supposes varier lineairement depuis le pas precedent
+ */
+void ODOMETRIE_pas(void)
+{
+	uint32_t maintenant = MINUTERIE_maintenant();
+	uint32_t duree = maintenant - dernier;
+	int8_t d, g;
+
+	MOTEUR_get_rapports(&d, &g);
+	if (duree > 2000)
+		duree = 2000; //boucle principale restee bloquee : l'ecart est de toute facon perdu
+	ODOMETRIE_integrer(precedentD, precedentG, (uint16_t)(duree / 2));
+	ODOMETRIE_integrer(d, g, (uint16_t)(duree - duree / 2));
+	precedentD = d;
+	precedentG = g;
+	dernier = maintenant;
+}
+
+/**
+ * @retval la pose estimee, arrondie au mm
+ */
+pose_t ODOMETRIE_get_pose(void)
+{
+	return (pose_t){(x + (1 << (VIRGULE - 1))) >> VIRGULE, (y + (1 << (VIRGULE - 1))) >> VIRGULE, (int16_t)cap};
+}
+
+/**
+ * @retval la distance parcourue depuis l'init, marches avant et arriere cumulees (en mm)
+ */
+uint32_t ODOMETRIE_get_parcours(void)
+{
+	return parcours >> VIRGULE;
+}
@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file 	odometrie.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef ODOMETRIE_ODOMETRIE_H_
+#define ODOMETRIE_ODOMETRIE_H_
+
+#define ODOMETRIE_DEMI_TOUR 32768 /** @def Cap d'un demi-tour : les caps sont des angles binaires, 65536 pour un tour*/
+#define ODOMETRIE_DEGRES(d) ((int16_t)((int32_t)(d) * ODOMETRIE_DEMI_TOUR / 180)) /** @def Conversion d'un angle en degres (-179 a 179) en angle binaire*/
+
+typedef struct
+{
+	int32_t x;	 //position dans le repere de depart, x vers l'avant initial (en mm)
+	int32_t y;	 //y vers la gauche initiale (en mm)
+	int16_t cap; //angle binaire depuis la direction de depart, positif a gauche
+} pose_t;		 /** @struct Pose estimee de la voiture*/
+
+void ODOMETRIE_init(void);
+void ODOMETRIE_etalonner(uint16_t, uint16_t, int16_t);
+void ODOMETRIE_integrer(int8_t, int8_t, uint16_t);
+void ODOMETRIE_pas(void);
+pose_t ODOMETRIE_get_pose(void);
+uint32_t ODOMETRIE_get_parcours(void);
+int32_t ODOMETRIE_sinus(uint16_t);
+
+#endif /* ODOMETRIE_ODOMETRIE_H_ */
@@ -0,0 +1,244 @@
+/**
+ ******************************************************************************
+ * @file 	registre.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Registre des traitements executes chaque ms sous interruption Systick.
+ * 			Chaque module reserve ses places a l'initialisation ; ensuite la liste ne change plus,
+ * 			les transitions ne font que basculer un bit du masque d'activation.
+ * 			La duree de chaque appel et de chaque tick complet est mesuree avec le compteur de cycles DWT.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "systick.h"
+#include "journal/journal.h"
+#include "registre.h"
+
+#define CYCLES_PAR_TICK (REGISTRE_CYCLES_PAR_US * 1000UL) /** @def Budget d'un tick de 1 ms (en cycles)*/
+
+typedef struct
+{
+	uint32_t nb;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+} mesure_t; /** @struct Accumulateur de durees, ecrit uniquement sous interruption*/
+
+typedef struct
+{
+	callback_fun_t callback;
+	const char *nom;
+	mesure_t mesure;
+} place_t; /** @struct Place du registre*/
+
+static place_t places[REGISTRE_NB_PLACES];
+static uint8_t nbPlaces = 0;
+static volatile uint32_t actives = 0; //bit i : la place i est appelee a chaque tick
+static mesure_t mesureTick;
+static volatile uint32_t depassements = 0;
+
+static void REGISTRE_process_ms(void);
+static void mesurer(mesure_t *, uint32_t);
+static stat_registre_t lire(const mesure_t *);
+static uint8_t chercher(callback_fun_t);
+static void basculer(uint8_t, bool_e);
+
+static void mesurer(mesure_t *m, uint32_t duree)
+{
+	if (!m->nb || duree < m->min)
+		m->min = duree;
+	if (duree > m->max)
+		m->max = duree;
+	m->total += duree;
+	m->nb++;
+}
+
+/**
+ * @brief Copie coherente d'un accumulateur, le Systick etant masque pendant la lecture
+ */
+static stat_registre_t lire(const mesure_t *m)
+{
+	stat_registre_t stat;
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	stat.nb = m->nb;
+	stat.min = m->min;
+	stat.max = m->max;
+	stat.moy = m->nb ? (uint32_t)(m->total / m->nb) : 0;
+	if (!primask)
+		__enable_irq();
+	return stat;
+}
+
+/**
+ * @brief Appelle les traitements actifs dans l'ordre de reservation et mesure leur duree
+ * @note  Seul callback Systick du logiciel
+ */
+static void REGISTRE_process_ms(void)
+{
+	uint32_t debutTick = DWT->CYCCNT;
+	uint32_t duree;
+
+	for (uint8_t i = 0; i < nbPlaces; i++)
+	{ //Le masque est relu a chaque place : un traitement peut en desactiver un autre, ou lui-meme
+		if (actives & (1UL << i))
+		{
+			uint32_t debut = DWT->CYCCNT;
+			(*places[i].callback)();
+			mesurer(&places[i].mesure, DWT->CYCCNT - debut);
+		}
+	}
+	duree = DWT->CYCCNT - debutTick;
+	mesurer(&mesureTick, duree);
+	if (duree > CYCLES_PAR_TICK)
+		depassements++;
+}
+
+/**
+ * @brief Installe le registre sur le Systick et demarre le compteur de cycles, a appeler avant tout autre module
+ */
+void REGISTRE_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	Systick_add_callback_function(&REGISTRE_process_ms);
+}
+
+/**
+ * @brief Reserve une place pour un traitement, uniquement pendant l'initialisation
+ * @param callback : traitement appele chaque ms
+ * @param nom : nom affiche par REGISTRE_afficher
+ * @param actif : TRUE pour que le traitement soit appele des le prochain tick
+ * @retval la place attribuee, REGISTRE_AUCUNE si le registre est plein
+ */
+uint8_t REGISTRE_reserver(callback_fun_t callback, const char *nom, bool_e actif)
+{
+	uint8_t place = chercher(callback);
+
+	if (place != REGISTRE_AUCUNE)
+		return place; //deja reserve, une seule place par traitement
+	if (nbPlaces >= REGISTRE_NB_PLACES)
+	{
+		JOURNAL_texte(nom);
+		JOURNAL_1(JOURNAL_REGISTRE_PLEIN, REGISTRE_NB_PLACES);
+		return REGISTRE_AUCUNE;
+	}
+	place = nbPlaces;
+	places[place].callback = callback;
+	places[place].nom = nom;
+	nbPlaces++; //publie la place une fois remplie, le Systick peut deja tourner
+	basculer(place, actif);
+	return place;
+}
+
+/**
+ * @retval la place d'un traitement, REGISTRE_AUCUNE s'il n'est pas reserve
+ */
+static uint8_t chercher(callback_fun_t callback)
+{
+	for (uint8_t i = 0; i < nbPlaces; i++)
+	{
+		if (places[i].callback == callback)
+			return i;
+	}
+	return REGISTRE_AUCUNE;
+}
+
+/**
+ * @brief Ecrit un bit du masque, sans lecture-modification-ecriture interruptible
+ */
+static void basculer(uint8_t place, bool_e actif)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if (actif)
+		actives |= 1UL << place;
+	else
+		actives &= ~(1UL << place);
+	if (!primask)
+		__enable_irq();
+}
+
+/**
+ * @brief Active un traitement reserve, sans effet s'il est deja actif
+ * @retval FALSE si le traitement n'a pas de place
+ * @note  Appelable depuis la boucle principale comme depuis un traitement du registre
+ */
+bool_e REGISTRE_activer(callback_fun_t callback)
+{
+	uint8_t place = chercher(callback);
+
+	if (place == REGISTRE_AUCUNE)
+		return FALSE;
+	basculer(place, TRUE);
+	return TRUE;
+}
+
+/**
+ * @brief Desactive un traitement, qui garde sa place et ses statistiques
+ * @retval FALSE si le traitement n'a pas de place
+ */
+bool_e REGISTRE_desactiver(callback_fun_t callback)
+{
+	uint8_t place = chercher(callback);
+
+	if (place == REGISTRE_AUCUNE)
+		return FALSE;
+	basculer(place, FALSE);
+	return TRUE;
+}
+
+uint8_t REGISTRE_get_nb(void)
+{
+	return nbPlaces;
+}
+
+const char *REGISTRE_get_nom(uint8_t place)
+{
+	return (place < nbPlaces) ? places[place].nom : "";
+}
+
+/**
+ * @brief Cout d'execution d'un traitement
+ * @param place : place du traitement, de 0 a REGISTRE_get_nb() - 1
+ * @retval nombre d'appels et duree min, moyenne et max (en cycles)
+ */
+stat_registre_t REGISTRE_get_stat(uint8_t place)
+{
+	stat_registre_t vide = {0, 0, 0, 0};
+	return (place < nbPlaces) ? lire(&places[place].mesure) : vide;
+}
+
+/**
+ * @brief Cout d'un tick complet, tous traitements actifs compris
+ */
+stat_registre_t REGISTRE_get_stat_tick(void)
+{
+	return lire(&mesureTick);
+}
+
+/**
+ * @retval le nombre de ticks dont le traitement a depasse 1 ms
+ */
+uint32_t REGISTRE_get_depassements(void)
+{
+	return depassements;
+}
+
+/**
+ * @brief Ecrit dans le journal le cout de chaque traitement et du tick complet (en us)
+ */
+void REGISTRE_afficher(void)
+{
+	for (uint8_t i = 0; i <= nbPlaces; i++)
+	{
+		stat_registre_t s = (i < nbPlaces) ? REGISTRE_get_stat(i) : REGISTRE_get_stat_tick();
+		JOURNAL_texte((i < nbPlaces) ? places[i].nom : "tick");
+		JOURNAL_4(JOURNAL_REGISTRE_PLACE, s.nb, s.min / REGISTRE_CYCLES_PAR_US, s.moy / REGISTRE_CYCLES_PAR_US, s.max / REGISTRE_CYCLES_PAR_US);
+	}
+	JOURNAL_1(JOURNAL_REGISTRE_DEPASSEMENTS, depassements);
+}
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file 	registre.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef REGISTRE_H_
+#define REGISTRE_H_
+
+#define REGISTRE_NB_PLACES 16			/** @def Nombre de callbacks pouvant etre reserves*/
+#define REGISTRE_CYCLES_PAR_US 72		/** @def Les durees sont donnees en cycles d'horloge a 72 MHz*/
+#define REGISTRE_AUCUNE 0xFF			/** @def Place rendue par REGISTRE_reserver quand le registre est plein*/
+
+typedef struct
+{
+	uint32_t nb;  //nombre d'appels mesures
+	uint32_t min; //duree minimale d'un appel (en cycles)
+	uint32_t moy;
+	uint32_t max;
+} stat_registre_t; /** @struct Cout d'execution sous interruption*/
+
+void REGISTRE_init(void);
+uint8_t REGISTRE_reserver(callback_fun_t, const char *, bool_e);
+bool_e REGISTRE_activer(callback_fun_t);
+bool_e REGISTRE_desactiver(callback_fun_t);
+uint8_t REGISTRE_get_nb(void);
+const char *REGISTRE_get_nom(uint8_t);
+stat_registre_t REGISTRE_get_stat(uint8_t);
+stat_registre_t REGISTRE_get_stat_tick(void);
+uint32_t REGISTRE_get_depassements(void);
+void REGISTRE_afficher(void);
+
+#endif /* REGISTRE_H_ */
@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * @file 	sequenceur.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Sequenceur de motifs : joue sur chaque canal (LED, HP) une table de pas (etat, duree)
+ * 			rangee en flash, en boucle ou une seule fois, depuis une unique place du registre Systick.
+ * @note	Les echeances sont des dates absolues de la base de temps : deux motifs lances
+ * 			dans la meme milliseconde changent de pas au meme tick, sans derive.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "minuterie/minuterie.h"
+#include "registre/registre.h"
+#include "sequenceur.h"
+
+typedef struct
+{
+	sortie_sequenceur_t sortie;
+	const motif_t *motif; //NULL : canal au repos
+	uint8_t pas;
+	uint32_t echeance;	  //date de fin du pas en cours (en ms)
+} canal_t;
+
+static canal_t canaux[SEQUENCEUR_NB_CANAUX];
+
+static void SEQUENCEUR_process_ms(void);
+static void entrer(canal_t *, uint8_t, uint32_t);
+static void arreter(canal_t *);
+
+/**
+ * @brief Debute un pas : la sortie prend son etat et l'echeance est calculee depuis la fin du pas precedent
+ */
+static void entrer(canal_t *c, uint8_t pas, uint32_t debut)
+{
+	c->pas = pas;
+	c->echeance = debut + c->motif->pas[pas].duree;
+	c->sortie(c->motif->pas[pas].etat);
+}
+
+static void arreter(canal_t *c)
+{
+	c->motif = NULL;
+	c->sortie(0);
+}
+
+/**
+ * @brief Avance les canaux dont le pas est echu, la place se desactive quand tous sont au repos
+ */
+static void SEQUENCEUR_process_ms(void)
+{
+	uint32_t maintenant = MINUTERIE_maintenant();
+	bool_e actif = FALSE;
+
+	for (uint8_t i = 0; i < SEQUENCEUR_NB_CANAUX; i++)
+	{
+		canal_t *c = &canaux[i];
+
+		if (c->motif == NULL)
+			continue;
+		//Comparaison signee : la base de temps peut deborder
+		if ((int32_t)(maintenant - c->echeance) >= 0)
+		{
+			if (c->pas + 1 < c->motif->nb)
+				entrer(c, c->pas + 1, c->echeance);
+			else if (c->motif->boucle)
+				entrer(c, 0, c->echeance);
+			else
+			{
+				arreter(c);
+				continue;
+			}
+		}
+		actif = TRUE;
+	}
+	if (!actif)
+		REGISTRE_desactiver(&SEQUENCEUR_process_ms);
+}
+
+/**
+ * @brief Reserve la place du sequenceur dans le registre, a appeler apres REGISTRE_init
+ */
+void SEQUENCEUR_init(void)
+{
+	REGISTRE_reserver(&SEQUENCEUR_process_ms, "SEQUENCEUR_process_ms", FALSE);
+}
+
+/**
+ * @brief Associe une sortie materielle a un canal
+ * @param canal : canal du sequenceur
+ * @param sortie : fonction appliquant un etat (0 : repos), appelee sous interruption a chaque changement de pas
+ */
+void SEQUENCEUR_canal(canal_sequenceur_e canal, sortie_sequenceur_t sortie)
+{
+	canaux[canal].sortie = sortie;
+	canaux[canal].motif = NULL;
+}
+
+/**
+ * @brief Joue un motif sur un canal, a partir de son premier pas, en remplacant le motif en cours
+ * @param canal : canal du sequenceur, dont la sortie a ete associee
+ * @param motif : motif a jouer
+ */
+void SEQUENCEUR_jouer(canal_sequenceur_e canal, const motif_t *motif)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	if (canaux[canal].sortie == NULL || motif->nb == 0)
+		return;
+	__disable_irq();
+	canaux[canal].motif = motif;
+	entrer(&canaux[canal], 0, MINUTERIE_maintenant());
+	if (!primask)
+		__enable_irq();
+	REGISTRE_activer(&SEQUENCEUR_process_ms);
+}
+
+/**
+ * @brief Interrompt le motif d'un canal et remet sa sortie au repos
+ */
+void SEQUENCEUR_arreter(canal_sequenceur_e canal)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	if (canaux[canal].sortie == NULL)
+		return;
+	__disable_irq();
+	arreter(&canaux[canal]);
+	if (!primask)
+		__enable_irq();
+}
@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file 	sequenceur.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef SEQUENCEUR_H_
+#define SEQUENCEUR_H_
+
+typedef enum
+{
+	SEQUENCEUR_LED = 0,
+	SEQUENCEUR_HP,
+	SEQUENCEUR_NB_CANAUX
+} canal_sequenceur_e; /** @enum Sorties pilotees par le sequenceur*/
+
+typedef struct
+{
+	uint16_t duree; //duree du pas (en ms)
+	uint8_t etat;	//etat de la sortie pendant le pas, 0 : repos
+} pas_t; /** @struct Pas d'un motif*/
+
+typedef struct
+{
+	const pas_t *pas;
+	uint8_t nb;
+	bool_e boucle; //FALSE : la sortie revient au repos apres le dernier pas
+} motif_t; /** @struct Motif lumineux ou sonore, a declarer const pour qu'il reste en flash*/
+
+typedef void (*sortie_sequenceur_t)(uint8_t etat);
+
+//SOS en morse (3 courts, 3 longs, 3 courts puis une pause), commun a la LED et au HP
+#define SEQUENCEUR_SOS(etat)                                               \
+	{                                                                      \
+		{250, (etat)}, {250, 0}, {250, (etat)}, {250, 0}, {250, (etat)}, {250, 0}, \
+		{500, (etat)}, {250, 0}, {500, (etat)}, {250, 0}, {500, (etat)}, {250, 0}, \
+		{250, (etat)}, {250, 0}, {250, (etat)}, {250, 0}, {250, (etat)}, {1250, 0} \
+	}
+
+#define SEQUENCEUR_MOTIF(tableau, boucle) {(tableau), sizeof(tableau) / sizeof((tableau)[0]), (boucle)} /** @def Initialiseur d'un motif_t a partir d'un tableau de pas*/
+
+void SEQUENCEUR_init(void);
+void SEQUENCEUR_canal(canal_sequenceur_e, sortie_sequenceur_t);
+void SEQUENCEUR_jouer(canal_sequenceur_e, const motif_t *);
+void SEQUENCEUR_arreter(canal_sequenceur_e);
+
+#endif /* SEQUENCEUR_H_ */
@@ -0,0 +1,227 @@
+/**
+ ******************************************************************************
+ * @file 	tache.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Ordonnanceur cooperatif de la boucle principale. Chaque tache est reveillee
+ * 			par ses evenements, par sa periode ou par l'echeance qu'elle s'est donnee ;
+ * 			a chaque passage, les taches pretes sont appelees par priorite decroissante
+ * 			et rendent la main d'elles-memes (voir les macros de tache.h). Une seule
+ * 			minuterie reveille la boucle a la plus proche echeance : entre deux
+ * 			passages le processeur dort dans EVENEMENT_attendre.
+ * 			La duree de chaque appel et le surcout de l'ordonnanceur sont mesures avec
+ * 			le compteur de cycles DWT.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "macro_types.h"
+#include "evenement/evenement.h"
+#include "minuterie/minuterie.h"
+#include "journal/journal.h"
+#include "registre/registre.h"
+#include "tache.h"
+
+static tache_t *taches = NULL; //par priorite decroissante, dans l'ordre de creation a priorite egale
+static minuterie_t reveil;
+static uint64_t surcout = 0;   //cycles des passages hors corps des taches
+static stat_ordonnanceur_t stat;
+
+static void reveiller(void);
+static void programmer(void);
+static tache_t *tache(uint8_t);
+
+void TACHE_init(void)
+{
+	MINUTERIE_annuler(&reveil);
+	taches = NULL;
+	surcout = 0;
+	stat = (stat_ordonnanceur_t){0};
+}
+
+/**
+ * @brief Cree une tache et l'insere a son rang de priorite
+ * @param t : tache, allouee par l'appelant et qui doit survivre a l'ordonnanceur
+ * @param nom : nom affiche par TACHE_afficher
+ * @param corps : fonction appelee a chaque reveil
+ * @param periode : periode de reveil (en ms), 0 si la tache n'est reveillee que par ses evenements
+ * @param evenements : masque des evenements qui la reveillent (EVENEMENT_MASQUE), 0 pour aucun
+ * @param priorite : rang d'appel parmi les taches pretes, la plus grande d'abord
+ * @param active : TRUE pour que la tache soit appelee des le prochain passage
+ */
+void TACHE_creer(tache_t *t, const char *nom, corps_tache_t corps, uint32_t periode, uint32_t evenements, uint8_t priorite, bool_e active)
+{
+	tache_t **lien = &taches;
+
+	*t = (tache_t){.nom = nom, .corps = corps, .periode = periode, .evenements = evenements, .priorite = priorite};
+	while (*lien && (*lien)->priorite >= priorite)
+		lien = &(*lien)->suivante;
+	t->suivante = *lien;
+	*lien = t;
+	if (active)
+		TACHE_activer(t);
+}
+
+/**
+ * @brief Active une tache, qui repart du debut de son corps au prochain passage
+ */
+void TACHE_activer(tache_t *t)
+{
+	t->ligne = 0;
+	t->recus = 0;
+	t->active = TRUE;
+	TACHE_echeance(t, 0);
+}
+
+/**
+ * @brief Fixe le prochain reveil d'une tache, il remplace celui de sa periode
+ * @param delai : delai avant le reveil (en ms), 0 pour le prochain passage
+ */
+void TACHE_echeance(tache_t *t, uint32_t delai)
+{
+	t->echeance = MINUTERIE_maintenant() + delai;
+	t->datee = TRUE;
+	if (delai == 0)
+		EVENEMENT_poster(EVENEMENT_TACHE);
+}
+
+/**
+ * @brief Passage de l'ordonnanceur : appelle les taches pretes par priorite decroissante, puis programme le reveil suivant
+ * @param masque : evenements rendus par EVENEMENT_attendre
+ */
+void TACHE_ordonnancer(uint32_t masque)
+{
+	uint32_t debut = DWT->CYCCNT;
+	uint32_t corps = 0; //cycles passes dans les corps pendant ce passage
+	uint32_t maintenant = MINUTERIE_maintenant();
+
+	for (tache_t *t = taches; t; t = t->suivante)
+	{
+		bool_e echue = t->datee && (int32_t)(maintenant - t->echeance) >= 0;
+		uint32_t echeance = t->echeance;
+		uint32_t cycles;
+
+		if (!t->active)
+			continue;
+		t->recus |= masque & t->evenements;
+		if (!echue && !t->recus)
+			continue;
+		if (echue)
+		{
+			t->datee = FALSE;
+			if (maintenant - echeance > t->stat.retardMax)
+				t->stat.retardMax = maintenant - echeance;
+		}
+		cycles = DWT->CYCCNT;
+		if (t->corps(t) == TACHE_TERMINEE)
+			t->active = FALSE;
+		cycles = DWT->CYCCNT - cycles;
+		corps += cycles;
+		t->recus = 0;
+		t->cycles += cycles;
+		t->stat.appels++;
+		t->stat.moy = (uint32_t)(t->cycles / t->stat.appels);
+		if (cycles > t->stat.max)
+			t->stat.max = cycles;
+		stat.commutations++;
+		//Le reveil periodique suit l'echeance precedente pour ne pas deriver, sauf si le corps s'en est donne une
+		if (echue && t->periode && !t->datee)
+		{
+			t->echeance = echeance + t->periode;
+			t->datee = TRUE;
+			if ((int32_t)(maintenant - t->echeance) >= 0)
+				t->echeance = maintenant + t->periode; //trop en retard : les periodes manquees sont abandonnees
+		}
+		else if (t->periode && !t->datee)
+		{
+			t->echeance = maintenant + t->periode;
+			t->datee = TRUE;
+		}
+	}
+	programmer();
+	stat.passes++;
+	surcout += DWT->CYCCNT - debut - corps;
+	stat.moy = stat.commutations ? (uint32_t)(surcout / stat.commutations) : 0;
+}
+
+/**
+ * @brief Arme la minuterie de reveil sur la plus proche echeance des taches actives
+ */
+static void programmer(void)
+{
+	uint32_t maintenant = MINUTERIE_maintenant();
+	int32_t prochaine = INT32_MAX;
+
+	for (tache_t *t = taches; t; t = t->suivante)
+	{
+		if (t->active && t->datee && (int32_t)(t->echeance - maintenant) < prochaine)
+			prochaine = (int32_t)(t->echeance - maintenant);
+	}
+	if (prochaine == INT32_MAX)
+		MINUTERIE_annuler(&reveil);
+	else if (prochaine <= 0)
+		EVENEMENT_poster(EVENEMENT_TACHE);
+	else
+		MINUTERIE_armer(&reveil, (uint32_t)prochaine, 0, &reveiller);
+}
+
+/**
+ * @brief Callback de la minuterie de reveil, sous interruption Systick
+ */
+static void reveiller(void)
+{
+	EVENEMENT_poster(EVENEMENT_TACHE);
+}
+
+/**
+ * @retval la tache de rang donne dans l'ordre d'appel, NULL si elle n'existe pas
+ */
+static tache_t *tache(uint8_t rang)
+{
+	tache_t *t = taches;
+
+	while (t && rang--)
+		t = t->suivante;
+	return t;
+}
+
+uint8_t TACHE_get_nb(void)
+{
+	uint8_t nb = 0;
+
+	for (tache_t *t = taches; t; t = t->suivante)
+		nb++;
+	return nb;
+}
+
+const char *TACHE_get_nom(uint8_t rang)
+{
+	tache_t *t = tache(rang);
+
+	return t ? t->nom : NULL;
+}
+
+stat_tache_t TACHE_get_stat(uint8_t rang)
+{
+	tache_t *t = tache(rang);
+
+	return t ? t->stat : (stat_tache_t){0};
+}
+
+stat_ordonnanceur_t TACHE_get_stat_ordonnanceur(void)
+{
+	return stat;
+}
+
+/**
+ * @brief Journalise les compteurs de chaque tache et le surcout de l'ordonnanceur
+ */
+void TACHE_afficher(void)
+{
+	for (tache_t *t = taches; t; t = t->suivante)
+	{
+		JOURNAL_texte(t->nom);
+		JOURNAL_4(JOURNAL_TACHE, t->stat.appels, t->stat.moy / REGISTRE_CYCLES_PAR_US, t->stat.max / REGISTRE_CYCLES_PAR_US, t->stat.retardMax);
+	}
+	JOURNAL_3(JOURNAL_ORDONNANCEUR, stat.passes, stat.commutations, stat.moy);
+}
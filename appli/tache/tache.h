@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file 	tache.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ ******************************************************************************
+ */
+
+#ifndef TACHE_TACHE_H_
+#define TACHE_TACHE_H_
+
+typedef enum
+{
+	TACHE_EN_COURS = 0, //le corps a rendu la main, il reprendra a son point d'attente
+	TACHE_TERMINEE		//le corps est arrive a TACHE_FIN, la tache est desactivee
+} etat_tache_e;			/** @enum Retour du corps d'une tache*/
+
+typedef struct
+{
+	uint32_t appels;	//appels du corps
+	uint32_t moy;		//duree moyenne d'un appel (en cycles)
+	uint32_t max;
+	uint32_t retardMax; //plus grand retard d'un reveil sur son echeance (en ms)
+} stat_tache_t;			/** @struct Compteurs d'une tache*/
+
+typedef struct
+{
+	uint32_t passes;	   //passages de l'ordonnanceur
+	uint32_t commutations; //appels de corps de taches
+	uint32_t moy;		   //surcout moyen de l'ordonnanceur par commutation, corps exclus (en cycles)
+} stat_ordonnanceur_t;	   /** @struct Compteurs de l'ordonnanceur*/
+
+typedef struct tache_s tache_t;
+typedef etat_tache_e (*corps_tache_t)(tache_t *);
+
+struct tache_s
+{
+	struct tache_s *suivante;
+	const char *nom;
+	corps_tache_t corps;
+	uint32_t periode;	 //reveil periodique (en ms), 0 : la tache n'est reveillee que par ses evenements et TACHE_DORMIR
+	uint32_t evenements; //masque des evenements qui reveillent la tache (EVENEMENT_MASQUE)
+	uint8_t priorite;	 //les taches pretes sont appelees de la plus prioritaire a la moins prioritaire
+	bool_e active;
+	bool_e datee;		 //l'echeance est valide
+	uint32_t echeance;	 //date du prochain reveil (en ms)
+	uint32_t recus;		 //evenements recus depuis l'appel precedent, lisibles par le corps
+	uint16_t ligne;		 //point de reprise du corps, 0 au debut
+	uint64_t cycles;	 //duree cumulee des appels
+	stat_tache_t stat;
+}; /** @struct Tache cooperative, a allouer en statique par le module qui la cree*/
+
+/*
+ * Coroutines sans pile : le corps d'une tache est une fonction reappelee a chaque reveil, qui reprend
+ * au point ou elle avait rendu la main grace a un switch sur le numero de ligne. Les variables locales
+ * ne survivent pas a une attente : celles qui doivent durer sont statiques. Pas de switch dans un corps
+ * entre TACHE_DEBUT et TACHE_FIN, ni deux attentes sur une meme ligne.
+ */
+#define TACHE_DEBUT(t)     \
+	switch ((t)->ligne)    \
+	{                      \
+	case 0:
+#define TACHE_FIN(t) \
+	}                \
+	(t)->ligne = 0;  \
+	return TACHE_TERMINEE;
+/** @def Rend la main, le corps reprend ici au prochain reveil de la tache*/
+#define TACHE_CEDER(t)            \
+	do                            \
+	{                             \
+		(t)->ligne = __LINE__;    \
+		return TACHE_EN_COURS;    \
+	case __LINE__:;               \
+	} while (0)
+/** @def Rend la main tant que la condition est fausse, elle est reevaluee a chaque reveil.
+ * 		Le premier passage tombe sur la case de reprise : la condition est evaluee tout de suite*/
+#define TACHE_ATTENDRE_QUE(t, condition) \
+	do                                   \
+	{                                    \
+		(t)->ligne = __LINE__;           \
+		__attribute__((fallthrough));    \
+	case __LINE__:                       \
+		if (!(condition))                \
+			return TACHE_EN_COURS;       \
+	} while (0)
+/** @def Rend la main pour au moins ms millisecondes, l'ordonnanceur reveille la tache a l'echeance*/
+#define TACHE_DORMIR(t, ms)                                                                    \
+	do                                                                                         \
+	{                                                                                          \
+		TACHE_echeance((t), (ms));                                                             \
+		TACHE_ATTENDRE_QUE((t), (int32_t)(MINUTERIE_maintenant() - (t)->echeance) >= 0);       \
+	} while (0)
+
+void TACHE_init(void);
+void TACHE_creer(tache_t *, const char *, corps_tache_t, uint32_t, uint32_t, uint8_t, bool_e);
+void TACHE_activer(tache_t *);
+void TACHE_echeance(tache_t *, uint32_t);
+void TACHE_ordonnancer(uint32_t);
+uint8_t TACHE_get_nb(void);
+const char *TACHE_get_nom(uint8_t);
+stat_tache_t TACHE_get_stat(uint8_t);
+stat_ordonnanceur_t TACHE_get_stat_ordonnanceur(void);
+void TACHE_afficher(void);
+
+#endif /* TACHE_TACHE_H_ */
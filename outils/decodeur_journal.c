@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file 	decodeur_journal.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Decodeur hote du journal binaire emis sur l'UART2 (appli/journal/journal.c)
+ * @note	Compilation : gcc -std=gnu99 -Wall -Iappli outils/decodeur_journal.c -o decodeur_journal
+ * 			Usage : ./decodeur_journal [fichier], lit l'entree standard par defaut
+ * 			(capture du simulateur avec -j, ou port serie : ./decodeur_journal < /dev/ttyACM0).
+ ******************************************************************************
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "journal/journal_formats.h"
+
+#define DECODEUR_TEXTE(nom, texte) texte,
+
+static const char *const formats[] = {JOURNAL_FORMATS(DECODEUR_TEXTE)};
+
+#define NB_FORMATS (sizeof(formats) / sizeof(formats[0]))
+
+/**
+ * @brief Lit des octets, FALSE en fin de flux
+ */
+static int lire(FILE *f, uint8_t *octets, size_t taille)
+{
+	return fread(octets, 1, taille, f) == taille;
+}
+
+static uint32_t petit_boutiste(const uint8_t *octets)
+{
+	return octets[0] | (uint32_t)octets[1] << 8 | (uint32_t)octets[2] << 16 | (uint32_t)octets[3] << 24;
+}
+
+/**
+ * @brief Affiche un enregistrement, chaque argument avec le type de sa conversion :
+ * 			%d en entier signe 32 bits, %u et %x en non signe, %c en caractere
+ * @note  Les arguments voyagent tous en uint32_t : les passer tels quels a printf ferait
+ * 			lire un %d avec le mauvais type
+ */
+static void afficher(const char *format, const uint32_t *a)
+{
+	uint8_t n = 0;
+
+	for (const char *p = format; *p; p++)
+	{
+		if (*p != '%')
+		{
+			putchar(*p);
+			continue;
+		}
+		p++;
+		switch (*p)
+		{
+		case 'd':
+			printf("%" PRId32, (int32_t)a[n++]);
+			break;
+		case 'u':
+			printf("%" PRIu32, a[n++]);
+			break;
+		case 'x':
+			printf("%" PRIx32, a[n++]);
+			break;
+		case 'c':
+			putchar((int)(a[n++] & 0xFF));
+			break;
+		case '%':
+			putchar('%');
+			break;
+		default: //conversion interdite par journal_formats.h : recopiee telle quelle
+			putchar('%');
+			if (!*p)
+				return;
+			putchar(*p);
+			break;
+		}
+		if (n > 4)
+			return;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	FILE *f = stdin;
+	uint8_t entete[JOURNAL_ENTETE];
+	uint8_t corps[255];
+	uint32_t ignores = 0;
+	int ligneOuverte = 0; //un texte brut est complete par l'enregistrement suivant (nom + statistiques)
+	int c;
+
+	if (argc > 2)
+	{
+		fprintf(stderr, "usage : %s [fichier]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (argc == 2 && (f = fopen(argv[1], "rb")) == NULL)
+	{
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	while ((c = fgetc(f)) != EOF)
+	{
+		uint8_t format, nb;
+		uint32_t date, taille;
+
+		//Resynchronisation apres un octet perdu ou un debut de capture en cours d'emission
+		if (c != JOURNAL_SYNCHRO)
+		{
+			ignores++;
+			continue;
+		}
+		entete[0] = (uint8_t)c;
+		if (!lire(f, &entete[1], JOURNAL_ENTETE - 1))
+			break;
+		format = entete[1];
+		nb = entete[2];
+		date = petit_boutiste(&entete[3]);
+		if (format != JOURNAL_TEXTE && (format >= NB_FORMATS || nb > 4))
+		{
+			fprintf(stderr, "[%10" PRIu32 " ms] format inconnu %u (%u arguments), journal plus recent que le decodeur ?\n", date, format, nb);
+			ignores += JOURNAL_ENTETE;
+			continue;
+		}
+		taille = (format == JOURNAL_TEXTE) ? nb : 4U * nb;
+		if (!lire(f, corps, taille))
+			break;
+
+		if (ligneOuverte && format == JOURNAL_TEXTE)
+			putchar('\n');
+		if (!ligneOuverte || format == JOURNAL_TEXTE)
+			printf("[%10" PRIu32 " ms] ", date);
+		ligneOuverte = (format == JOURNAL_TEXTE);
+		if (format == JOURNAL_TEXTE)
+			fwrite(corps, 1, taille, stdout);
+		else
+		{
+			uint32_t a[4] = {0, 0, 0, 0};
+			for (uint8_t i = 0; i < nb; i++)
+				a[i] = petit_boutiste(&corps[4 * i]);
+			afficher(formats[format], a);
+		}
+	}
+	if (ligneOuverte)
+		putchar('\n');
+	if (ignores)
+		fprintf(stderr, "%" PRIu32 " octets ignores hors enregistrement\n", ignores);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file 	wav2c.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Convertit un WAV mono (8 ou 16 bits, AUDIO_FREQUENCE Hz) en son_t pour appli/audio
+ * @note	Compilation : gcc -std=gnu99 -Wall -Iappli outils/wav2c.c -o wav2c
+ * 			Usage : ./wav2c [-a] [-b debut_boucle] nom fichier.wav >> appli/audio/sons.c
+ * 			-a : compression IMA ADPCM (4 bits par echantillon) au lieu de PCM 8 bits
+ * 			-b : premier echantillon de la partie repetee quand le son est joue en boucle
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUDIO_FREQUENCE 7812 //voir appli/audio/audio.h
+
+static const int16_t pas[89] = {
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+static const int8_t variationIndex[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+static uint32_t lire32(const uint8_t *o)
+{
+	return o[0] | (uint32_t)o[1] << 8 | (uint32_t)o[2] << 16 | (uint32_t)o[3] << 24;
+}
+
+/**
+ * @brief Lit les echantillons d'un WAV PCM mono, ramenes sur 16 bits signes
+ * @retval le nombre d'echantillons, 0 en cas d'erreur
+ */
+static uint32_t lire_wav(const char *fichier, int16_t **echantillons)
+{
+	FILE *f = fopen(fichier, "rb");
+	uint8_t entete[12], bloc[8], fmt[16];
+	uint16_t bits = 0;
+	uint32_t nb = 0;
+
+	if (f == NULL || fread(entete, 1, 12, f) != 12 || memcmp(entete, "RIFF", 4) || memcmp(entete + 8, "WAVE", 4))
+	{
+		fprintf(stderr, "%s : pas un fichier WAV\n", fichier);
+		return 0;
+	}
+	while (fread(bloc, 1, 8, f) == 8)
+	{
+		uint32_t taille = lire32(bloc + 4);
+
+		if (!memcmp(bloc, "fmt ", 4) && taille >= 16)
+		{
+			if (fread(fmt, 1, 16, f) != 16)
+				break;
+			fseek(f, taille - 16, SEEK_CUR);
+			bits = fmt[14] | fmt[15] << 8;
+			if ((fmt[0] | fmt[1] << 8) != 1 || (fmt[2] | fmt[3] << 8) != 1 || (bits != 8 && bits != 16))
+			{
+				fprintf(stderr, "%s : seul le PCM mono 8 ou 16 bits est accepte\n", fichier);
+				return 0;
+			}
+			if (lire32(fmt + 4) != AUDIO_FREQUENCE)
+				fprintf(stderr, "%s : %u Hz, le son sera joue a %u Hz\n", fichier, lire32(fmt + 4), AUDIO_FREQUENCE);
+		}
+		else if (!memcmp(bloc, "data", 4) && bits)
+		{
+			nb = taille / (bits / 8);
+			*echantillons = malloc(nb * sizeof(int16_t));
+			for (uint32_t i = 0; i < nb; i++)
+			{
+				uint8_t o[2];
+				if (fread(o, 1, bits / 8, f) != bits / 8)
+					return 0;
+				(*echantillons)[i] = (bits == 8) ? (int16_t)((o[0] - 128) << 8) : (int16_t)(o[0] | o[1] << 8);
+			}
+			break;
+		}
+		else
+			fseek(f, (taille + 1) & ~1U, SEEK_CUR);
+	}
+	fclose(f);
+	return nb;
+}
+
+/**
+ * @brief Code un echantillon en IMA ADPCM, le decodage est identique a celui d'audio.c
+ */
+static uint8_t coder(int16_t e, int16_t *predicteur, uint8_t *index)
+{
+	int32_t d = e - *predicteur;
+	int32_t p = *predicteur;
+	int32_t reconstruit;
+	uint8_t code = 0;
+	int16_t q = pas[*index];
+
+	if (d < 0)
+	{
+		code = 8;
+		d = -d;
+	}
+	if (d >= q)
+	{
+		code |= 4;
+		d -= q;
+	}
+	if (d >= q >> 1)
+	{
+		code |= 2;
+		d -= q >> 1;
+	}
+	if (d >= q >> 2)
+		code |= 1;
+
+	reconstruit = q >> 3;
+	if (code & 4)
+		reconstruit += q;
+	if (code & 2)
+		reconstruit += q >> 1;
+	if (code & 1)
+		reconstruit += q >> 2;
+	p += (code & 8) ? -reconstruit : reconstruit;
+	*predicteur = (p > 32767) ? 32767 : (p < -32768) ? -32768 : (int16_t)p;
+	p = *index + variationIndex[code & 7];
+	*index = (p < 0) ? 0 : (p > 88) ? 88 : (uint8_t)p;
+	return code;
+}
+
+int main(int argc, char **argv)
+{
+	int adpcm = 0, o = 1;
+	uint32_t debutBoucle = UINT32_MAX, nb, taille;
+	int16_t *echantillons = NULL, predicteur = 0, predicteurBoucle = 0;
+	uint8_t index = 0, indexBoucle = 0, *octets;
+	const char *nom;
+
+	for (; o < argc && argv[o][0] == '-'; o++)
+	{
+		if (!strcmp(argv[o], "-a"))
+			adpcm = 1;
+		else if (!strcmp(argv[o], "-b") && o + 1 < argc)
+			debutBoucle = strtoul(argv[++o], NULL, 10);
+	}
+	if (argc - o != 2)
+	{
+		fprintf(stderr, "usage : %s [-a] [-b debut_boucle] nom fichier.wav\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	nom = argv[o];
+	if ((nb = lire_wav(argv[o + 1], &echantillons)) == 0 || nb > UINT16_MAX)
+		return EXIT_FAILURE;
+	if (debutBoucle > nb)
+		debutBoucle = nb;
+
+	taille = adpcm ? (nb + 1) / 2 : nb;
+	octets = calloc(taille, 1);
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		if (i == debutBoucle)
+		{
+			predicteurBoucle = predicteur;
+			indexBoucle = index;
+		}
+		if (adpcm)
+			octets[i / 2] |= coder(echantillons[i], &predicteur, &index) << ((i & 1) * 4);
+		else
+			octets[i] = (uint8_t)((echantillons[i] >> 8) + 128);
+	}
+
+	printf("static const uint8_t %s_donnees[%u] = {", nom, taille);
+	for (uint32_t i = 0; i < taille; i++)
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", octets[i]);
+	printf("\n};\n\n");
+	printf("const son_t %s = {%s_donnees, %u, %u, %s, %d, %u};\n", nom, nom, nb, debutBoucle,
+		   adpcm ? "AUDIO_ADPCM" : "AUDIO_PCM8", predicteurBoucle, indexBoucle);
+	return EXIT_SUCCESS;
+}
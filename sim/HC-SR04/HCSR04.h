@@ -0,0 +1,23 @@
+/**
+ ******************************************************************************
+ * @file 	HCSR04.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du pilote HC-SR04 de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef HCSR04_H_
+#define HCSR04_H_
+
+#include "stm32f1xx_hal.h"
+
+#define HCSR04_NB_SENSORS 5
+#define HCSR04_TIMEOUT 150 /** @def Duree en ms au dela de laquelle une mesure sans echo est abandonnee*/
+
+HAL_StatusTypeDef HCSR04_add(uint8_t *id, GPIO_TypeDef *TRIG_GPIO, uint16_t TRIG_PIN, GPIO_TypeDef *ECHO_GPIO, uint16_t ECHO_PIN);
+HAL_StatusTypeDef HCSR04_run_measure(uint8_t id);
+HAL_StatusTypeDef HCSR04_get_value(uint8_t id, uint16_t *distance);
+void HCSR04_process_main(void);
+
+#endif /* HCSR04_H_ */
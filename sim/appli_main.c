@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * @file 	appli_main.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Compile appli/main.c sans modification, son point d'entree etant
+ * 			renomme APPLI_main pour laisser main() au simulateur
+ * @note    Chaque iteration des boucles while de main.c consomme SIM_COUT_ITERATION,
+ * 			sans quoi une boucle d'attente active ne ferait jamais avancer le temps virtuel.
+ * 			C'est aussi la sonde qui mesure la periode de la boucle principale.
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "stm32f1_uart.h"
+#include "stm32f1_sys.h"
+#include "stm32f1_gpio.h"
+#include "macro_types.h"
+#include "systick.h"
+#include "sim.h"
+
+static inline int iteration(void)
+{
+	SIM_iteration();
+	return 1;
+}
+
+//Le while (1) final de main() ne paraissant plus infini au compilateur, sa fin sans return est toleree
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#define main APPLI_main
+#define while(condition) while (iteration() && (condition))
+#include "../appli/main.c"
+#undef while
+#undef main
+#pragma GCC diagnostic pop
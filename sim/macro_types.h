@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @file 	macro_types.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote des types de base de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef MACRO_TYPES_H_
+#define MACRO_TYPES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum
+{
+	FALSE = 0,
+	TRUE
+} bool_e;
+
+typedef void (*callback_fun_t)(void);
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define ABSOLUTE(x) (((x) < 0) ? -(x) : (x))
+
+#endif /* MACRO_TYPES_H_ */
@@ -0,0 +1,219 @@
+/**
+ ******************************************************************************
+ * @file 	sim.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Interface interne du simulateur hote : horloge virtuelle, interruptions
+ * 			simulees, monde physique et statistiques
+ * @note    Le temps ne s'ecoule que lorsque le code applicatif appelle la couche
+ * 			materielle simulee : chaque appel consomme un cout CPU virtuel (SIM_COUT_xxx).
+ * 			Les interruptions programmees preemptent ce temps exactement comme sur la cible.
+ ******************************************************************************
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+#include "macro_types.h"
+#include "stm32f1xx_hal.h"
+
+#define SIM_NS_PAR_US 1000ULL
+#define SIM_NS_PAR_MS 1000000ULL
+
+//Couts CPU virtuels (en ns) des appels a la couche materielle, estimes pour un Cortex-M3 a 72 MHz
+#define SIM_COUT_ITERATION 100	 /** @def Une iteration de boucle applicative (test + branchement)*/
+#define SIM_COUT_GETTICK 100
+#define SIM_COUT_GPIO 150
+#define SIM_COUT_ENTREE_IT 250		 /** @def Empilement + depilement du contexte et branchement au vecteur*/
+#define SIM_COUT_APPEL_CALLBACK 150	 /** @def Parcours de la liste des callbacks Systick*/
+#define SIM_COUT_HCSR04_MAIN 1500
+#define SIM_COUT_HCSR04_RUN 3000
+#define SIM_COUT_HCSR04_GET 500
+#define SIM_COUT_HCSR04_FRONT 2000	 /** @def Routine EXTI + lecture du timer sur un front d'echo*/
+#define SIM_COUT_PWM_RUN 9000		 /** @def Reinitialisation complete du timer par la HAL*/
+#define SIM_COUT_PWM_SET 2500
+#define SIM_COUT_MOTEUR 2500
+#define SIM_COUT_DMA_START 2000		 /** @def Programmation d'un canal DMA par la HAL*/
+#define SIM_COUT_DMA_IT 1000		 /** @def Routine de fin de transfert DMA de la HAL, hors callback*/
+#define SIM_COUT_I2C_START 1500		 /** @def Lancement d'un transfert I2C sous interruption par la HAL*/
+#define SIM_COUT_I2C_IT 6000		 /** @def Routines d'evenement I2C d'une lecture de registres, une par octet, hors callback*/
+
+typedef enum
+{
+	SIM_IT_SYSTICK = 0,
+	SIM_IT_EXTI,
+	SIM_IT_DMA,
+	SIM_IT_I2C,
+	SIM_IT_MATERIEL, /** Evenement purement materiel (front sur une entree de capture...) : ne coute aucun temps CPU*/
+	SIM_IT_NB
+} SIM_it_e;
+
+typedef void (*SIM_handler_t)(uint32_t arg);
+
+typedef struct
+{
+	uint32_t nb;
+	uint64_t total_ns;
+	uint64_t max_ns;
+} SIM_stat_it_t;
+
+//Horloge et interruptions (sim_horloge.c)
+void SIM_horloge_init(uint64_t fin_ns);
+uint64_t SIM_maintenant(void);
+void SIM_consommer(uint32_t ns);
+void SIM_iteration(void);
+uint64_t SIM_boucle_periode_max_ns(void);
+uint64_t SIM_boucle_periode_moy_ns(void);
+bool_e SIM_en_interruption(void);
+void SIM_programmer(uint64_t date_ns, SIM_it_e source, SIM_handler_t handler, uint32_t arg);
+uint64_t SIM_date_evenement(void);
+uint64_t SIM_sommeil_ns(void);
+const SIM_stat_it_t *SIM_stat_it(SIM_it_e source);
+uint8_t SIM_systick_max_callbacks(void);
+void SIM_systick_callbacks(void);
+uint32_t SIM_uart_nb_caracteres(void);
+uint64_t SIM_uart_ns_par_caractere(void);
+void SIM_set_verbeux(bool_e verbeux);
+
+//Monde physique (sim_monde.c)
+typedef enum
+{
+	SIM_CAPTEUR_AVANT = 0,
+	SIM_CAPTEUR_DROITE,
+	SIM_CAPTEUR_GAUCHE,
+	SIM_CAPTEUR_ARRIERE,
+	SIM_CAPTEUR_NB
+} SIM_capteur_e;
+
+typedef struct
+{
+	double x1, y1, x2, y2; //mm
+	uint32_t apparition_ms; //0 : present des le debut
+	uint32_t disparition_ms; //0 : jamais retire
+} SIM_segment_t;
+
+typedef struct
+{
+	const char *nom;
+	const char *description;
+	const SIM_segment_t *segments;
+	uint8_t nb_segments;
+	double x, y, cap; //pose initiale (mm, mm, rad)
+	double but_x;	  //abscisse a atteindre (mm), 0 : pas de but
+} SIM_scenario_t;
+
+typedef struct
+{
+	double distance_mm;
+	uint32_t collisions;
+	uint32_t reactions;
+	uint64_t reaction_total_ns;
+	uint64_t reaction_min_ns;
+	uint64_t reaction_max_ns;
+	uint32_t arrets;		//passages de la marche avant a l'arret
+	uint32_t marche_avant_ms; //temps passe a avancer
+	double avant_mm;		//distance parcourue en marche avant
+	uint32_t changements_moteur;
+	uint32_t mises_a_jour_moteur;	//evenements de mise a jour ayant change au moins un rapport cyclique
+	uint32_t mises_a_jour_decalees; //rapports cycliques ecrits hors UDIS : chaque canal bascule a sa propre mise a jour
+	int16_t pas_max_moteur;			//plus grand saut de rapport cyclique d'une roue en une mise a jour (en %)
+	uint32_t reconfigurations_pwm;
+	uint32_t but_ms;	 //date d'arrivee au but, 0 : pas atteint
+	uint32_t arrets_but; //arrets avant l'arrivee au but
+	uint32_t virages;	 //virages sur place, roues en opposition
+	double virage_deg;	 //somme des angles tournes (deg)
+	double virage_deg2;	 //somme de leurs carres
+	double virage_min_deg;
+	double virage_max_deg;
+	uint64_t virage_ms;	 //duree cumulee des virages
+	uint32_t boucles;	 //episodes ou la voiture repasse par des poses deja occupees, voir sim_monde.c
+	uint32_t boucle_ms;	 //temps passe en boucle
+	uint32_t lateral_ms; //temps de marche avant ou les distances laterales sont echantillonnees
+	double lateral_mm[2];  //somme des distances du capteur droit puis gauche au plus proche obstacle (mm)
+	double lateral_mm2[2]; //somme de leurs carres
+} SIM_stat_monde_t;
+
+void SIM_monde_init(const SIM_scenario_t *scenario);
+void SIM_monde_pas_ms(void);
+double SIM_monde_distance(SIM_capteur_e capteur);
+const SIM_stat_monde_t *SIM_monde_stat(void);
+void SIM_monde_pose(double *x, double *y, double *cap);
+void SIM_monde_glissement(double glissement);
+double SIM_monde_lacet(void);
+double SIM_monde_distance_obstacle(double px, double py);
+
+//Capteurs ultrason (sim_hcsr04.c)
+typedef struct
+{
+	uint32_t lancees;
+	uint32_t echos;			  //fronts descendants d'echo emis par le module
+	uint32_t lues;			  //echos exploites par l'application
+	uint32_t perdus;		  //salves sans echo exploitable
+	uint32_t timeouts;		  //mesures closes en timeout par le pilote
+	uint32_t diaphoniesLues; //echos lus alors qu'ils avaient ete tronques par la salve d'un voisin
+	uint32_t ecartMax_us;	  //plus grand ecart entre la largeur d'echo lue et la largeur emise
+	uint64_t ecartTotal_us;
+} SIM_stat_capteur_t;
+
+void SIM_hcsr04_config(double diaphonie, double perte, double bruit_mm);
+const SIM_stat_capteur_t *SIM_hcsr04_stat(SIM_capteur_e capteur);
+void SIM_hcsr04_gpio(GPIO_TypeDef *gpio, uint16_t pin, bool_e avant, bool_e apres);
+void SIM_hcsr04_capture_lue(TIM_TypeDef *tim, uint8_t canal);
+
+//Timers (sim_timer.c)
+void SIM_tim_capture(TIM_TypeDef *tim, uint8_t canal);
+
+//Haut-parleur sur TIM4 canal 1 (sim_hp.c)
+typedef struct
+{
+	uint32_t changements; //changements de note ou de silence observes en sortie
+	uint32_t sonore_ms;
+	uint64_t echantillonsPcm; //rapports cycliques ecrits par le DMA
+} SIM_stat_hp_t;
+
+#define SIM_HP_FREQUENCE_WAV 31250 /** @def Une valeur par periode de la porteuse PCM (72 MHz / 9 / 256)*/
+
+void SIM_hp_pas_ms(void);
+void SIM_hp_verbeux(bool_e verbeux);
+void SIM_hp_wav(const char *fichier);
+void SIM_hp_pcm(const uint8_t *rapports, uint32_t nb);
+void SIM_hp_fermer(void);
+const SIM_stat_hp_t *SIM_hp_stat(void);
+
+//DMA de l'emission UART2 et du rapport cyclique de TIM4 (sim_dma.c)
+typedef struct
+{
+	uint32_t transferts;
+	uint32_t octets;
+	uint32_t plusLong; //plus grand transfert, en octets
+} SIM_stat_dma_t;
+
+void SIM_dma_capture(const char *fichier);
+const SIM_stat_dma_t *SIM_dma_stat(void);
+bool_e SIM_dma_pcm_actif(void);
+
+//Gyroscope MPU6050 sur I2C1 (sim_i2c.c)
+typedef struct
+{
+	uint32_t lectures;
+	uint32_t ecritures;
+	uint32_t refus; //transferts lances bus occupe ou vers une adresse absente
+} SIM_stat_i2c_t;
+
+void SIM_i2c_config(double biais_dps, double bruit_dps);
+const SIM_stat_i2c_t *SIM_i2c_stat(void);
+
+//Bancs d'essai hote (sim_banc.c)
+void SIM_banc_approche(uint32_t nb, double bruit);
+void SIM_banc_filtre(uint32_t nb, double bruit);
+void SIM_banc_odometrie(uint32_t nb);
+void SIM_banc_grille(uint32_t nb);
+void SIM_banc_tache(uint32_t nb);
+void SIM_banc_minuterie(uint32_t nb);
+
+//Generateur pseudo-aleatoire deterministe (simu.c)
+void SIM_alea_init(uint32_t graine);
+double SIM_alea(void);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,702 @@
+/**
+ ******************************************************************************
+ * @file 	sim_banc.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Bancs d'essai hote des calculs de l'application : chaque banc appelle
+ * 			directement le code embarque sur des donnees synthetiques et mesure
+ * 			son cout en temps reel, hors temps virtuel du simulateur
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <time.h>
+#include "sim.h"
+#include "capteur/approche.h"
+#include "capteur/filtre.h"
+#include "odometrie/odometrie.h"
+#include "grille/grille.h"
+#include "registre/registre.h"
+#include "minuterie/minuterie.h"
+#include "tache/tache.h"
+
+#define BANC_NB_RELEVES 4096	/** @def Releves synthetiques generes avant la mesure, rejoues en boucle*/
+#define BANC_VITESSE 500.0		/** @def Vitesse de rapprochement simulee (mm/s)*/
+#define BANC_PERIODE 70			/** @def Periode moyenne des releves d'un capteur (ms)*/
+
+static double secondes(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Banc de l'estimateur de temps avant contact : obstacle approchant a BANC_VITESSE de 1500 a 200 mm,
+ * 		releves espaces de BANC_PERIODE +/- 10 ms et bruites de +/- bruit mm
+ * @param nb : nombre d'appels a APPROCHE_ajouter mesures
+ * @param bruit : amplitude du bruit de mesure (mm)
+ */
+void SIM_banc_approche(uint32_t nb, double bruit)
+{
+	static uint16_t distances[BANC_NB_RELEVES];
+	static uint32_t dates[BANC_NB_RELEVES];
+	historique_t h = {.nb = 0};
+	double d = 1500.0, somme = 0.0, somme2 = 0.0, t0;
+	uint32_t date = 0, n = 0, ttcCourts = 0;
+	volatile int32_t puits = 0;
+
+	for (uint32_t i = 0; i < BANC_NB_RELEVES; i++)
+	{
+		uint32_t pas = BANC_PERIODE - 10 + (uint32_t)(SIM_alea() * 21.0);
+		date += pas;
+		d -= BANC_VITESSE * pas / 1000.0;
+		if (d < 200.0)
+			d = 1500.0;
+		distances[i] = (uint16_t)lround(d + (SIM_alea() * 2.0 - 1.0) * bruit);
+		dates[i] = date;
+	}
+
+	//Precision, hors mesure de temps
+	for (uint32_t i = 0; i < BANC_NB_RELEVES; i++)
+	{
+		if (i && distances[i] > distances[i - 1] + 500)
+			APPROCHE_vider(&h); //retour a 1500 mm : nouvelle approche
+		approche_t a = APPROCHE_ajouter(&h, distances[i], dates[i]);
+		if (h.nb == APPROCHE_NB)
+		{
+			somme += a.vitesse;
+			somme2 += (double)a.vitesse * a.vitesse;
+			n++;
+			if (a.ttc != APPROCHE_AUCUNE && a.ttc * BANC_VITESSE / 1000.0 < distances[i] * 0.8)
+				ttcCourts++;
+		}
+	}
+
+	APPROCHE_vider(&h);
+	t0 = secondes();
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		uint32_t k = i % BANC_NB_RELEVES;
+		puits += APPROCHE_ajouter(&h, distances[k], dates[k] + (i / BANC_NB_RELEVES) * date).vitesse;
+	}
+	t0 = secondes() - t0;
+
+	double moy = n ? somme / n : 0.0;
+	printf("estimateur ttc        : %u releves, %.1f ns par releve (hote), anneau de %u\n", nb, nb ? t0 * 1e9 / nb : 0.0, APPROCHE_NB);
+	printf("                        vitesse estimee moy %.0f mm/s (vraie %.0f), ecart-type %.0f mm/s, bruit +/- %.0f mm, %u ttc sous-estimes de plus de 20 %%\n",
+		   moy, BANC_VITESSE, n ? sqrt(somme2 / n - moy * moy) : 0.0, bruit, ttcCourts);
+}
+
+//Filtre en flottant, meme algorithme que filtre.c, pour comparer le cout
+typedef struct
+{
+	float fenetre[FILTRE_N_MAX];
+	uint8_t n, tete, rejets;
+	float alpha, vitesseMax, candidat, date, moyenne;
+} filtre_flottant_t;
+
+static void remplir_flottant(filtre_flottant_t *f, float distance)
+{
+	for (uint8_t i = 0; i < f->n; i++)
+		f->fenetre[i] = distance;
+	f->tete = 0;
+	f->moyenne = distance;
+}
+
+static void init_flottant(filtre_flottant_t *f, uint8_t n, float alpha, float vitesseMax)
+{
+	f->n = (n > FILTRE_N_MAX) ? FILTRE_N_MAX : (n | 1);
+	f->alpha = alpha;
+	f->vitesseMax = vitesseMax;
+	f->rejets = 0;
+	f->candidat = FILTRE_LOIN;
+	f->date = 0.0f;
+	remplir_flottant(f, FILTRE_LOIN);
+}
+
+static float ajouter_flottant(filtre_flottant_t *f, float distance, float date)
+{
+	float duree = date - f->date;
+	float seuil = 60.0f + (duree < 1000.0f ? duree : 1000.0f) * f->vitesseMax / 1000.0f;
+	float tri[FILTRE_N_MAX];
+
+	if (fabsf(distance - f->moyenne) > seuil)
+	{
+		if (f->rejets && (fabsf(distance - f->candidat) <= seuil || f->rejets >= 3))
+		{
+			f->rejets = 0;
+			f->date = date;
+			remplir_flottant(f, distance);
+			return distance;
+		}
+		f->rejets++;
+		f->candidat = distance;
+		return f->moyenne;
+	}
+	f->rejets = 0;
+	f->date = date;
+	f->fenetre[f->tete] = distance;
+	f->tete = (f->tete + 1 == f->n) ? 0 : f->tete + 1;
+	for (uint8_t i = 0; i < f->n; i++)
+	{
+		float v = f->fenetre[i];
+		uint8_t j = i;
+		while (j > 0 && tri[j - 1] > v)
+		{
+			tri[j] = tri[j - 1];
+			j--;
+		}
+		tri[j] = v;
+	}
+	float m = tri[f->n / 2];
+	if (m >= FILTRE_LOIN || f->moyenne >= FILTRE_LOIN)
+		f->moyenne = m;
+	else
+		f->moyenne += (m - f->moyenne) * f->alpha;
+	return f->moyenne;
+}
+
+typedef struct
+{
+	historique_t historique;
+	bool_e arret;		//decision d'arret courante
+	uint32_t faux;		//arrets decides alors que rien n'est proche
+	uint32_t episode;	//dernier episode d'arret impose deja servi
+	uint32_t arretsVrais; //episodes d'arret impose servis par une decision d'arret
+	uint32_t retards;	//episodes servis plus de BANC_RETARD_MAX ms apres leur debut
+	uint32_t retardTotal;
+} decision_t; /** @struct Decisions d'arret du regulateur de croisiere rejouees sur un flux de distances*/
+
+#define BANC_ARRET 250			/** @def Distance d'arret de croisiere.c (mm)*/
+#define BANC_TTC_ARRET 1000		/** @def Temps avant contact d'arret de croisiere.c (ms)*/
+#define BANC_RETARD_MAX 150		/** @def Retard d'arret au dela duquel un arret est compte en retard (ms)*/
+#define BANC_PARASITES 0.03		/** @def Probabilite qu'un releve soit un echo parasite court*/
+#define BANC_FILTRE_N 3			/** @def Reglages par defaut du filtre, comme capteur.c*/
+#define BANC_FILTRE_ALPHA 224
+#define BANC_FILTRE_VITESSE 3000
+
+/**
+ * @brief Rejoue la decision d'arret de croisiere.c sur une distance publiee
+ * @param vrai : 1 si la verite terrain impose l'arret, -1 si elle ne l'impose pas mais qu'un arret reste acceptable
+ * @param episode : numero de l'episode d'arret impose en cours ou passe
+ * @param debutVrai : date de debut de cet episode
+ */
+static void decider(decision_t *d, uint16_t distance, uint32_t date, int8_t vrai, uint32_t episode, uint32_t debutVrai)
+{
+	approche_t a = {0, APPROCHE_AUCUNE};
+	bool_e arret;
+
+	if (distance != FILTRE_LOIN)
+		a = APPROCHE_ajouter(&d->historique, distance, date);
+	else
+		APPROCHE_vider(&d->historique);
+	arret = distance < BANC_ARRET || a.ttc < BANC_TTC_ARRET;
+	if (arret && !d->arret && vrai == 0)
+		d->faux++;
+	if (arret && vrai > 0 && d->episode != episode)
+	{
+		d->episode = episode;
+		d->arretsVrais++;
+		d->retardTotal += date - debutVrai;
+		if (date - debutVrai > BANC_RETARD_MAX)
+			d->retards++;
+	}
+	d->arret = arret;
+}
+
+/**
+ * @brief Banc du filtre des distances :
+ * 		- rejeu d'un flux synthetique (approches d'obstacles, passages en voie libre, echos parasites
+ * 		  courts et echos perdus) a travers la decision d'arret de la croisiere, avec et sans filtre,
+ * 		- cout par releve du filtre entier et de la meme version en flottant.
+ * @param nb : nombre de releves rejoues et chronometres
+ * @param bruit : amplitude du bruit de mesure (mm)
+ */
+void SIM_banc_filtre(uint32_t nb, double bruit)
+{
+	static uint16_t bruts[BANC_NB_RELEVES];
+	static uint32_t dates[BANC_NB_RELEVES];
+	filtre_t f;
+	filtre_flottant_t ff;
+	decision_t sans = {0}, avec = {0};
+	double d = -1.0, vitesse = 0.0, t0, tEntier, tFlottant;
+	uint32_t date = 0, debutVrai = 0, nbParasites = 0, episodes = 0;
+	int8_t vrai, vraiPrec = 0;
+	volatile float puitsF = 0.0f;
+	volatile uint32_t puits = 0;
+
+	FILTRE_init(&f, BANC_FILTRE_N, BANC_FILTRE_ALPHA, BANC_FILTRE_VITESSE);
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		uint32_t pas = BANC_PERIODE - 10 + (uint32_t)(SIM_alea() * 21.0);
+		uint16_t brut;
+
+		date += pas;
+		if (d < 0.0)
+		{ //Voie libre, puis un obstacle entre dans la porte a une vitesse de 200 a 1000 mm/s
+			if (SIM_alea() < 0.02)
+			{
+				d = 1500.0;
+				vitesse = 200.0 + SIM_alea() * 800.0;
+			}
+		}
+		else
+		{
+			d -= vitesse * pas / 1000.0;
+			if (d < 150.0)
+				d = -1.0; //la voiture s'est detournee
+		}
+		//Verite : arret impose, acceptable (zone de doute) ou injustifie
+		if (d >= 0.0 && (d < BANC_ARRET || d * 1000.0 / vitesse < BANC_TTC_ARRET))
+			vrai = 1;
+		else if (d >= 0.0 && (d < BANC_ARRET * 1.5 || d * 1000.0 / vitesse < BANC_TTC_ARRET * 1.5))
+			vrai = -1;
+		else
+			vrai = 0;
+		if (vrai > 0 && vraiPrec <= 0)
+		{
+			debutVrai = date;
+			episodes++;
+		}
+		vraiPrec = vrai;
+
+		if (SIM_alea() < BANC_PARASITES)
+		{
+			brut = (uint16_t)(100.0 + SIM_alea() * 1300.0);
+			nbParasites++;
+		}
+		else if (d < 0.0 || SIM_alea() < 0.02)
+			brut = FILTRE_LOIN;
+		else
+			brut = (uint16_t)lround(d + (SIM_alea() * 2.0 - 1.0) * bruit);
+		if (i < BANC_NB_RELEVES)
+		{
+			bruts[i] = brut;
+			dates[i] = date;
+		}
+		decider(&sans, brut, date, vrai, episodes, debutVrai);
+		decider(&avec, FILTRE_ajouter(&f, brut, date), date, vrai, episodes, debutVrai);
+	}
+
+	//Cout par releve, sur les premiers releves rejoues en boucle
+	FILTRE_init(&f, BANC_FILTRE_N, BANC_FILTRE_ALPHA, BANC_FILTRE_VITESSE);
+	t0 = secondes();
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		uint32_t k = i % BANC_NB_RELEVES;
+		puits += FILTRE_ajouter(&f, bruts[k], dates[k] + (i / BANC_NB_RELEVES) * dates[BANC_NB_RELEVES - 1]);
+	}
+	tEntier = secondes() - t0;
+	init_flottant(&ff, BANC_FILTRE_N, BANC_FILTRE_ALPHA / 256.0f, BANC_FILTRE_VITESSE);
+	t0 = secondes();
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		uint32_t k = i % BANC_NB_RELEVES;
+		puitsF += ajouter_flottant(&ff, bruts[k], (float)(dates[k] + (i / BANC_NB_RELEVES) * dates[BANC_NB_RELEVES - 1]));
+	}
+	tFlottant = secondes() - t0;
+
+	printf("filtre des distances  : %u releves (%.1f h), %u echos parasites, bruit +/- %.0f mm\n", nb, date / 3.6e6, nbParasites, bruit);
+	printf("                        entier %.1f ns par releve, flottant %.1f ns par releve (hote avec FPU)\n",
+		   nb ? tEntier * 1e9 / nb : 0.0, nb ? tFlottant * 1e9 / nb : 0.0);
+	printf("                        arrets injustifies : %u sans filtre, %u avec\n", sans.faux, avec.faux);
+	printf("                        %u arrets imposes, manques : %u sans filtre, %u avec\n", episodes, episodes - sans.arretsVrais, episodes - avec.arretsVrais);
+	printf("                        retard moy : %.0f ms sans filtre, %.0f ms avec ; au dela de %u ms : %u sans filtre, %u avec\n",
+		   sans.arretsVrais ? (double)sans.retardTotal / sans.arretsVrais : 0.0, avec.arretsVrais ? (double)avec.retardTotal / avec.arretsVrais : 0.0,
+		   BANC_RETARD_MAX, sans.retards, avec.retards);
+}
+
+#define BANC_SEGMENTS 500		/** @def Segments a rapports cycliques constants d'un parcours d'odometrie*/
+#define BANC_PAS_CONTROLE 20	/** @def Periode de controle de main.c (ms)*/
+#define BANC_VITESSE_ROUE 800.0 /** @def Vitesse d'une roue a 100 %, comme sim_monde.c (mm/s)*/
+#define BANC_VOIE 150.0			/** @def Voie, comme sim_monde.c (mm)*/
+#define BANC_ASYMETRIE 30		/** @def Roue droite plus rapide que la gauche pour les essais non nominaux (pour mille)*/
+
+typedef struct
+{
+	int8_t droite, gauche;
+	uint16_t duree; //multiple de BANC_PAS_CONTROLE (ms)
+} segment_odometrie_t;
+
+/**
+ * @brief Rejoue un parcours : verite en flottant a la milliseconde, estimation par l'odometrie au pas de controle
+ * @param asymetrie : ecart de vitesse reel de la roue droite (pour mille)
+ * @param correction : ecart donne a l'etalonnage de l'odometrie (pour mille)
+ */
+static void parcourir_odometrie(const segment_odometrie_t *seg, uint16_t nb, int16_t asymetrie, int16_t correction, const char *nom)
+{
+	double x = 0.0, y = 0.0, cap = 0.0, parcours = 0.0;
+
+	ODOMETRIE_init();
+	ODOMETRIE_etalonner((uint16_t)BANC_VITESSE_ROUE, (uint16_t)BANC_VOIE, correction);
+	for (uint16_t i = 0; i < nb; i++)
+	{
+		double vd = seg[i].droite * BANC_VITESSE_ROUE * (1000 + asymetrie) / 100000.0;
+		double vg = seg[i].gauche * BANC_VITESSE_ROUE / 100.0;
+		for (uint16_t t = 0; t < seg[i].duree; t++)
+		{
+			x += (vd + vg) / 2.0 * cos(cap) / 1000.0;
+			y += (vd + vg) / 2.0 * sin(cap) / 1000.0;
+			cap += (vd - vg) / BANC_VOIE / 1000.0;
+			parcours += fabs(vd + vg) / 2.0 / 1000.0;
+		}
+		for (uint16_t t = 0; t < seg[i].duree; t += BANC_PAS_CONTROLE)
+			ODOMETRIE_integrer(seg[i].droite, seg[i].gauche, BANC_PAS_CONTROLE);
+	}
+
+	pose_t e = ODOMETRIE_get_pose();
+	double ecart = hypot(x - e.x, y - e.y);
+	printf("                        %-28s : ecart %6.0f mm (%5.2f %% de %.0f m), cap %7.2f deg apres %.0f tours\n", nom, ecart, 100.0 * ecart / parcours,
+		   parcours / 1000.0, remainder(cap - e.cap * M_PI / ODOMETRIE_DEMI_TOUR, 2.0 * M_PI) * 180.0 / M_PI, fabs(cap) / (2.0 * M_PI));
+}
+
+/**
+ * @brief Banc de l'odometrie : parcours aleatoire de BANC_SEGMENTS lignes droites, arcs, rotations sur place
+ * 		et reculs, de 20 ms a 2 s chacun, rejoue avec des roues identiques puis asymetriques
+ * @param nb : nombre d'appels a ODOMETRIE_integrer mesures
+ */
+void SIM_banc_odometrie(uint32_t nb)
+{
+	static segment_odometrie_t seg[BANC_SEGMENTS];
+	double t0;
+
+	for (uint16_t i = 0; i < BANC_SEGMENTS; i++)
+	{
+		int8_t p = (int8_t)(30 + SIM_alea() * 71.0);
+		double genre = SIM_alea();
+
+		if (genre < 0.4)
+			seg[i] = (segment_odometrie_t){p, p, 0}; //ligne droite
+		else if (genre < 0.7)
+			seg[i] = (genre < 0.55) ? (segment_odometrie_t){p, (int8_t)(p / 2), 0} : (segment_odometrie_t){(int8_t)(p / 2), p, 0}; //arc
+		else if (genre < 0.9)
+			seg[i] = (genre < 0.8) ? (segment_odometrie_t){p, (int8_t)-p, 0} : (segment_odometrie_t){(int8_t)-p, p, 0}; //rotation sur place
+		else
+			seg[i] = (segment_odometrie_t){(int8_t)-p, (int8_t)-p, 0}; //recul
+		seg[i].duree = BANC_PAS_CONTROLE * (1 + (uint16_t)(SIM_alea() * 100.0));
+	}
+
+	printf("odometrie             : parcours de %u segments, pas de %u ms\n", BANC_SEGMENTS, BANC_PAS_CONTROLE);
+	parcourir_odometrie(seg, BANC_SEGMENTS, 0, 0, "roues identiques");
+	parcourir_odometrie(seg, BANC_SEGMENTS, BANC_ASYMETRIE, 0, "roue droite +3 %, non etalonne");
+	parcourir_odometrie(seg, BANC_SEGMENTS, BANC_ASYMETRIE, BANC_ASYMETRIE, "roue droite +3 %, etalonne");
+
+	ODOMETRIE_init();
+	t0 = secondes();
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		const segment_odometrie_t *s = &seg[i % BANC_SEGMENTS];
+		ODOMETRIE_integrer(s->droite, s->gauche, BANC_PAS_CONTROLE);
+	}
+	t0 = secondes() - t0;
+	printf("                        %.1f ns par pas (hote), position finale %d mm\n", nb ? t0 * 1e9 / nb : 0.0, (int)ODOMETRIE_get_pose().x);
+	ODOMETRIE_init();
+}
+
+#define BANC_ETENDUE 1000.0 /** @def Ecart maximal des poses du banc de la grille a l'origine : la fenetre n'a pas a suivre (mm)*/
+#define BANC_SANS_ECHO 0.25 /** @def Proportion des releves du banc de la grille sans echo*/
+
+typedef struct
+{
+	pose_t pose;
+	uint8_t monture;
+	uint16_t distance;
+} releve_grille_t; /** @struct Releve synthetique du banc de la grille*/
+
+/**
+ * @brief Mesure le cout de BANC_NB_RELEVES / 16 recherches d'une direction libre sur la grille en l'etat
+ * @retval le cout moyen d'une recherche (ns)
+ */
+static double chronometrer_recherche(const releve_grille_t *r)
+{
+	uint32_t n = BANC_NB_RELEVES / 16;
+	uint32_t somme = 0;
+	double t0 = secondes();
+
+	for (uint32_t i = 0; i < n; i++)
+		somme += (uint16_t)GRILLE_direction_libre(r[i].pose, NULL);
+	t0 = secondes() - t0;
+	(void)somme;
+	return t0 * 1e9 / n;
+}
+
+/**
+ * @brief Banc de la grille d'occupation : releves aleatoires des quatre capteurs autour de l'origine,
+ * 		puis recherches d'une direction libre sur la grille vide (pire cas, chaque direction est parcourue
+ * 		jusqu'a la portee) et sur la grille remplie
+ * @param nb : nombre d'appels a GRILLE_ajouter mesures
+ */
+void SIM_banc_grille(uint32_t nb)
+{
+	//Capteurs montes comme sur la voiture, voir main.c
+	static const monture_t montures[] = {
+		{0, 100, 0, ODOMETRIE_DEGRES(0)},
+		{1, 0, -80, ODOMETRIE_DEGRES(-90)},
+		{2, 0, 80, ODOMETRIE_DEGRES(90)},
+		{3, -100, 0, ODOMETRIE_DEGRES(180)},
+	};
+	static releve_grille_t r[BANC_NB_RELEVES];
+	double t0, vide;
+
+	for (uint32_t i = 0; i < BANC_NB_RELEVES; i++)
+	{
+		r[i].pose = (pose_t){(int32_t)((SIM_alea() * 2.0 - 1.0) * BANC_ETENDUE), (int32_t)((SIM_alea() * 2.0 - 1.0) * BANC_ETENDUE),
+							 (int16_t)(SIM_alea() * 65536.0 - 32768.0)};
+		r[i].monture = (uint8_t)(SIM_alea() * 4.0);
+		r[i].distance = (SIM_alea() < BANC_SANS_ECHO) ? 65535 : (uint16_t)(150.0 + SIM_alea() * 1550.0);
+	}
+
+	GRILLE_init(montures, 4);
+	vide = chronometrer_recherche(r);
+	t0 = secondes();
+	for (uint32_t i = 0; i < nb; i++)
+	{
+		const releve_grille_t *e = &r[i % BANC_NB_RELEVES];
+		GRILLE_ajouter(e->pose, e->monture, e->distance);
+	}
+	t0 = secondes() - t0;
+
+	printf("grille d'occupation   : %u x %u cellules de %u mm, %u octets, portee %u mm\n", GRILLE_COTE, GRILLE_COTE, GRILLE_CELLULE,
+		   (unsigned)(GRILLE_COTE * GRILLE_COTE * sizeof(int8_t)), GRILLE_PORTEE);
+	printf("                        %u releves, %.1f ns par releve (hote), au plus %u cellules modifiees par releve\n", nb, nb ? t0 * 1e9 / nb : 0.0,
+		   GRILLE_get_stat().cellulesMax);
+	printf("                        direction libre parmi %u : %.0f ns sur grille vide (pire cas), %.0f ns sur grille remplie (hote)\n",
+		   GRILLE_NB_DIRECTIONS, vide, chronometrer_recherche(r));
+	GRILLE_init(montures, 4);
+}
+
+#define BANC_NB_TACHES 4	   /** @def Coroutines reveillees a chaque passage du banc de l'ordonnanceur*/
+#define BANC_TACHES_DORMANTES 4 /** @def Taches jamais reveillees, parcourues a chaque passage*/
+
+static tache_t tachesBanc[BANC_NB_TACHES + BANC_TACHES_DORMANTES];
+static volatile uint32_t pasBanc;
+
+static etat_tache_e coroutine(tache_t *t)
+{
+	TACHE_DEBUT(t);
+	for (;;)
+	{
+		pasBanc++;
+		TACHE_CEDER(t);
+	}
+	TACHE_FIN(t);
+}
+
+static etat_tache_e dormante(tache_t *t)
+{
+	(void)t;
+	return TACHE_EN_COURS;
+}
+
+/**
+ * @brief Banc de l'ordonnanceur cooperatif : BANC_NB_TACHES coroutines reveillees chacune par son evenement,
+ * 		parmi des taches dormantes. Le surcout d'une commutation est compare a l'appel direct de la coroutine.
+ * @param nb : nombre de commutations mesurees
+ */
+void SIM_banc_tache(uint32_t nb)
+{
+	uint32_t tous = 0, passes = nb / BANC_NB_TACHES;
+	double direct, ordonnance, vide;
+
+	SIM_horloge_init(UINT64_MAX); //la minuterie de reveil masque les interruptions : le demasquage ne doit pas clore la simulation
+	TACHE_init();
+	for (uint8_t i = 0; i < BANC_NB_TACHES + BANC_TACHES_DORMANTES; i++)
+	{
+		if (i < BANC_NB_TACHES)
+			tous |= 1UL << i;
+		TACHE_creer(&tachesBanc[i], "banc", (i < BANC_NB_TACHES) ? &coroutine : &dormante, 0, (i < BANC_NB_TACHES) ? 1UL << i : 0, i, TRUE);
+	}
+	TACHE_ordonnancer(0); //premier appel de chaque tache, jusqu'a sa premiere attente
+
+	direct = secondes();
+	for (uint32_t i = 0; i < passes * BANC_NB_TACHES; i++)
+		coroutine(&tachesBanc[i % BANC_NB_TACHES]);
+	direct = secondes() - direct;
+	ordonnance = secondes();
+	for (uint32_t i = 0; i < passes; i++)
+		TACHE_ordonnancer(tous);
+	ordonnance = secondes() - ordonnance;
+	vide = secondes();
+	for (uint32_t i = 0; i < passes; i++)
+		TACHE_ordonnancer(0);
+	vide = secondes() - vide;
+
+	printf("ordonnanceur          : %u taches dont %u reveillees a chaque passage, %u commutations, %u octets par tache\n", TACHE_get_nb(),
+		   BANC_NB_TACHES, passes * BANC_NB_TACHES, (unsigned)sizeof(tache_t));
+	printf("                        %.1f ns par commutation (hote, lectures DWT du simulateur comprises), reprise directe de la coroutine %.1f ns, passage sans tache prete %.1f ns\n",
+		   passes ? ordonnance * 1e9 / (passes * BANC_NB_TACHES) : 0.0, passes ? direct * 1e9 / (passes * BANC_NB_TACHES) : 0.0,
+		   passes ? vide * 1e9 / passes : 0.0);
+	TACHE_init();
+}
+
+#define BANC_NB_MINUTERIES 16		 /** @def Minuteries armees et annulees au hasard, chacune avec son callback*/
+#define BANC_DUREE_MINUTERIE 900000 /** @def Duree rejouee (ms) : plus de trois tours de la roue de 262 s*/
+
+typedef struct
+{
+	bool_e armee;
+	uint32_t echeance;
+	uint32_t periode;
+} modele_minuterie_t; /** @struct Etat attendu d'une minuterie, tenu a part de la roue*/
+
+static minuterie_t minuteriesBanc[BANC_NB_MINUTERIES];
+static modele_minuterie_t modeles[BANC_NB_MINUTERIES];
+static uint32_t armements, annulations, expirations;
+static uint32_t inattendues, manquees, etatsFaux, premierEcart;
+
+static void expirer(uint8_t);
+
+#define EXPIRATION(i)              \
+	static void expiration_##i(void) \
+	{                                \
+		expirer(i);                  \
+	}
+EXPIRATION(0)
+EXPIRATION(1)
+EXPIRATION(2)
+EXPIRATION(3)
+EXPIRATION(4)
+EXPIRATION(5)
+EXPIRATION(6)
+EXPIRATION(7)
+EXPIRATION(8)
+EXPIRATION(9)
+EXPIRATION(10)
+EXPIRATION(11)
+EXPIRATION(12)
+EXPIRATION(13)
+EXPIRATION(14)
+EXPIRATION(15)
+
+static const callback_fun_t callbacksBanc[BANC_NB_MINUTERIES] = {
+	&expiration_0, &expiration_1, &expiration_2, &expiration_3, &expiration_4, &expiration_5, &expiration_6, &expiration_7,
+	&expiration_8, &expiration_9, &expiration_10, &expiration_11, &expiration_12, &expiration_13, &expiration_14, &expiration_15};
+
+static void ecart(void)
+{
+	if (!premierEcart)
+		premierEcart = MINUTERIE_maintenant();
+}
+
+/**
+ * @brief Delai tire dans chaque niveau de la roue, sur ses bornes et au dela de sa portee
+ */
+static uint32_t tirer_delai(void)
+{
+	static const uint32_t bornes[] = {0, 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145};
+	double genre = SIM_alea();
+
+	if (genre < 0.3)
+		return (uint32_t)(SIM_alea() * 64.0);
+	if (genre < 0.6)
+		return 64 + (uint32_t)(SIM_alea() * 4032.0);
+	if (genre < 0.8)
+		return 4096 + (uint32_t)(SIM_alea() * 258048.0);
+	if (genre < 0.9)
+		return 262144 + (uint32_t)(SIM_alea() * 400000.0);
+	return bornes[(uint32_t)(SIM_alea() * (sizeof(bornes) / sizeof(bornes[0])))];
+}
+
+static void armer(uint8_t i)
+{
+	uint32_t delai = tirer_delai();
+	uint32_t periode = (SIM_alea() < 0.3) ? 1 + tirer_delai() : 0;
+
+	MINUTERIE_armer(&minuteriesBanc[i], delai, periode, callbacksBanc[i]);
+	modeles[i] = (modele_minuterie_t){TRUE, MINUTERIE_maintenant() + (delai ? delai : 1), periode};
+	armements++;
+}
+
+static void annuler(uint8_t i)
+{
+	MINUTERIE_annuler(&minuteriesBanc[i]);
+	modeles[i].armee = FALSE;
+	annulations++;
+}
+
+/**
+ * @brief Expiration vue par le modele, puis rearmement ou annulation au hasard depuis le callback
+ */
+static void expirer(uint8_t i)
+{
+	modele_minuterie_t *m = &modeles[i];
+	double action = SIM_alea();
+
+	expirations++;
+	if (!m->armee || m->echeance != MINUTERIE_maintenant())
+	{
+		inattendues++;
+		ecart();
+	}
+	else if (m->periode)
+		m->echeance += m->periode;
+	else
+		m->armee = FALSE;
+
+	if (action < 0.2)
+		armer(i); //rearmement de la minuterie en cours d'expiration
+	else if (action < 0.3)
+		armer((uint8_t)(SIM_alea() * BANC_NB_MINUTERIES));
+	else if (action < 0.4)
+		annuler((uint8_t)(SIM_alea() * BANC_NB_MINUTERIES)); //peut viser une minuterie de la meme case, pas encore appelee
+}
+
+/**
+ * @brief Banc de la roue des minuteries : nb armements et annulations repartis sur BANC_DUREE_MINUTERIE,
+ * 		delais sur tous les niveaux et leurs bornes, rearmements depuis les callbacks. Chaque expiration et
+ * 		l'etat arme de chaque minuterie sont compares a un modele de reference.
+ * @param nb : nombre d'armements et d'annulations depuis la boucle principale
+ */
+void SIM_banc_minuterie(uint32_t nb)
+{
+	uint32_t debut, fait = 0;
+	double duree;
+
+	SIM_horloge_init(UINT64_MAX); //l'armement masque les interruptions : le demasquage ne doit pas clore la simulation
+	REGISTRE_init();
+	MINUTERIE_init();
+	debut = MINUTERIE_maintenant();
+	armements = annulations = expirations = 0;
+	inattendues = manquees = etatsFaux = premierEcart = 0;
+
+	duree = secondes();
+	for (uint32_t t = 1; t <= BANC_DUREE_MINUTERIE; t++)
+	{
+		for (; fait < nb && (uint64_t)fait * BANC_DUREE_MINUTERIE < (uint64_t)nb * t; fait++)
+		{
+			uint8_t i = (uint8_t)(SIM_alea() * BANC_NB_MINUTERIES);
+			if (SIM_alea() < 0.7)
+				armer(i);
+			else
+				annuler(i);
+		}
+		SIM_systick_callbacks();
+		for (uint8_t i = 0; i < BANC_NB_MINUTERIES; i++)
+		{
+			if (modeles[i].armee && (int32_t)(modeles[i].echeance - MINUTERIE_maintenant()) <= 0)
+			{ //echeance passee sans appel : compte une seule fois
+				manquees++;
+				modeles[i].armee = FALSE;
+				ecart();
+			}
+			if (MINUTERIE_armee(&minuteriesBanc[i]) != modeles[i].armee)
+			{ //le modele reprend l'etat de la roue pour ne compter l'ecart qu'une fois
+				etatsFaux++;
+				ecart();
+				modeles[i] = (modele_minuterie_t){MINUTERIE_armee(&minuteriesBanc[i]), minuteriesBanc[i].echeance, minuteriesBanc[i].periode};
+			}
+		}
+	}
+	duree = secondes() - duree;
+	for (uint8_t i = 0; i < BANC_NB_MINUTERIES; i++)
+		MINUTERIE_annuler(&minuteriesBanc[i]);
+
+	printf("minuterie             : %u minuteries, %u armements, %u annulations, %u expirations sur %u s\n", BANC_NB_MINUTERIES, armements,
+		   annulations, expirations, (MINUTERIE_maintenant() - debut) / 1000);
+	printf("                        %u ecarts au modele (%u expirations inattendues, %u manquees, %u etats armes faux)", inattendues + manquees + etatsFaux,
+		   inattendues, manquees, etatsFaux);
+	if (premierEcart)
+		printf(", premier a %u ms", premierEcart - debut);
+	printf(", %.1f ns par tick (hote, modele compris)\n", duree * 1e9 / BANC_DUREE_MINUTERIE);
+}
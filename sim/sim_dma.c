@@ -0,0 +1,237 @@
+/**
+ ******************************************************************************
+ * @file 	sim_dma.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure du DMA1, deux canaux simules :
+ * 			- canal 7, emission UART2 : le transfert se termine apres le temps d'emission de ses octets,
+ * 			  sans consommer de temps CPU ; les octets peuvent etre captures pour outils/decodeur_journal.c.
+ * 			- canal 1, requete CC1 de TIM4 : un rapport cyclique par periode de porteuse, en mode circulaire,
+ * 			  avec interruptions de demi-tampon et de fin de tampon ; les valeurs sont transmises a sim_hp.c.
+ ******************************************************************************
+ */
+
+#include <stdlib.h>
+#include "stm32f1xx_hal.h"
+#include "sim.h"
+
+#define DRAPEAU_TC(canal) (1U << (4 * (canal) + 1))
+#define DRAPEAU_HT(canal) (1U << (4 * (canal) + 2))
+
+typedef struct
+{
+	DMA_HandleTypeDef *h;
+	bool_e actif;
+	uint8_t generation;	//invalide les evenements programmes avant un HAL_DMA_Abort
+	uint64_t debutCycle; //date du premier element du passage en cours (canal 1)
+	uint64_t periode_ns; //duree d'un element
+	uint32_t lus;		 //elements du passage en cours deja transmis a sim_hp.c
+} canal_t;
+
+USART_TypeDef SIM_usart[3];
+DMA_Channel_TypeDef SIM_dma1[7];
+
+void DMA1_Channel1_IRQHandler(void);
+void DMA1_Channel7_IRQHandler(void);
+
+static FILE *capture = NULL;
+static SIM_stat_dma_t stat;
+static canal_t canaux[7];
+static volatile uint32_t drapeaux = 0; //DMA1->ISR
+
+static uint8_t numero(DMA_HandleTypeDef *);
+static void fin_uart(uint32_t);
+static void etape_pcm(uint32_t);
+static void lire_pcm(canal_t *, uint32_t);
+
+static uint8_t numero(DMA_HandleTypeDef *hdma)
+{
+	return (uint8_t)(hdma->Instance - SIM_dma1);
+}
+
+/**
+ * @brief Enregistre les octets emis par le DMA de l'UART2 dans un fichier
+ * @param fichier : chemin du fichier, ecrase s'il existe
+ */
+void SIM_dma_capture(const char *fichier)
+{
+	capture = fopen(fichier, "wb");
+	if (capture == NULL)
+	{
+		perror(fichier);
+		exit(EXIT_FAILURE);
+	}
+}
+
+const SIM_stat_dma_t *SIM_dma_stat(void)
+{
+	return &stat;
+}
+
+/**
+ * @retval TRUE si le DMA alimente le rapport cyclique du HP
+ */
+bool_e SIM_dma_pcm_actif(void)
+{
+	return canaux[0].actif;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	(void)IRQn;
+	(void)PreemptPriority;
+	(void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	(void)IRQn;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	SIM_consommer(SIM_COUT_DMA_START);
+	hdma->State = HAL_DMA_STATE_READY;
+	hdma->XferCpltCallback = NULL;
+	hdma->XferHalfCpltCallback = NULL;
+	canaux[numero(hdma)].h = hdma;
+	return HAL_OK;
+}
+
+/**
+ * @brief Lance un transfert memoire vers peripherique : les elements sont lus a la date ou le
+ * 			peripherique les consomme, l'application ne doit pas les modifier avant
+ */
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+	uint8_t n = numero(hdma);
+	canal_t *c = &canaux[n];
+
+	if (hdma->State != HAL_DMA_STATE_READY)
+		return HAL_BUSY;
+	if (!(n == 6 && DstAddress == (uint32_t)(uintptr_t)&USART2->DR && (USART2->CR3 & USART_CR3_DMAT)) &&
+		!(n == 0 && DstAddress == (uint32_t)(uintptr_t)&TIM4->CCR1 && hdma->Init.Mode == DMA_CIRCULAR))
+	{
+		fprintf(stderr, "simu : seuls le DMA vers USART2->DR (canal 7) et vers TIM4->CCR1 (canal 1) sont simules\n");
+		return HAL_ERROR;
+	}
+	SIM_consommer(SIM_COUT_DMA_START);
+	hdma->State = HAL_DMA_STATE_BUSY;
+	hdma->Instance->CMAR = SrcAddress;
+	hdma->Instance->CPAR = DstAddress;
+	hdma->Instance->CNDTR = DataLength;
+	c->actif = TRUE;
+	c->generation++;
+	if (n == 6)
+		SIM_programmer(SIM_maintenant() + DataLength * SIM_uart_ns_par_caractere(), SIM_IT_DMA, &fin_uart, c->generation);
+	else
+	{
+		//Le son commence ici : le HP rattrape d'abord le mode carre jusqu'a cette date
+		SIM_hp_pcm(NULL, 0);
+		c->debutCycle = SIM_maintenant();
+		c->periode_ns = (uint64_t)(TIM4->PSC + 1) * (TIM4->ARR + 1) * 1000 / 72;
+		c->lus = 0;
+		SIM_programmer(c->debutCycle + DataLength / 2 * c->periode_ns, SIM_IT_DMA, &etape_pcm, c->generation);
+	}
+	return HAL_OK;
+}
+
+/**
+ * @brief Transmet a sim_hp.c les elements du tampon circulaire consommes jusqu'a un rang
+ */
+static void lire_pcm(canal_t *c, uint32_t jusqua)
+{
+	const uint8_t *source = (const uint8_t *)(uintptr_t)c->h->Instance->CMAR;
+
+	if (jusqua > c->lus)
+		SIM_hp_pcm(&source[c->lus], jusqua - c->lus);
+	c->lus = jusqua;
+}
+
+/**
+ * @brief Demi-tampon puis fin de tampon du canal 1, le transfert reprend au debut (mode circulaire)
+ */
+static void etape_pcm(uint32_t generation)
+{
+	canal_t *c = &canaux[0];
+	uint32_t nb = c->h->Instance->CNDTR;
+
+	if (!c->actif || generation != c->generation)
+		return;
+	if (c->lus < nb / 2)
+	{
+		lire_pcm(c, nb / 2);
+		drapeaux |= DRAPEAU_HT(0);
+		SIM_programmer(c->debutCycle + nb * c->periode_ns, SIM_IT_DMA, &etape_pcm, generation);
+	}
+	else
+	{
+		lire_pcm(c, nb);
+		drapeaux |= DRAPEAU_TC(0);
+		c->debutCycle += nb * c->periode_ns;
+		c->lus = 0;
+		SIM_programmer(c->debutCycle + nb / 2 * c->periode_ns, SIM_IT_DMA, &etape_pcm, generation);
+	}
+	DMA1_Channel1_IRQHandler();
+}
+
+/**
+ * @brief Dernier octet emis sur l'UART2 : recopie dans la capture puis interruption de fin de transfert
+ */
+static void fin_uart(uint32_t generation)
+{
+	const uint8_t *source = (const uint8_t *)(uintptr_t)DMA1_Channel7->CMAR;
+	uint32_t taille = DMA1_Channel7->CNDTR;
+
+	if (!canaux[6].actif || generation != canaux[6].generation)
+		return;
+	if (capture)
+		fwrite(source, 1, taille, capture);
+	stat.transferts++;
+	stat.octets += taille;
+	if (taille > stat.plusLong)
+		stat.plusLong = taille;
+	DMA1_Channel7->CNDTR = 0;
+	canaux[6].actif = FALSE;
+	drapeaux |= DRAPEAU_TC(6);
+	DMA1_Channel7_IRQHandler();
+}
+
+/**
+ * @brief Arret d'un transfert : pour le canal 1, les elements deja consommes sont transmis au HP
+ */
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+	uint8_t n = numero(hdma);
+	canal_t *c = &canaux[n];
+
+	SIM_consommer(SIM_COUT_GPIO);
+	if (c->actif && n == 0)
+		lire_pcm(c, MIN((uint32_t)((SIM_maintenant() - c->debutCycle) / c->periode_ns), hdma->Instance->CNDTR));
+	c->actif = FALSE;
+	c->generation++;
+	drapeaux &= ~(DRAPEAU_TC(n) | DRAPEAU_HT(n));
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+	uint8_t n = numero(hdma);
+
+	SIM_consommer(SIM_COUT_DMA_IT);
+	if (drapeaux & DRAPEAU_HT(n))
+	{
+		drapeaux &= ~DRAPEAU_HT(n);
+		if (hdma->XferHalfCpltCallback)
+			hdma->XferHalfCpltCallback(hdma);
+	}
+	if (drapeaux & DRAPEAU_TC(n))
+	{
+		drapeaux &= ~DRAPEAU_TC(n);
+		if (hdma->Init.Mode != DMA_CIRCULAR)
+			hdma->State = HAL_DMA_STATE_READY;
+		if (hdma->XferCpltCallback)
+			hdma->XferCpltCallback(hdma);
+	}
+}
@@ -0,0 +1,358 @@
+/**
+ ******************************************************************************
+ * @file 	sim_hcsr04.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Modele des modules HC-SR04 : temps de vol calcule dans le monde simule,
+ * 			bruit, pertes d'echo et diaphonie. Le modele est pilote soit par la doublure
+ * 			du pilote HCSR04 de la librairie (fronts d'echo servis en interruption EXTI),
+ * 			soit directement par les broches TRIG, l'echo etant alors date par les
+ * 			entrees de capture des timers simules.
+ ******************************************************************************
+ */
+
+#include "HC-SR04/HCSR04.h"
+#include "sim.h"
+
+#define DELAI_SALVE_US 460		  /** @def Impulsion de declenchement + salve de 8 periodes a 40 kHz*/
+#define ECHO_SANS_CIBLE_US 38000  /** @def Largeur d'echo renvoyee par le module en l'absence de cible*/
+#define US_PAR_MM (2.0 / 0.343)	  /** @def Aller-retour du son a 343 m/s*/
+#define FENETRE_DIAPHONIE_US 40000 /** @def Duree pendant laquelle une salve peut encore etre entendue par un voisin*/
+
+typedef enum
+{
+	PILOTE_INEXISTANT = 0,
+	PILOTE_REPOS,
+	PILOTE_MESURE
+} etat_pilote_e;
+
+typedef struct
+{
+	bool_e perdu;		 //l'echo de la derniere salve ne reviendra pas
+	uint64_t salve;		 //date d'emission de la salve
+	uint64_t vol;		 //temps de vol propre de la salve (ns), 0 si aucune cible
+	uint64_t finEcho;	 //date du front descendant de l'echo
+	bool_e tronque;		 //echo raccourci par la salve d'un voisin
+	bool_e lu;			 //l'application a deja lu cet echo
+	uint64_t dateMontee; //date a laquelle le pilote a date le front montant (service de l'interruption)
+	uint64_t dateDescente;
+	SIM_stat_capteur_t stat;
+} module_t; /** @struct Etat physique d'un module ultrason*/
+
+typedef struct
+{
+	etat_pilote_e etat;
+	SIM_capteur_e capteur;
+} pilote_t; /** @struct Capteur enregistre aupres de la doublure du pilote HCSR04*/
+
+typedef struct
+{
+	GPIO_TypeDef *trigGpio;
+	uint16_t trigPin;
+	SIM_capteur_e capteur;
+	GPIO_TypeDef *echoGpio; //entree de capture, voir appli/capteur/echo.c
+	uint16_t echoPin;
+	TIM_TypeDef *tim;
+	uint8_t canalMontee; //le front descendant est capture sur le canal suivant
+} cablage_t;
+
+//Cablage de la voiture : broches TRIG de capteur.c et entrees de capture des echos
+static const cablage_t cablage[SIM_CAPTEUR_NB] = {
+	{GPIOA, GPIO_PIN_4, SIM_CAPTEUR_AVANT, GPIOA, GPIO_PIN_0, TIM2, 1},
+	{GPIOA, GPIO_PIN_5, SIM_CAPTEUR_DROITE, GPIOB, GPIO_PIN_4, TIM3, 1},
+	{GPIOA, GPIO_PIN_6, SIM_CAPTEUR_GAUCHE, GPIOB, GPIO_PIN_10, TIM2, 3},
+	{GPIOA, GPIO_PIN_7, SIM_CAPTEUR_ARRIERE, GPIOB, GPIO_PIN_0, TIM3, 3},
+};
+
+static module_t modules[SIM_CAPTEUR_NB];
+static pilote_t pilotes[HCSR04_NB_SENSORS];
+static uint8_t nbPilotes = 0;
+static double probaDiaphonie = 0.3;
+static double probaPerte = 0.0;
+static double bruit = 3.0;
+
+static void front_montant(uint32_t);
+static void front_descendant(uint32_t);
+static void mesurer_ecart(module_t *, uint64_t);
+static void echo_montant(uint32_t);
+static void echo_descendant(uint32_t);
+static bool_e voisins(SIM_capteur_e, SIM_capteur_e);
+static void diaphonie(SIM_capteur_e, SIM_capteur_e);
+static bool_e declencher(SIM_capteur_e, uint64_t);
+static void marquer_lu(module_t *);
+
+/**
+ * @brief Regle les imperfections du modele
+ * @param d : probabilite qu'un capteur voisin entende la salve d'un autre
+ * @param p : probabilite qu'un echo soit perdu (la mesure finit en timeout)
+ * @param b : amplitude du bruit uniforme sur la distance (mm)
+ */
+void SIM_hcsr04_config(double d, double p, double b)
+{
+	probaDiaphonie = d;
+	probaPerte = p;
+	bruit = b;
+}
+
+const SIM_stat_capteur_t *SIM_hcsr04_stat(SIM_capteur_e capteur)
+{
+	return &modules[capteur].stat;
+}
+
+/**
+ * @brief Deux capteurs a 90 degres peuvent s'entendre, l'avant et l'arriere non
+ */
+static bool_e voisins(SIM_capteur_e a, SIM_capteur_e b)
+{
+	if (a == b)
+		return FALSE;
+	if ((a == SIM_CAPTEUR_AVANT && b == SIM_CAPTEUR_ARRIERE) || (a == SIM_CAPTEUR_ARRIERE && b == SIM_CAPTEUR_AVANT))
+		return FALSE;
+	if ((a == SIM_CAPTEUR_DROITE && b == SIM_CAPTEUR_GAUCHE) || (a == SIM_CAPTEUR_GAUCHE && b == SIM_CAPTEUR_DROITE))
+		return FALSE;
+	return TRUE;
+}
+
+/**
+ * @brief Si l'echo de la salve d'un voisin arrive pendant l'ecoute de la cible, l'echo de la cible est tronque
+ */
+static void diaphonie(SIM_capteur_e c, SIM_capteur_e v)
+{
+	module_t *cible = &modules[c];
+	const module_t *voisin = &modules[v];
+	uint64_t debutEcoute = cible->salve + DELAI_SALVE_US * SIM_NS_PAR_US;
+	uint64_t arrivee;
+
+	if (!voisins(c, v) || voisin->vol == 0 || voisin->salve == 0)
+		return;
+	if (voisin->salve + FENETRE_DIAPHONIE_US * SIM_NS_PAR_US < cible->salve)
+		return;
+	arrivee = voisin->salve + DELAI_SALVE_US * SIM_NS_PAR_US + voisin->vol;
+	if (arrivee > debutEcoute && arrivee < cible->finEcho && SIM_alea() < probaDiaphonie)
+	{
+		cible->finEcho = arrivee;
+		cible->tronque = TRUE;
+	}
+}
+
+/**
+ * @brief Emission d'une salve par un module
+ * @param c : position du capteur
+ * @param salve : date d'emission
+ * @retval FALSE si le module emet encore l'echo de la salve precedente et ignore le declenchement
+ */
+static bool_e declencher(SIM_capteur_e c, uint64_t salve)
+{
+	module_t *m = &modules[c];
+	double d;
+	uint64_t largeur;
+
+	if (SIM_maintenant() < m->finEcho)
+		return FALSE;
+
+	m->stat.lancees++;
+	m->salve = salve;
+	d = SIM_monde_distance(c);
+	if (d >= 0.0)
+	{
+		d += (SIM_alea() * 2.0 - 1.0) * bruit;
+		if (d < 20.0)
+			d = 20.0;
+		m->vol = (uint64_t)(d * US_PAR_MM * SIM_NS_PAR_US);
+		largeur = m->vol;
+	}
+	else
+	{
+		m->vol = 0;
+		largeur = ECHO_SANS_CIBLE_US * SIM_NS_PAR_US;
+	}
+	m->finEcho = m->salve + DELAI_SALVE_US * SIM_NS_PAR_US + largeur;
+	m->tronque = FALSE;
+	m->lu = FALSE;
+	m->dateDescente = 0;
+	m->perdu = (SIM_alea() < probaPerte);
+
+	for (SIM_capteur_e v = 0; v < SIM_CAPTEUR_NB; v++)
+	{
+		if (v == c)
+			continue;
+		diaphonie(c, v);
+		if (!modules[v].perdu && SIM_maintenant() < modules[v].finEcho)
+			diaphonie(v, c);
+	}
+	if (!m->perdu)
+		m->stat.echos++;
+	else
+	{
+		m->stat.perdus++;
+		m->finEcho = m->salve + ECHO_SANS_CIBLE_US * SIM_NS_PAR_US; //le module rend la main sans front exploitable
+	}
+	return TRUE;
+}
+
+/**
+ * @brief Comptabilise la lecture d'un echo par l'application
+ */
+static void marquer_lu(module_t *m)
+{
+	if (m->lu)
+		return;
+	m->lu = TRUE;
+	m->stat.lues++;
+	if (m->tronque)
+		m->stat.diaphoniesLues++;
+}
+
+/**
+ * @brief Routine EXTI du pilote : le front est date a l'instant ou la routine s'execute,
+ * 			donc en retard si une autre interruption etait en cours
+ */
+static void front_montant(uint32_t id)
+{
+	modules[pilotes[id].capteur].dateMontee = SIM_maintenant();
+	SIM_consommer(SIM_COUT_HCSR04_FRONT);
+}
+
+static void front_descendant(uint32_t id)
+{
+	modules[pilotes[id].capteur].dateDescente = SIM_maintenant();
+	SIM_consommer(SIM_COUT_HCSR04_FRONT);
+}
+
+/**
+ * @brief Compare la largeur d'echo vue par l'application a la largeur emise par le module
+ * @param largeur_ns : largeur mesuree
+ */
+static void mesurer_ecart(module_t *m, uint64_t largeur_ns)
+{
+	uint64_t vraie = m->finEcho - m->salve - DELAI_SALVE_US * SIM_NS_PAR_US;
+	uint32_t ecart = (uint32_t)((largeur_ns > vraie ? largeur_ns - vraie : vraie - largeur_ns) / SIM_NS_PAR_US);
+
+	if (ecart > m->stat.ecartMax_us)
+		m->stat.ecartMax_us = ecart;
+	m->stat.ecartTotal_us += ecart;
+}
+
+HAL_StatusTypeDef HCSR04_add(uint8_t *id, GPIO_TypeDef *TRIG_GPIO, uint16_t TRIG_PIN, GPIO_TypeDef *ECHO_GPIO, uint16_t ECHO_PIN)
+{
+	(void)ECHO_GPIO;
+	(void)ECHO_PIN;
+	if (nbPilotes >= HCSR04_NB_SENSORS)
+		return HAL_ERROR;
+	for (uint8_t i = 0; i < SIM_CAPTEUR_NB; i++)
+	{
+		if (cablage[i].trigGpio == TRIG_GPIO && cablage[i].trigPin == TRIG_PIN)
+		{
+			pilotes[nbPilotes].etat = PILOTE_REPOS;
+			pilotes[nbPilotes].capteur = cablage[i].capteur;
+			*id = nbPilotes++;
+			return HAL_OK;
+		}
+	}
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HCSR04_run_measure(uint8_t id)
+{
+	module_t *m;
+
+	SIM_consommer(SIM_COUT_HCSR04_RUN);
+	if (id >= nbPilotes)
+		return HAL_ERROR;
+	if (!declencher(pilotes[id].capteur, SIM_maintenant() + 10 * SIM_NS_PAR_US))
+		return HAL_BUSY;
+
+	pilotes[id].etat = PILOTE_MESURE;
+	m = &modules[pilotes[id].capteur];
+	if (!m->perdu)
+	{
+		SIM_programmer(m->salve + DELAI_SALVE_US * SIM_NS_PAR_US, SIM_IT_EXTI, &front_montant, id);
+		SIM_programmer(m->finEcho, SIM_IT_EXTI, &front_descendant, id);
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HCSR04_get_value(uint8_t id, uint16_t *distance)
+{
+	module_t *m;
+
+	SIM_consommer(SIM_COUT_HCSR04_GET);
+	if (id >= nbPilotes || pilotes[id].etat != PILOTE_MESURE)
+		return HAL_ERROR;
+	m = &modules[pilotes[id].capteur];
+	if (m->perdu)
+	{
+		if (SIM_maintenant() < m->salve + HCSR04_TIMEOUT * SIM_NS_PAR_MS)
+			return HAL_BUSY;
+		pilotes[id].etat = PILOTE_REPOS;
+		m->stat.timeouts++;
+		return HAL_TIMEOUT;
+	}
+	if (SIM_maintenant() < m->finEcho || m->dateDescente < m->dateMontee)
+		return HAL_BUSY;
+	*distance = (uint16_t)((m->dateDescente - m->dateMontee) / SIM_NS_PAR_US * 10 / 58);
+	pilotes[id].etat = PILOTE_REPOS;
+	if (!m->lu)
+		mesurer_ecart(m, m->dateDescente - m->dateMontee);
+	marquer_lu(m);
+	return HAL_OK;
+}
+
+/**
+ * @brief Le pilote reel gere ici la fin d'impulsion TRIG et les timeouts
+ */
+void HCSR04_process_main(void)
+{
+	SIM_consommer(SIM_COUT_HCSR04_MAIN);
+}
+
+static void echo_montant(uint32_t c)
+{
+	cablage[c].echoGpio->IDR |= cablage[c].echoPin;
+	SIM_tim_capture(cablage[c].tim, cablage[c].canalMontee);
+}
+
+static void echo_descendant(uint32_t c)
+{
+	cablage[c].echoGpio->IDR &= ~(uint32_t)cablage[c].echoPin;
+	SIM_tim_capture(cablage[c].tim, cablage[c].canalMontee + 1);
+}
+
+/**
+ * @brief Ecriture applicative sur une broche : un front descendant sur une broche TRIG declenche le module
+ * @param gpio : port ecrit
+ * @param pin : broche ecrite
+ * @param avant : niveau de la broche avant l'ecriture
+ * @param apres : niveau de la broche apres l'ecriture
+ */
+void SIM_hcsr04_gpio(GPIO_TypeDef *gpio, uint16_t pin, bool_e avant, bool_e apres)
+{
+	for (uint8_t c = 0; c < SIM_CAPTEUR_NB; c++)
+	{
+		if (cablage[c].trigGpio != gpio || !(cablage[c].trigPin & pin) || !avant || apres)
+			continue;
+		if (declencher(cablage[c].capteur, SIM_maintenant()) && !modules[c].perdu)
+		{
+			SIM_programmer(modules[c].salve + DELAI_SALVE_US * SIM_NS_PAR_US, SIM_IT_MATERIEL, &echo_montant, c);
+			SIM_programmer(modules[c].finEcho, SIM_IT_MATERIEL, &echo_descendant, c);
+		}
+	}
+}
+
+/**
+ * @brief Lecture par l'application d'un registre de capture : une lecture du canal de front descendant vaut lecture de l'echo
+ */
+void SIM_hcsr04_capture_lue(TIM_TypeDef *tim, uint8_t canal)
+{
+	for (uint8_t c = 0; c < SIM_CAPTEUR_NB; c++)
+	{
+		if (cablage[c].tim == tim && cablage[c].canalMontee + 1 == canal && SIM_maintenant() >= modules[c].finEcho && !modules[c].lu)
+		{
+			const volatile uint32_t *ccr = &tim->CCR1 + (cablage[c].canalMontee - 1);
+			uint16_t largeur = (uint16_t)(ccr[1] - ccr[0]); //en us avec le prediviseur de echo.c
+
+			mesurer_ecart(&modules[c], (uint64_t)largeur * SIM_NS_PAR_US);
+			marquer_lu(&modules[c]);
+		}
+	}
+}
@@ -0,0 +1,467 @@
+/**
+ ******************************************************************************
+ * @file 	sim_horloge.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Horloge virtuelle du simulateur, file des interruptions simulees,
+ * 			doublures de la HAL, du Systick, des GPIO et de l'UART
+ ******************************************************************************
+ */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include "stm32f1xx_hal.h"
+#include "stm32f1_gpio.h"
+#include "stm32f1_sys.h"
+#include "systick.h"
+#include "sim.h"
+
+#define SIM_NB_EVENEMENTS 32
+#define SIM_NS_PAR_CARACTERE(baud) (10ULL * 1000000000ULL / (baud)) /** @def 1 start + 8 donnees + 1 stop*/
+
+typedef struct
+{
+	uint64_t date;
+	SIM_handler_t handler;
+	uint32_t arg;
+	SIM_it_e source;
+	bool_e actif;
+} evenement_t;
+
+GPIO_TypeDef SIM_gpio[3];
+CoreDebug_Type SIM_coreDebug;
+jmp_buf SIM_fin_simulation;
+
+static uint64_t maintenant = 0;
+static uint64_t fin = 0;
+static bool_e enInterruption = FALSE;
+static bool_e masque = FALSE; //PRIMASK
+static uint64_t sommeil = 0;  //temps passe en WFI
+static DWT_Type dwt;
+static uint64_t dateEvenement = 0;
+static evenement_t evenements[SIM_NB_EVENEMENTS];
+static uint64_t prochaineDate = UINT64_MAX; //date du prochain evenement, evite de parcourir la file a chaque appel
+static SIM_stat_it_t statIt[SIM_IT_NB];
+
+static volatile uint32_t tick = 0;
+static callback_fun_t callbacks[MAX_CALLBACK_FUNCTION_NB];
+static uint8_t maxCallbacks = 0;
+
+static uint64_t derniereIteration = 0;
+static uint64_t periodeMax = 0;
+static uint64_t periodeTotal = 0;
+static uint32_t nbIterations = 0;
+
+static uint32_t baudrate = 115200;
+static uint32_t nbCaracteres = 0;
+static bool_e verbeux = FALSE;
+
+static void systick_handler(uint32_t);
+static void lancer_interruption(evenement_t *);
+static evenement_t *prochain_evenement(void);
+
+/**
+ * @brief Initialise l'horloge virtuelle
+ * @param fin_ns : date virtuelle a laquelle la simulation s'arrete (longjmp vers SIM_fin_simulation)
+ */
+void SIM_horloge_init(uint64_t fin_ns)
+{
+	maintenant = 0;
+	fin = fin_ns;
+	SIM_programmer(SIM_NS_PAR_MS, SIM_IT_SYSTICK, &systick_handler, 0);
+}
+
+/**
+ * @retval la date virtuelle courante en ns
+ */
+uint64_t SIM_maintenant(void)
+{
+	return maintenant;
+}
+
+/**
+ * @retval TRUE si le code en cours s'execute dans une interruption simulee
+ */
+bool_e SIM_en_interruption(void)
+{
+	return enInterruption;
+}
+
+/**
+ * @brief Programme une interruption simulee
+ * @param date_ns : date a laquelle l'interruption se declenche
+ * @param source : source de l'interruption, sert aux statistiques
+ * @param handler : routine appelee
+ * @param arg : argument transmis a la routine
+ */
+void SIM_programmer(uint64_t date_ns, SIM_it_e source, SIM_handler_t handler, uint32_t arg)
+{
+	for (uint8_t i = 0; i < SIM_NB_EVENEMENTS; i++)
+	{
+		if (!evenements[i].actif)
+		{
+			evenements[i] = (evenement_t){date_ns, handler, arg, source, TRUE};
+			if (date_ns < prochaineDate)
+				prochaineDate = date_ns;
+			return;
+		}
+	}
+	fprintf(stderr, "simu : file des interruptions pleine\n");
+}
+
+/**
+ * @brief Recherche l'evenement le plus proche et met a jour prochaineDate
+ * @retval l'evenement, ou NULL si la file est vide
+ */
+static evenement_t *prochain_evenement(void)
+{
+	evenement_t *prochain = NULL;
+	for (uint8_t i = 0; i < SIM_NB_EVENEMENTS; i++)
+	{
+		if (evenements[i].actif && (prochain == NULL || evenements[i].date < prochain->date))
+			prochain = &evenements[i];
+	}
+	prochaineDate = prochain ? prochain->date : UINT64_MAX;
+	return prochain;
+}
+
+/**
+ * @brief Execute une interruption et mesure son cout
+ */
+static void lancer_interruption(evenement_t *ev)
+{
+	evenement_t it = *ev; //la place peut etre reutilisee par la routine elle-meme
+	uint64_t debut = maintenant;
+	uint64_t duree;
+
+	ev->actif = FALSE;
+	dateEvenement = it.date;
+	if (it.source == SIM_IT_MATERIEL)
+	{ //Le materiel agit a la date exacte de l'evenement, sans voler de temps au CPU
+		it.handler(it.arg);
+		return;
+	}
+	enInterruption = TRUE;
+	maintenant += SIM_COUT_ENTREE_IT;
+	it.handler(it.arg);
+	enInterruption = FALSE;
+
+	duree = maintenant - debut;
+	statIt[it.source].nb++;
+	statIt[it.source].total_ns += duree;
+	if (duree > statIt[it.source].max_ns)
+		statIt[it.source].max_ns = duree;
+}
+
+/**
+ * @brief Consomme du temps CPU virtuel. Hors interruption, les interruptions
+ * 			dont la date est atteinte preemptent le calcul en cours.
+ * @param ns : duree a consommer
+ */
+void SIM_consommer(uint32_t ns)
+{
+	uint64_t reste = ns;
+
+	if (enInterruption || masque)
+	{ //Pas d'imbrication : les interruptions arrivees entre-temps seront servies au retour ou au demasquage
+		maintenant += ns;
+		return;
+	}
+
+	while (prochaineDate <= maintenant + reste)
+	{
+		evenement_t *prochain = prochain_evenement();
+		if (prochain->date > maintenant)
+		{
+			reste -= prochain->date - maintenant;
+			maintenant = prochain->date;
+		}
+		lancer_interruption(prochain);
+		prochain_evenement();
+	}
+	maintenant += reste;
+
+	if (maintenant >= fin)
+		longjmp(SIM_fin_simulation, 1);
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return masque ? 1 : 0;
+}
+
+void __disable_irq(void)
+{
+	masque = TRUE;
+}
+
+/**
+ * @brief Demasquage : les interruptions arrivees pendant le masquage sont servies immediatement
+ */
+void __enable_irq(void)
+{
+	masque = FALSE;
+	SIM_consommer(0);
+}
+
+/**
+ * @brief Veille jusqu'a la prochaine interruption. Interruptions masquees, le coeur se reveille
+ * 			sans executer la routine, qui le sera au demasquage.
+ */
+void __WFI(void)
+{
+	uint64_t reveil = prochain_evenement() ? prochaineDate : fin;
+
+	if (reveil > maintenant)
+	{
+		sommeil += reveil - maintenant;
+		if (masque)
+			maintenant = reveil;
+		else
+			SIM_consommer((uint32_t)(reveil - maintenant));
+	}
+	if (maintenant >= fin)
+		longjmp(SIM_fin_simulation, 1);
+}
+
+/**
+ * @retval le temps total passe par le coeur en veille (WFI)
+ */
+uint64_t SIM_sommeil_ns(void)
+{
+	return sommeil;
+}
+
+DWT_Type *SIM_dwt(void)
+{
+	if (dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+		dwt.CYCCNT = (uint32_t)(maintenant * 72 / SIM_NS_PAR_US);
+	return &dwt;
+}
+
+/**
+ * @retval la date programmee de l'evenement en cours de traitement, les interruptions pouvant etre servies en retard
+ */
+uint64_t SIM_date_evenement(void)
+{
+	return dateEvenement;
+}
+
+/**
+ * @retval les statistiques d'execution des interruptions de la source donnee
+ */
+const SIM_stat_it_t *SIM_stat_it(SIM_it_e source)
+{
+	return &statIt[source];
+}
+
+/**
+ * @brief Routine d'interruption du Systick : avance le monde d'une ms puis appelle les callbacks
+ */
+static void systick_handler(uint32_t arg)
+{
+	(void)arg;
+	tick++;
+	SIM_monde_pas_ms();
+	SIM_hp_pas_ms();
+	for (uint8_t i = 0; i < MAX_CALLBACK_FUNCTION_NB; i++)
+	{
+		SIM_consommer(SIM_COUT_APPEL_CALLBACK);
+		if (callbacks[i])
+			(*callbacks[i])();
+	}
+	SIM_programmer(((uint64_t)tick + 1) * SIM_NS_PAR_MS, SIM_IT_SYSTICK, &systick_handler, 0);
+}
+
+/**
+ * @brief Iteration d'une boucle de main.c : consomme son cout et mesure la periode de boucle
+ */
+void SIM_iteration(void)
+{
+	if (nbIterations)
+	{
+		uint64_t p = maintenant - derniereIteration;
+		periodeTotal += p;
+		if (p > periodeMax)
+			periodeMax = p;
+	}
+	nbIterations++;
+	derniereIteration = maintenant;
+	SIM_consommer(SIM_COUT_ITERATION);
+}
+
+uint64_t SIM_boucle_periode_max_ns(void)
+{
+	return periodeMax;
+}
+
+uint64_t SIM_boucle_periode_moy_ns(void)
+{
+	return (nbIterations > 1) ? periodeTotal / (nbIterations - 1) : 0;
+}
+
+void Systick_init(void)
+{
+}
+
+/**
+ * @brief Meme semantique que la librairie : premiere place libre, doublons acceptes
+ */
+bool_e Systick_add_callback_function(callback_fun_t func)
+{
+	uint8_t nb = 0;
+	bool_e ret = FALSE;
+	for (uint8_t i = 0; i < MAX_CALLBACK_FUNCTION_NB; i++)
+	{
+		if (!ret && !callbacks[i])
+		{
+			callbacks[i] = func;
+			ret = TRUE;
+		}
+		if (callbacks[i])
+			nb++;
+	}
+	if (nb > maxCallbacks)
+		maxCallbacks = nb;
+	return ret;
+}
+
+bool_e Systick_remove_callback_function(callback_fun_t func)
+{
+	for (uint8_t i = 0; i < MAX_CALLBACK_FUNCTION_NB; i++)
+	{
+		if (callbacks[i] == func)
+		{
+			callbacks[i] = NULL;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+ * @brief Tick reduit aux callbacks, sans avancer le monde ni l'horloge virtuelle : fait tourner
+ * 			les bases de temps de l'application dans les bancs d'essai, en contexte d'interruption
+ */
+void SIM_systick_callbacks(void)
+{
+	enInterruption = TRUE;
+	tick++;
+	for (uint8_t i = 0; i < MAX_CALLBACK_FUNCTION_NB; i++)
+	{
+		if (callbacks[i])
+			(*callbacks[i])();
+	}
+	enInterruption = FALSE;
+}
+
+/**
+ * @retval le nombre maximal de callbacks Systick enregistres simultanement
+ */
+uint8_t SIM_systick_max_callbacks(void)
+{
+	return maxCallbacks;
+}
+
+void HAL_Init(void)
+{
+	Systick_init();
+}
+
+uint32_t HAL_GetTick(void)
+{
+	SIM_consommer(SIM_COUT_GETTICK);
+	return tick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	uint32_t debut = HAL_GetTick();
+	while (HAL_GetTick() - debut < Delay)
+		continue;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	bool_e avant = (GPIOx->ODR & GPIO_Pin) ? TRUE : FALSE;
+
+	SIM_consommer(SIM_COUT_GPIO);
+	if (PinState == GPIO_PIN_RESET)
+		GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+	else
+		GPIOx->ODR |= GPIO_Pin;
+	SIM_hcsr04_gpio(GPIOx, GPIO_Pin, avant, (PinState == GPIO_PIN_RESET) ? FALSE : TRUE);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	SIM_consommer(SIM_COUT_GPIO);
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void BSP_GPIO_PinCfg(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin, uint32_t GPIO_Mode, uint32_t GPIO_Pull, uint32_t GPIO_Speed)
+{
+	(void)GPIOx;
+	(void)GPIO_Pin;
+	(void)GPIO_Mode;
+	(void)GPIO_Pull;
+	(void)GPIO_Speed;
+	SIM_consommer(SIM_COUT_GPIO);
+}
+
+void UART_init(uart_id_e uart_id, uint32_t baud)
+{
+	(void)uart_id;
+	baudrate = baud;
+}
+
+void SYS_set_std_usart(uart_id_e in, uart_id_e out, uart_id_e err)
+{
+	(void)in;
+	(void)out;
+	(void)err;
+}
+
+/**
+ * @brief printf de l'application : l'emission UART est bloquante, chaque caractere
+ * 			coute son temps de transmission au debit configure
+ */
+int SIM_printf(const char *format, ...)
+{
+	char buffer[256];
+	va_list args;
+	int n;
+
+	va_start(args, format);
+	n = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	if (n < 0)
+		return n;
+	if (n >= (int)sizeof(buffer))
+		n = sizeof(buffer) - 1;
+
+	if (verbeux)
+		fprintf(stdout, "[%10.3f ms] %s", (double)maintenant / SIM_NS_PAR_MS, buffer);
+	nbCaracteres += n;
+	for (int i = 0; i < n; i++)
+		SIM_consommer(SIM_NS_PAR_CARACTERE(baudrate));
+	return n;
+}
+
+uint32_t SIM_uart_nb_caracteres(void)
+{
+	return nbCaracteres;
+}
+
+/**
+ * @retval la duree d'emission d'un caractere au debit configure, en ns
+ */
+uint64_t SIM_uart_ns_par_caractere(void)
+{
+	return SIM_NS_PAR_CARACTERE(baudrate);
+}
+
+void SIM_set_verbeux(bool_e v)
+{
+	verbeux = v;
+}
@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ * @file 	sim_hp.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Observation du haut-parleur (TIM4 canal 1) et capture de sa sortie dans un WAV :
+ * 			en mode carre la sortie est reconstituee chaque ms a partir de ARR et CCR1,
+ * 			en mode PCM le WAV recoit les rapports cycliques ecrits par le DMA.
+ * @note	Le WAV est echantillonne a la frequence de la porteuse PCM, sur 8 bits : 0 broche basse,
+ * 			255 broche haute en permanence.
+ ******************************************************************************
+ */
+
+#include <stdlib.h>
+#include "stm32f1xx_hal.h"
+#include "sim.h"
+
+static SIM_stat_hp_t stat;
+static uint32_t periode = 0;	   //periode jouee en mode carre (en us), 0 : silence
+static uint32_t rapport = 0;	   //part de la periode a l'etat haut (en us)
+static bool_e verbeux = FALSE;
+static FILE *wav = NULL;
+static uint64_t ecrits = 0; //echantillons ecrits dans le WAV
+static double phase = 0.0;	//position dans la periode du signal carre (en us)
+
+static void ecrire32(uint32_t, long);
+static void carre_jusqua(uint64_t);
+
+void SIM_hp_verbeux(bool_e v)
+{
+	verbeux = v;
+}
+
+static void ecrire32(uint32_t valeur, long position)
+{
+	uint8_t o[4] = {valeur, valeur >> 8, valeur >> 16, valeur >> 24};
+	fseek(wav, position, SEEK_SET);
+	fwrite(o, 1, 4, wav);
+}
+
+/**
+ * @brief Ouvre la capture : entete WAV PCM mono 8 bits, les tailles sont ecrites par SIM_hp_fermer
+ */
+void SIM_hp_wav(const char *fichier)
+{
+	static const uint8_t entete[44] = {
+		'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 1, 0,
+		SIM_HP_FREQUENCE_WAV & 0xFF, (SIM_HP_FREQUENCE_WAV >> 8) & 0xFF, 0, 0,
+		SIM_HP_FREQUENCE_WAV & 0xFF, (SIM_HP_FREQUENCE_WAV >> 8) & 0xFF, 0, 0, 1, 0, 8, 0, 'd', 'a', 't', 'a', 0, 0, 0, 0};
+
+	wav = fopen(fichier, "wb");
+	if (wav == NULL)
+	{
+		perror(fichier);
+		exit(EXIT_FAILURE);
+	}
+	fwrite(entete, 1, sizeof(entete), wav);
+}
+
+/**
+ * @brief Complete le WAV avec le signal carre courant jusqu'a une date
+ */
+static void carre_jusqua(uint64_t date_ns)
+{
+	uint64_t cible = date_ns * SIM_HP_FREQUENCE_WAV / 1000000000ULL;
+	const double pas_us = 1e6 / SIM_HP_FREQUENCE_WAV;
+
+	for (; ecrits < cible; ecrits++)
+	{
+		uint8_t e = 0;
+		if (periode)
+		{
+			e = (phase < rapport) ? 255 : 0;
+			phase += pas_us;
+			while (phase >= periode)
+				phase -= periode;
+		}
+		if (wav)
+			fputc(e, wav);
+	}
+}
+
+/**
+ * @brief Rapports cycliques consommes par le DMA (porteuse a ARR = 255)
+ * @param rapports : valeurs dans l'ordre de sortie, NULL pour seulement rattraper le mode carre
+ */
+void SIM_hp_pcm(const uint8_t *rapports, uint32_t nb)
+{
+	if (rapports == NULL)
+	{
+		carre_jusqua(SIM_maintenant());
+		return;
+	}
+	stat.echantillonsPcm += nb;
+	ecrits += nb;
+	if (wav)
+		fwrite(rapports, 1, nb, wav);
+}
+
+/**
+ * @brief Releve la note jouee en mode carre, telle qu'elle sort apres prechargement des registres de TIM4
+ */
+void SIM_hp_pas_ms(void)
+{
+	uint32_t p = 0;
+
+	if (SIM_dma_pcm_actif())
+	{
+		stat.sonore_ms++;
+		periode = 0;
+		return;
+	}
+	//La ms ecoulee a ete jouee avec l'etat releve au tick precedent
+	carre_jusqua(SIM_maintenant());
+	if (TIM4->CCR1 && (TIM4->CR1 & TIM_CR1_CEN))
+		p = (TIM4->ARR + 1) * (TIM4->PSC + 1) / 72;
+	if (p)
+	{
+		stat.sonore_ms++;
+		rapport = TIM4->CCR1 * (TIM4->PSC + 1) / 72;
+	}
+	if (p == periode)
+		return;
+	periode = p;
+	phase = 0.0;
+	stat.changements++;
+	if (verbeux)
+		fprintf(stdout, "[%10.3f ms] hp : %s %u us\n", (double)SIM_maintenant() / SIM_NS_PAR_MS, p ? "periode" : "silence", p);
+}
+
+/**
+ * @brief Termine la capture a la date de fin de simulation
+ */
+void SIM_hp_fermer(void)
+{
+	if (wav == NULL)
+		return;
+	if (!SIM_dma_pcm_actif())
+		carre_jusqua(SIM_maintenant());
+	ecrire32((uint32_t)(36 + ecrits), 4);
+	ecrire32((uint32_t)ecrits, 40);
+	fclose(wav);
+	wav = NULL;
+}
+
+const SIM_stat_hp_t *SIM_hp_stat(void)
+{
+	return &stat;
+}
@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ * @file 	sim_i2c.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure de I2C1 et d'un MPU6050 : les ecritures bloquantes consomment leur
+ * 			temps de bus, les lectures sous interruption se terminent apres le leur.
+ * 			La vitesse de lacet rendue est celle du monde, a travers le filtre passe-bas
+ * 			du composant, avec un biais et un bruit, a +/- 500 dps.
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include "stm32f1xx_hal.h"
+#include "sim.h"
+
+#define ADRESSE_MPU6050 (0x68 << 1)
+#define REG_GYRO_CONFIG 0x1B
+#define REG_LACET 0x47
+#define REG_PWR_MGMT_1 0x6B
+#define BITS_OCTET 9		/** @def Un octet et son acquittement*/
+#define CONSTANTE_FILTRE 4.9 /** @def Retard du passe-bas du MPU6050 reglage 3, assimile a un premier ordre (ms)*/
+
+typedef struct
+{
+	I2C_HandleTypeDef *h;
+	uint8_t registre;
+	uint8_t generation;
+} transfert_t;
+
+I2C_TypeDef SIM_i2c[2];
+
+void I2C1_EV_IRQHandler(void);
+
+static uint8_t registres[128] = {[REG_PWR_MGMT_1] = 0x40}; //MPU6050 en sommeil a la mise sous tension
+static double biais = 1.2;	 //deg/s
+static double bruit = 0.05;	 //deg/s, amplitude uniforme
+static double filtre = 0.0;	 //sortie du passe-bas (deg/s)
+static uint64_t dateFiltre = 0;
+static transfert_t enCours;
+static SIM_stat_i2c_t stat;
+
+static uint64_t duree_bus(const I2C_HandleTypeDef *, uint16_t);
+static void fin_lecture(uint32_t);
+static void mesurer(void);
+
+/**
+ * @param biais_dps : biais du gyroscope (deg/s)
+ * @param bruit_dps : amplitude du bruit uniforme (deg/s)
+ */
+void SIM_i2c_config(double biais_dps, double bruit_dps)
+{
+	biais = biais_dps;
+	bruit = bruit_dps;
+}
+
+const SIM_stat_i2c_t *SIM_i2c_stat(void)
+{
+	return &stat;
+}
+
+//Callbacks faibles de la HAL, redefinis par l'application qui utilise l'I2C
+__attribute__((weak)) void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+/**
+ * @retval la duree d'un transfert : start, adresse, registre, restart et adresse en lecture, donnees, stop
+ */
+static uint64_t duree_bus(const I2C_HandleTypeDef *h, uint16_t octets)
+{
+	return (uint64_t)(4 + octets) * BITS_OCTET * 1000000000ULL / (h->Init.ClockSpeed ? h->Init.ClockSpeed : 100000);
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+	hi2c->State = HAL_I2C_STATE_READY;
+	hi2c->ErrorCode = 0;
+	return HAL_OK;
+}
+
+/**
+ * @brief Ecriture bloquante : le CPU attend la fin du transfert
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)MemAddSize;
+	(void)Timeout;
+	if (hi2c->State != HAL_I2C_STATE_READY || DevAddress != ADRESSE_MPU6050)
+	{
+		stat.refus++;
+		return (hi2c->State != HAL_I2C_STATE_READY) ? HAL_BUSY : HAL_ERROR;
+	}
+	SIM_consommer((uint32_t)duree_bus(hi2c, Size));
+	for (uint16_t i = 0; i < Size; i++)
+		registres[(MemAddress + i) & 0x7F] = pData[i];
+	stat.ecritures++;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+	(void)MemAddSize;
+	if (hi2c->State != HAL_I2C_STATE_READY || DevAddress != ADRESSE_MPU6050)
+	{
+		stat.refus++;
+		return (hi2c->State != HAL_I2C_STATE_READY) ? HAL_BUSY : HAL_ERROR;
+	}
+	SIM_consommer(SIM_COUT_I2C_START);
+	hi2c->State = HAL_I2C_STATE_BUSY;
+	hi2c->pBuffPtr = pData;
+	hi2c->XferSize = Size;
+	enCours.h = hi2c;
+	enCours.registre = (uint8_t)MemAddress;
+	enCours.generation++;
+	SIM_programmer(SIM_maintenant() + duree_bus(hi2c, Size), SIM_IT_I2C, &fin_lecture, enCours.generation);
+	return HAL_OK;
+}
+
+/**
+ * @brief Met a jour GYRO_ZOUT : vitesse de lacet vraie filtree, plus biais et bruit, composant reveille
+ */
+static void mesurer(void)
+{
+	uint64_t maintenant = SIM_maintenant();
+	double dps = SIM_monde_lacet() * 180.0 / M_PI;
+	double lsb;
+	int32_t brut;
+
+	filtre += (dps - filtre) * (1.0 - exp(-(double)(maintenant - dateFiltre) / SIM_NS_PAR_MS / CONSTANTE_FILTRE));
+	dateFiltre = maintenant;
+	lsb = 32768.0 / (250 << ((registres[REG_GYRO_CONFIG] >> 3) & 3)); //LSB par deg/s selon la pleine echelle
+	brut = (int32_t)lround((filtre + biais + (SIM_alea() * 2.0 - 1.0) * bruit) * lsb);
+	if (registres[REG_PWR_MGMT_1] & 0x40)
+		brut = 0; //en sommeil, etat de mise sous tension
+	brut = (brut > 32767) ? 32767 : (brut < -32768) ? -32768 : brut;
+	registres[REG_LACET] = (uint8_t)((uint16_t)brut >> 8);
+	registres[REG_LACET + 1] = (uint8_t)brut;
+}
+
+/**
+ * @brief Fin d'une lecture sous interruption : recopie des registres puis interruption d'evenement
+ */
+static void fin_lecture(uint32_t generation)
+{
+	I2C_HandleTypeDef *h = enCours.h;
+
+	if (generation != enCours.generation)
+		return;
+	mesurer();
+	for (uint16_t i = 0; i < h->XferSize; i++)
+		h->pBuffPtr[i] = registres[(enCours.registre + i) & 0x7F];
+	stat.lectures++;
+	h->Instance->SR1 |= I2C_SR1_BTF;
+	I2C1_EV_IRQHandler();
+}
+
+/**
+ * @brief Sans I2C1_EV_IRQHandler dans l'application, la lecture ne se termine jamais
+ */
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c)
+{
+	SIM_consommer(SIM_COUT_I2C_IT);
+	if (!(hi2c->Instance->SR1 & I2C_SR1_BTF))
+		return;
+	hi2c->Instance->SR1 &= ~I2C_SR1_BTF;
+	hi2c->State = HAL_I2C_STATE_READY;
+	HAL_I2C_MemRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c)
+{
+	hi2c->State = HAL_I2C_STATE_READY;
+	HAL_I2C_ErrorCallback(hi2c);
+}
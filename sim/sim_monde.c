@@ -0,0 +1,425 @@
+/**
+ ******************************************************************************
+ * @file 	sim_monde.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Monde physique du simulateur : cinematique differentielle de la voiture,
+ * 			obstacles, lancer de rayons pour les capteurs, doublures moteur et PWM.
+ * 			Les rapports cycliques moteur ecrits pendant que TIM1 a UDIS sont precharges
+ * 			et ne s'appliquent qu'a la milliseconde suivante, ensemble.
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <string.h>
+#include "stm32f1_motorDC.h"
+#include "stm32f1_pwm.h"
+#include "sim.h"
+
+#define VITESSE_MAX 800.0	   /** @def Vitesse d'une roue a 100% de rapport cyclique (mm/s)*/
+#define VOIE 150.0			   /** @def Ecart entre les deux roues (mm)*/
+#define RAYON_VOITURE 110.0	   /** @def Rayon du disque englobant la voiture (mm)*/
+#define MARGE_CONTACT 20.0	   /** @def Eloignement necessaire pour qu'un contact soit rompu : une roue qui pousse encore n'en compte pas un second (mm)*/
+#define PORTEE_MAX 4000.0	   /** @def Portee maximale d'un HC-SR04 (mm)*/
+#define DEMI_CONE 0.26		   /** @def Demi-ouverture du faisceau ultrason (rad, ~15 degres)*/
+#define SEUIL_REACTION 250.0   /** @def Distance avant a partir de laquelle la voiture doit s'arreter, distance d'arret de croisiere.c (mm)*/
+#define PERIODE_BOUCLE 100	   /** @def Periode d'echantillonnage des poses pour la mesure du temps perdu en boucle (ms)*/
+#define NB_POSES_BOUCLE 600	   /** @def Poses echantillonnees conservees : une minute*/
+#define AGE_MIN_BOUCLE 10000   /** @def Age minimal d'une pose repassee pour compter en boucle : un blocage ordinaire, klaxon et manoeuvre, dure moins (ms)*/
+#define ECART_BOUCLE 300.0	   /** @def Distance en deca de laquelle une pose est repassee (mm)*/
+#define ECART_CAP_BOUCLE 0.52  /** @def Ecart de cap en deca duquel une pose est repassee (rad, ~30 degres)*/
+
+#define MOTEUR_DROIT MOTOR1
+#define MOTEUR_GAUCHE MOTOR2
+
+typedef struct
+{
+	double avance;	//decalage du capteur selon l'axe de la voiture (mm)
+	double lateral; //decalage a gauche de l'axe (mm)
+	double angle;	//orientation par rapport a l'axe (rad)
+} geometrie_t;
+
+static const geometrie_t geometries[SIM_CAPTEUR_NB] = {
+	[SIM_CAPTEUR_AVANT] = {100.0, 0.0, 0.0},
+	[SIM_CAPTEUR_DROITE] = {0.0, -80.0, -M_PI / 2},
+	[SIM_CAPTEUR_GAUCHE] = {0.0, 80.0, M_PI / 2},
+	[SIM_CAPTEUR_ARRIERE] = {-100.0, 0.0, M_PI},
+};
+
+static const SIM_scenario_t *scenario;
+static double x, y, cap;
+static int16_t duty[MOTOR_NB];
+static int16_t precharge[MOTOR_NB];
+static bool_e enAttente = FALSE;
+static uint32_t date_ms = 0;
+static bool_e enContact = FALSE;
+static bool_e avance = FALSE;
+static bool_e reactionArmee = FALSE;
+static uint64_t debutReaction;
+static SIM_stat_monde_t stat;
+static double rendement = 1.0; //part de la rotation theorique effectivement faite, les roues glissant en virage
+static double lacet = 0.0;	   //vitesse de rotation (rad/s)
+static bool_e pivot = FALSE;   //roues en opposition : virage sur place en cours
+static double capPivot;		   //cap au debut du virage sur place
+static uint32_t debutPivot;
+static double poses[NB_POSES_BOUCLE][3]; //poses echantillonnees (x, y, cap), en anneau
+static uint32_t nbPoses = 0;
+static bool_e enBoucle = FALSE;
+
+static bool_e segment_present(const SIM_segment_t *);
+static double lancer_rayon(double, double, double);
+static double distance_segment(double, double, const SIM_segment_t *);
+static void verifier_reaction(void);
+static void mesurer_lateral(void);
+static void appliquer_duty(int16_t, motor_id_e);
+
+void SIM_monde_init(const SIM_scenario_t *s)
+{
+	scenario = s;
+	x = s->x;
+	y = s->y;
+	cap = s->cap;
+	stat.reaction_min_ns = UINT64_MAX;
+}
+
+static bool_e segment_present(const SIM_segment_t *seg)
+{
+	if (seg->apparition_ms && date_ms < seg->apparition_ms)
+		return FALSE;
+	if (seg->disparition_ms && date_ms >= seg->disparition_ms)
+		return FALSE;
+	return TRUE;
+}
+
+/**
+ * @brief Distance le long d'un rayon jusqu'au premier segment present
+ * @retval la distance en mm, ou -1 si rien dans la portee du capteur
+ */
+static double lancer_rayon(double ox, double oy, double angle)
+{
+	double dx = cos(angle), dy = sin(angle);
+	double meilleur = -1.0;
+
+	for (uint8_t i = 0; i < scenario->nb_segments; i++)
+	{
+		const SIM_segment_t *seg = &scenario->segments[i];
+		if (!segment_present(seg))
+			continue;
+		double sx = seg->x2 - seg->x1, sy = seg->y2 - seg->y1;
+		double den = dx * sy - dy * sx;
+		if (fabs(den) < 1e-9)
+			continue;
+		double t = ((seg->x1 - ox) * sy - (seg->y1 - oy) * sx) / den;
+		double u = ((seg->x1 - ox) * dy - (seg->y1 - oy) * dx) / den;
+		if (t >= 0.0 && u >= 0.0 && u <= 1.0 && t <= PORTEE_MAX && (meilleur < 0.0 || t < meilleur))
+			meilleur = t;
+	}
+	return meilleur;
+}
+
+/**
+ * @brief Distance vraie vue par un capteur : plus court des trois rayons du cone
+ * @retval la distance en mm, ou -1 si aucun obstacle dans la portee
+ */
+double SIM_monde_distance(SIM_capteur_e capteur)
+{
+	const geometrie_t *g = &geometries[capteur];
+	double ox = x + g->avance * cos(cap) - g->lateral * sin(cap);
+	double oy = y + g->avance * sin(cap) + g->lateral * cos(cap);
+	double meilleur = -1.0;
+
+	for (int8_t r = -1; r <= 1; r++)
+	{
+		double d = lancer_rayon(ox, oy, cap + g->angle + r * DEMI_CONE);
+		if (d >= 0.0 && (meilleur < 0.0 || d < meilleur))
+			meilleur = d;
+	}
+	return meilleur;
+}
+
+static double distance_segment(double px, double py, const SIM_segment_t *seg)
+{
+	double sx = seg->x2 - seg->x1, sy = seg->y2 - seg->y1;
+	double l2 = sx * sx + sy * sy;
+	double t = (l2 > 0.0) ? ((px - seg->x1) * sx + (py - seg->y1) * sy) / l2 : 0.0;
+	t = (t < 0.0) ? 0.0 : (t > 1.0) ? 1.0 : t;
+	return hypot(px - (seg->x1 + t * sx), py - (seg->y1 + t * sy));
+}
+
+/**
+ * @brief Temps perdu en boucle : la voiture repasse par une pose, position et cap, qu'elle occupait
+ * 			entre AGE_MIN_BOUCLE et une minute plus tot. L'immobilite prolongee en fait partie.
+ */
+static void mesurer_boucle(void)
+{
+	bool_e repasse = FALSE;
+
+	for (uint32_t i = AGE_MIN_BOUCLE / PERIODE_BOUCLE; i <= nbPoses && i <= NB_POSES_BOUCLE && !repasse; i++)
+	{
+		const double *p = poses[(nbPoses - i) % NB_POSES_BOUCLE];
+		repasse = hypot(x - p[0], y - p[1]) < ECART_BOUCLE && fabs(remainder(cap - p[2], 2.0 * M_PI)) < ECART_CAP_BOUCLE;
+	}
+	if (repasse)
+	{
+		stat.boucle_ms += PERIODE_BOUCLE;
+		if (!enBoucle)
+			stat.boucles++;
+	}
+	enBoucle = repasse;
+	poses[nbPoses % NB_POSES_BOUCLE][0] = x;
+	poses[nbPoses % NB_POSES_BOUCLE][1] = y;
+	poses[nbPoses % NB_POSES_BOUCLE][2] = cap;
+	nbPoses++;
+}
+
+/**
+ * @brief Distances vraies des capteurs lateraux au plus proche obstacle, quelle que soit leur orientation :
+ * 			l'erreur laterale d'un suivi de mur est mesuree contre elles
+ */
+static void mesurer_lateral(void)
+{
+	const SIM_capteur_e cotes[2] = {SIM_CAPTEUR_DROITE, SIM_CAPTEUR_GAUCHE};
+	double d[2];
+
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		const geometrie_t *g = &geometries[cotes[i]];
+		d[i] = SIM_monde_distance_obstacle(x - g->lateral * sin(cap), y + g->lateral * cos(cap));
+		if (d[i] < 0.0)
+			return;
+	}
+	stat.lateral_ms++;
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		stat.lateral_mm[i] += d[i];
+		stat.lateral_mm2[i] += d[i] * d[i];
+	}
+}
+
+/**
+ * @brief Avance le monde d'une milliseconde : integration de la pose et detection des collisions
+ */
+void SIM_monde_pas_ms(void)
+{
+	if (enAttente && !(TIM1->CR1 & TIM_CR1_UDIS))
+	{
+		enAttente = FALSE;
+		stat.mises_a_jour_moteur++;
+		for (motor_id_e m = 0; m < MOTOR_NB; m++)
+			appliquer_duty(precharge[m], m);
+	}
+
+	double vd = duty[MOTEUR_DROIT] * VITESSE_MAX / 100.0;
+	double vg = duty[MOTEUR_GAUCHE] * VITESSE_MAX / 100.0;
+	double v = (vd + vg) / 2.0;
+	double w = (vd - vg) / VOIE * rendement;
+	double nx = x + v * cos(cap) / 1000.0;
+	double ny = y + v * sin(cap) / 1000.0;
+	bool_e contact = FALSE, proche = FALSE;
+
+	date_ms++;
+	for (uint8_t i = 0; i < scenario->nb_segments; i++)
+	{
+		if (!segment_present(&scenario->segments[i]))
+			continue;
+		double d = distance_segment(nx, ny, &scenario->segments[i]);
+		contact |= (d < RAYON_VOITURE);
+		proche |= (d < RAYON_VOITURE + MARGE_CONTACT);
+	}
+	if (!contact)
+	{
+		stat.distance_mm += fabs(v) / 1000.0;
+		if (v > 0.0)
+			stat.avant_mm += v / 1000.0;
+		x = nx;
+		y = ny;
+		if (!proche)
+			enContact = FALSE;
+	}
+	else if (!enContact)
+	{
+		stat.collisions++;
+		enContact = TRUE;
+	}
+	cap += w / 1000.0;
+	lacet = w;
+	if (!pivot && duty[MOTEUR_DROIT] * duty[MOTEUR_GAUCHE] < 0)
+	{
+		pivot = TRUE;
+		capPivot = cap;
+		debutPivot = date_ms;
+	}
+	else if (pivot && duty[MOTEUR_DROIT] * duty[MOTEUR_GAUCHE] >= 0)
+	{ //Fin du virage des que les roues ne sont plus en opposition, l'arc de reprise de la marche n'en fait pas partie
+		double angle = fabs(cap - capPivot) * 180.0 / M_PI;
+		pivot = FALSE;
+		stat.virages++;
+		stat.virage_deg += angle;
+		stat.virage_deg2 += angle * angle;
+		stat.virage_ms += date_ms - debutPivot;
+		if (stat.virages == 1 || angle < stat.virage_min_deg)
+			stat.virage_min_deg = angle;
+		if (angle > stat.virage_max_deg)
+			stat.virage_max_deg = angle;
+	}
+	if (v > 0.0)
+	{
+		stat.marche_avant_ms++;
+		avance = TRUE;
+		mesurer_lateral();
+	}
+	else if (avance)
+	{ //Fin d'une marche avant : arret, demi-tour sur place ou recul
+		stat.arrets++;
+		avance = FALSE;
+	}
+	if (scenario->but_x > 0.0 && !stat.but_ms && x >= scenario->but_x)
+	{
+		stat.but_ms = date_ms;
+		stat.arrets_but = stat.arrets;
+	}
+	if (date_ms % PERIODE_BOUCLE == 0)
+		mesurer_boucle();
+
+	if (!reactionArmee && duty[MOTEUR_DROIT] > 0 && duty[MOTEUR_GAUCHE] > 0)
+	{
+		double d = SIM_monde_distance(SIM_CAPTEUR_AVANT);
+		if (d >= 0.0 && d < SEUIL_REACTION)
+		{
+			reactionArmee = TRUE;
+			debutReaction = SIM_maintenant();
+		}
+	}
+}
+
+/**
+ * @brief Cloture une mesure de reaction capteur -> moteur des que les deux moteurs ne poussent plus vers l'avant
+ */
+static void verifier_reaction(void)
+{
+	if (reactionArmee && duty[MOTEUR_DROIT] <= 0 && duty[MOTEUR_GAUCHE] <= 0)
+	{
+		uint64_t r = SIM_maintenant() - debutReaction;
+		reactionArmee = FALSE;
+		stat.reactions++;
+		stat.reaction_total_ns += r;
+		if (r < stat.reaction_min_ns)
+			stat.reaction_min_ns = r;
+		if (r > stat.reaction_max_ns)
+			stat.reaction_max_ns = r;
+	}
+}
+
+/**
+ * @brief Glissement des roues en virage : la voiture tourne moins que ne le predisent ses rapports cycliques
+ * @param glissement : part de la rotation perdue, de 0 a 1
+ */
+void SIM_monde_glissement(double glissement)
+{
+	rendement = 1.0 - glissement;
+}
+
+/**
+ * @retval la vitesse de rotation vraie de la voiture (rad/s, positive a gauche)
+ */
+double SIM_monde_lacet(void)
+{
+	return lacet;
+}
+
+/**
+ * @retval la distance d'un point au plus proche obstacle present (mm), -1 si la scene est vide
+ */
+double SIM_monde_distance_obstacle(double px, double py)
+{
+	double meilleur = -1.0;
+
+	for (uint8_t i = 0; i < scenario->nb_segments; i++)
+	{
+		if (!segment_present(&scenario->segments[i]))
+			continue;
+		double d = distance_segment(px, py, &scenario->segments[i]);
+		if (meilleur < 0.0 || d < meilleur)
+			meilleur = d;
+	}
+	return meilleur;
+}
+
+const SIM_stat_monde_t *SIM_monde_stat(void)
+{
+	return &stat;
+}
+
+void SIM_monde_pose(double *px, double *py, double *pcap)
+{
+	*px = x;
+	*py = y;
+	*pcap = cap;
+}
+
+void MOTOR_init(uint8_t nb_motors)
+{
+	(void)nb_motors;
+	SIM_consommer(SIM_COUT_PWM_RUN);
+}
+
+/**
+ * @brief Ecriture effective d'un rapport cyclique, comme le ferait le transfert CCR precharge -> CCR actif
+ */
+static void appliquer_duty(int16_t d, motor_id_e motor_id)
+{
+	int16_t saut = (d > duty[motor_id]) ? d - duty[motor_id] : duty[motor_id] - d;
+
+	if (saut > stat.pas_max_moteur)
+		stat.pas_max_moteur = saut;
+	duty[motor_id] = d;
+	verifier_reaction();
+}
+
+void MOTOR_set_duty(int16_t d, motor_id_e motor_id)
+{
+	SIM_consommer(SIM_COUT_MOTEUR);
+	if (motor_id >= MOTOR_NB)
+		return;
+	if (!enAttente)
+		memcpy(precharge, duty, sizeof(duty));
+	if (precharge[motor_id] != d)
+		stat.changements_moteur++;
+	if (TIM1->CR1 & TIM_CR1_UDIS)
+	{
+		precharge[motor_id] = d;
+		enAttente = TRUE;
+	}
+	else if (!enAttente)
+	{
+		if (duty[motor_id] != d)
+		{
+			stat.mises_a_jour_moteur++;
+			stat.mises_a_jour_decalees++;
+		}
+		appliquer_duty(d, motor_id);
+	}
+	else
+		precharge[motor_id] = d;
+}
+
+void PWM_run(timer_id_e timer_id, uint16_t TIM_CHANNEL_x, bool_e negative_channel, uint32_t period, uint8_t d, bool_e remap)
+{
+	(void)negative_channel;
+	(void)remap;
+	SIM_consommer(SIM_COUT_PWM_RUN);
+	stat.reconfigurations_pwm++;
+	//Comme la librairie pour une periode < 65536 us : compteur a 1 MHz, le timer est reinitialise
+	SIM_tim[timer_id].PSC = 71;
+	SIM_tim[timer_id].ARR = period - 1;
+	(&SIM_tim[timer_id].CCR1)[TIM_CHANNEL_x / 4] = period * d / 100;
+	SIM_tim[timer_id].CR1 |= TIM_CR1_CEN;
+}
+
+void PWM_set_period_and_duty(timer_id_e timer_id, uint16_t TIM_CHANNEL_x, uint32_t period, uint8_t d)
+{
+	SIM_consommer(SIM_COUT_PWM_SET);
+	stat.reconfigurations_pwm++;
+	SIM_tim[timer_id].ARR = period - 1;
+	(&SIM_tim[timer_id].CCR1)[TIM_CHANNEL_x / 4] = period * d / 100;
+}
@@ -0,0 +1,83 @@
+/**
+ ******************************************************************************
+ * @file 	sim_timer.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure des timers STM32F1 : compteur deduit de l'horloge virtuelle,
+ * 			entrees de capture alimentees par le modele des capteurs
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include "sim.h"
+
+#define FREQUENCE_TIMER_MHZ 72 /** @def Horloge des timers (APB1 x2 ou APB2)*/
+
+TIM_TypeDef SIM_tim[4];
+
+static uint16_t compteur(TIM_TypeDef *, uint64_t);
+
+/**
+ * @retval la valeur du compteur d'un timer a une date donnee
+ */
+static uint16_t compteur(TIM_TypeDef *tim, uint64_t date)
+{
+	uint64_t ticks = date * FREQUENCE_TIMER_MHZ / SIM_NS_PAR_US / (tim->PSC + 1);
+	return (uint16_t)(ticks % ((uint64_t)tim->ARR + 1));
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Init(TIM_HandleTypeDef *htim)
+{
+	SIM_consommer(SIM_COUT_PWM_RUN);
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->Instance->ARR = htim->Init.Period;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_IC_InitTypeDef *sConfig, uint32_t Channel)
+{
+	(void)sConfig;
+	SIM_consommer(SIM_COUT_PWM_SET);
+	htim->Instance->CCER |= 1U << Channel; //CCxE
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	(void)Channel;
+	SIM_consommer(SIM_COUT_PWM_SET);
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+/**
+ * @brief Front sur l'entree d'un canal de capture : recopie du compteur a la date de l'evenement
+ * @param tim : timer
+ * @param canal : numero du canal, de 1 a 4
+ */
+void SIM_tim_capture(TIM_TypeDef *tim, uint8_t canal)
+{
+	volatile uint32_t *ccr = &tim->CCR1 + (canal - 1);
+	uint32_t drapeau = TIM_SR_CC1IF << (canal - 1);
+
+	if (!(tim->CR1 & TIM_CR1_CEN) || !(tim->CCER & (1U << ((canal - 1) * 4))))
+		return;
+	*ccr = compteur(tim, SIM_date_evenement());
+	if (tim->SR & drapeau)
+		tim->SR |= TIM_SR_CC1OF << (canal - 1);
+	tim->SR |= drapeau;
+}
+
+/**
+ * @brief Lecture d'un registre de capture : comme sur la cible, la lecture de CCRx efface CCxIF
+ * @param Channel : TIM_CHANNEL_x
+ */
+uint32_t SIM_tim_lire_capture(TIM_TypeDef *tim, uint32_t Channel)
+{
+	uint8_t canal = (uint8_t)(Channel / 4 + 1);
+
+	SIM_consommer(SIM_COUT_GETTICK);
+	SIM_hcsr04_capture_lue(tim, canal);
+	tim->SR &= ~(uint32_t)(TIM_SR_CC1IF << (canal - 1));
+	return *(&tim->CCR1 + (canal - 1));
+}
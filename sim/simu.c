@@ -0,0 +1,488 @@
+/**
+ ******************************************************************************
+ * @file 	simu.c
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Point d'entree du simulateur hote : choix du scenario, execution de
+ * 			l'application en temps virtuel et rapport de mesures
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "systick.h"
+#include "sim.h"
+#include "evenement/evenement.h"
+#include "registre/registre.h"
+#include "journal/journal.h"
+#include "automate/automate.h"
+#include "comportement/comportement.h"
+#include "odometrie/odometrie.h"
+#include "gyro/gyro.h"
+#include "grille/grille.h"
+#include "historique/historique.h"
+#include "tache/tache.h"
+#include "mur/mur.h"
+
+#define TOLERANCE_GRILLE 150.0 /** @def Ecart a un obstacle vrai en deca duquel une cellule occupee est juste : demi-diagonale de cellule et erreur d'odometrie (mm)*/
+#define DUREE_DEFAUT_MS 60000
+
+extern jmp_buf SIM_fin_simulation;
+int APPLI_main(void);
+
+//Arene de 8 m x 6 m avec deux caisses
+static const SIM_segment_t arene[] = {
+	{0, 0, 8000, 0, 0, 0},
+	{8000, 0, 8000, 6000, 0, 0},
+	{8000, 6000, 0, 6000, 0, 0},
+	{0, 6000, 0, 0, 0, 0},
+	{3500, 1800, 3900, 1800, 0, 0},
+	{3900, 1800, 3900, 2200, 0, 0},
+	{3900, 2200, 3500, 2200, 0, 0},
+	{3500, 2200, 3500, 1800, 0, 0},
+	{5500, 3800, 5900, 3800, 0, 0},
+	{5900, 3800, 5900, 4200, 0, 0},
+	{5900, 4200, 5500, 4200, 0, 0},
+	{5500, 4200, 5500, 3800, 0, 0},
+};
+
+//Ligne droite dans laquelle un obstacle surgit devant la voiture puis est retire par l'operateur
+static const SIM_segment_t surgit[] = {
+	{-500, -1500, 9000, -1500, 0, 0},
+	{-500, 1500, 9000, 1500, 0, 0},
+	{9000, -1500, 9000, 1500, 0, 0},
+	{-500, -1500, -500, 1500, 0, 0},
+	{2800, -400, 2800, 400, 2000, 4000},
+	{6500, -400, 6500, 400, 9000, 0},
+};
+
+//Couloir de 12 m x 3 m encombre de caisses en quinconce
+static const SIM_segment_t encombre[] = {
+	{0, 0, 12000, 0, 0, 0},
+	{12000, 0, 12000, 3000, 0, 0},
+	{12000, 3000, 0, 3000, 0, 0},
+	{0, 3000, 0, 0, 0, 0},
+	{2500, 0, 2500, 1100, 0, 0},
+	{2500, 1100, 2900, 1100, 0, 0},
+	{2900, 1100, 2900, 0, 0, 0},
+	{5000, 3000, 5000, 1900, 0, 0},
+	{5000, 1900, 5400, 1900, 0, 0},
+	{5400, 1900, 5400, 3000, 0, 0},
+	{7500, 0, 7500, 1100, 0, 0},
+	{7500, 1100, 7900, 1100, 0, 0},
+	{7900, 1100, 7900, 0, 0, 0},
+	{9500, 1300, 9900, 1300, 0, 0},
+	{9900, 1300, 9900, 1700, 0, 0},
+	{9900, 1700, 9500, 1700, 0, 0},
+	{9500, 1700, 9500, 1300, 0, 0},
+};
+
+//Parcours de 16 m x 3 m : caisses au milieu et contre les murs a contourner pour atteindre le fond
+static const SIM_segment_t slalom[] = {
+	{0, 0, 16000, 0, 0, 0},
+	{16000, 0, 16000, 3000, 0, 0},
+	{16000, 3000, 0, 3000, 0, 0},
+	{0, 3000, 0, 0, 0, 0},
+	{3000, 1200, 3600, 1200, 0, 0},
+	{3600, 1200, 3600, 1800, 0, 0},
+	{3600, 1800, 3000, 1800, 0, 0},
+	{3000, 1800, 3000, 1200, 0, 0},
+	{6500, 3000, 6500, 1700, 0, 0},
+	{6500, 1700, 7100, 1700, 0, 0},
+	{7100, 1700, 7100, 3000, 0, 0},
+	{9500, 0, 9500, 1300, 0, 0},
+	{9500, 1300, 10100, 1300, 0, 0},
+	{10100, 1300, 10100, 0, 0, 0},
+	{12500, 1100, 13100, 1100, 0, 0},
+	{13100, 1100, 13100, 1900, 0, 0},
+	{13100, 1900, 12500, 1900, 0, 0},
+	{12500, 1900, 12500, 1100, 0, 0},
+};
+
+//Salle vide de 30 m x 30 m : loin des murs, les cotes sont libres et la voiture tourne a chaque changement de direction
+static const SIM_segment_t salle[] = {
+	{0, 0, 30000, 0, 0, 0},
+	{30000, 0, 30000, 30000, 0, 0},
+	{30000, 30000, 0, 30000, 0, 0},
+	{0, 30000, 0, 0, 0, 0},
+};
+
+//Piece de 6 m x 6 m dans un coin de laquelle la voiture entre en biais
+static const SIM_segment_t coin[] = {
+	{0, 0, 6000, 0, 0, 0},
+	{6000, 0, 6000, 6000, 0, 0},
+	{6000, 6000, 0, 6000, 0, 0},
+	{0, 6000, 0, 0, 0, 0},
+};
+
+//Piece de 6 m x 6 m prolongee par un couloir en cul-de-sac de 6 m x 1.2 m, ou la voiture s'engage
+static const SIM_segment_t impasse[] = {
+	{0, 0, 6000, 0, 0, 0},
+	{6000, 0, 6000, 2400, 0, 0},
+	{6000, 2400, 12000, 2400, 0, 0},
+	{12000, 2400, 12000, 3600, 0, 0},
+	{12000, 3600, 6000, 3600, 0, 0},
+	{6000, 3600, 6000, 6000, 0, 0},
+	{6000, 6000, 0, 6000, 0, 0},
+	{0, 6000, 0, 0, 0, 0},
+};
+
+//Couloir droit de 20 m x 1.6 m, la voiture part en biais loin du mur droit
+static const SIM_segment_t couloir[] = {
+	{0, 0, 20000, 0, 0, 0},
+	{20000, 0, 20000, 1600, 0, 0},
+	{20000, 1600, 0, 1600, 0, 0},
+	{0, 1600, 0, 0, 0, 0},
+};
+
+//Couloir de 1.6 m coude deux fois : 9.6 m vers l'est, 3.2 m vers le nord, 12 m vers l'est
+static const SIM_segment_t chicane[] = {
+	{0, 0, 9600, 0, 0, 0},
+	{9600, 0, 9600, 3200, 0, 0},
+	{9600, 3200, 20000, 3200, 0, 0},
+	{20000, 3200, 20000, 4800, 0, 0},
+	{20000, 4800, 8000, 4800, 0, 0},
+	{8000, 4800, 8000, 1600, 0, 0},
+	{8000, 1600, 0, 1600, 0, 0},
+	{0, 1600, 0, 0, 0, 0},
+};
+
+//Hall de 8 m x 8 m prolonge a l'est par un couloir de 1.6 m, depart au centre hors de portee de tout mur
+static const SIM_segment_t hall[] = {
+	{0, 0, 8000, 0, 0, 0},
+	{8000, 0, 8000, 3200, 0, 0},
+	{8000, 3200, 20000, 3200, 0, 0},
+	{20000, 3200, 20000, 4800, 0, 0},
+	{20000, 4800, 8000, 4800, 0, 0},
+	{8000, 4800, 8000, 8000, 0, 0},
+	{8000, 8000, 0, 8000, 0, 0},
+	{0, 8000, 0, 0, 0, 0},
+};
+
+static const SIM_scenario_t scenarios[] = {
+	{"arene", "arene fermee de 8 m x 6 m avec deux caisses", arene, sizeof(arene) / sizeof(arene[0]), 1000, 3000, 0},
+	{"surgit", "obstacle surgissant a 1.2 m dans une ligne droite", surgit, sizeof(surgit) / sizeof(surgit[0]), 0, 0, 0},
+	{"encombre", "couloir de 12 m encombre de caisses en quinconce", encombre, sizeof(encombre) / sizeof(encombre[0]), 500, 1500, 0, 11000},
+	{"slalom", "parcours de 16 m a mener jusqu'au fond entre des caisses", slalom, sizeof(slalom) / sizeof(slalom[0]), 500, 1500, 0, 15000},
+	{"salle", "salle vide de 30 m x 30 m, virages sur place", salle, sizeof(salle) / sizeof(salle[0]), 15000, 15000, 0, 0},
+	{"coin", "piece de 6 m x 6 m, la voiture part vers un coin", coin, sizeof(coin) / sizeof(coin[0]), 3000, 3000, 0.785398, 0},
+	{"impasse", "couloir en cul-de-sac de 6 m x 1.2 m au bout d'une piece", impasse, sizeof(impasse) / sizeof(impasse[0]), 3000, 3000, 0, 0},
+	{"couloir", "couloir droit de 20 m x 1.6 m, depart en biais", couloir, sizeof(couloir) / sizeof(couloir[0]), 500, 1100, 0.1, 19000},
+	{"chicane", "couloir de 1.6 m coude deux fois, 25 m de long", chicane, sizeof(chicane) / sizeof(chicane[0]), 500, 800, 0, 19000},
+	{"hall", "hall de 8 m x 8 m, depart au centre loin des murs, sortie par un couloir", hall, sizeof(hall) / sizeof(hall[0]), 4000, 4000, 2.0, 19000},
+};
+
+static const char *const noms_capteurs[SIM_CAPTEUR_NB] = {"avant", "droite", "gauche", "arriere"};
+
+static uint32_t alea;
+
+void SIM_alea_init(uint32_t graine)
+{
+	alea = graine ? graine : 1;
+}
+
+/**
+ * @retval un nombre pseudo-aleatoire dans [0, 1[ (xorshift32, reproductible d'une execution a l'autre)
+ */
+double SIM_alea(void)
+{
+	alea ^= alea << 13;
+	alea ^= alea >> 17;
+	alea ^= alea << 5;
+	return (double)alea / 4294967296.0;
+}
+
+static void usage(const char *nom)
+{
+	fprintf(stderr, "usage : %s [-s scenario] [-d duree_ms] [-g graine] [-x diaphonie] [-p perte] [-b bruit_mm] [-j journal.bin] [-w hp.wav] [-t nb_releves] [-k glissement] [-y biais_dps] [-v]\n", nom);
+	fprintf(stderr, "scenarios :\n");
+	for (uint8_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+		fprintf(stderr, "  %-8s %s\n", scenarios[i].nom, scenarios[i].description);
+}
+
+static void rapport(const SIM_scenario_t *s, uint64_t duree_ms, uint32_t graine, double reel_s)
+{
+	const SIM_stat_monde_t *m = SIM_monde_stat();
+	const SIM_stat_it_t *st = SIM_stat_it(SIM_IT_SYSTICK);
+	const SIM_stat_it_t *ex = SIM_stat_it(SIM_IT_EXTI);
+	const SIM_stat_it_t *dm = SIM_stat_it(SIM_IT_DMA);
+	const SIM_stat_dma_t *dma = SIM_dma_stat();
+	double duree_s = duree_ms / 1000.0;
+	uint64_t it_ns = st->total_ns + ex->total_ns + dm->total_ns;
+	double px, py, pcap;
+	stat_evenement_t ev = EVENEMENT_get_stat();
+	stat_automate_t au = AUTOMATE_get_stat();
+	trace_t t;
+	uint8_t nbTrace = AUTOMATE_get_trace(0, &t);
+
+	printf("=== scenario %s, %llu ms virtuels, graine %u ===\n", s->nom, (unsigned long long)duree_ms, graine);
+	printf("acceleration          : x%.0f (%.3f s reelles)\n", reel_s > 0.0 ? duree_s / reel_s : 0.0, reel_s);
+	printf("boucle principale     : periode moy %.1f us, max %.1f us\n",
+		   SIM_boucle_periode_moy_ns() / 1000.0, SIM_boucle_periode_max_ns() / 1000.0);
+	printf("systick               : %u ticks, ISR moy %.2f us, max %.2f us\n",
+		   st->nb, st->nb ? st->total_ns / 1000.0 / st->nb : 0.0, st->max_ns / 1000.0);
+	printf("exti echo             : %u fronts, ISR max %.2f us\n", ex->nb, ex->max_ns / 1000.0);
+	printf("charge interruptions  : %.2f %%\n", 100.0 * it_ns / (duree_ms * SIM_NS_PAR_MS));
+	printf("veille (WFI)          : %.2f %% du temps, %u reveils, %u evenements traites, repos vu par l'appli %u %%\n",
+		   100.0 * SIM_sommeil_ns() / (duree_ms * SIM_NS_PAR_MS), ev.reveils, ev.traites, ev.repos);
+	printf("callbacks systick     : %u au maximum sur %u\n", SIM_systick_max_callbacks(), MAX_CALLBACK_FUNCTION_NB);
+	printf("uart                  : %u caracteres par printf\n", SIM_uart_nb_caracteres());
+	printf("journal               : %u octets en %u transferts DMA (max %u octets), ISR max %.2f us, %u enregistrements perdus\n",
+		   dma->octets, dma->transferts, dma->plusLong, dm->max_ns / 1000.0, JOURNAL_get_perdus());
+	for (uint8_t i = 0; i <= REGISTRE_get_nb(); i++)
+	{
+		stat_registre_t r = (i < REGISTRE_get_nb()) ? REGISTRE_get_stat(i) : REGISTRE_get_stat_tick();
+		printf("  %-20s : %6u appels, min %6.2f us, moy %6.2f us, max %6.2f us\n", (i < REGISTRE_get_nb()) ? REGISTRE_get_nom(i) : "tick complet",
+			   r.nb, (double)r.min / REGISTRE_CYCLES_PAR_US, (double)r.moy / REGISTRE_CYCLES_PAR_US, (double)r.max / REGISTRE_CYCLES_PAR_US);
+	}
+	printf("depassements du tick  : %u\n", REGISTRE_get_depassements());
+	if (TACHE_get_nb())
+	{
+		stat_ordonnanceur_t o = TACHE_get_stat_ordonnanceur();
+		printf("ordonnanceur          : %u passages, %u commutations, surcout moy %.2f us par commutation\n", o.passes, o.commutations,
+			   (double)o.moy / REGISTRE_CYCLES_PAR_US);
+		for (uint8_t i = 0; i < TACHE_get_nb(); i++)
+		{
+			stat_tache_t t = TACHE_get_stat(i);
+			printf("  %-20s : %6u appels, moy %6.2f us, max %6.2f us, retard max %u ms\n", TACHE_get_nom(i), t.appels,
+				   (double)t.moy / REGISTRE_CYCLES_PAR_US, (double)t.max / REGISTRE_CYCLES_PAR_US, t.retardMax);
+		}
+	}
+	for (SIM_capteur_e i = 0; i < SIM_CAPTEUR_NB; i++)
+	{
+		const SIM_stat_capteur_t *c = SIM_hcsr04_stat(i);
+		printf("capteur %-8s      : %u lancees (%.1f /s), %u echos, %u lus, %u perdus, %u timeouts, %u diaphonies lues\n",
+			   noms_capteurs[i], c->lancees, c->lancees / duree_s, c->echos, c->lues, c->perdus, c->timeouts, c->diaphoniesLues);
+		printf("                        datation de l'echo : ecart moy %.2f us, max %u us (%.1f mm)\n",
+			   c->lues ? (double)c->ecartTotal_us / c->lues : 0.0, c->ecartMax_us, c->ecartMax_us * 10.0 / 58.0);
+	}
+	if (m->reactions)
+		printf("reaction capteur->moteur : %u, min %.1f ms, moy %.1f ms, max %.1f ms\n", m->reactions,
+			   m->reaction_min_ns / 1e6, m->reaction_total_ns / 1e6 / m->reactions, m->reaction_max_ns / 1e6);
+	else
+		printf("reaction capteur->moteur : aucune\n");
+	printf("haut-parleur          : %u changements de note, %.1f s sonores dont %.1f s echantillonnes (DMA)\n", SIM_hp_stat()->changements,
+		   SIM_hp_stat()->sonore_ms / 1000.0, (double)SIM_hp_stat()->echantillonsPcm / SIM_HP_FREQUENCE_WAV);
+	SIM_monde_pose(&px, &py, &pcap);
+	printf("parcours              : %.0f mm, %u collisions, %u commandes moteur, %u reconfigurations PWM\n",
+		   m->distance_mm, m->collisions, m->changements_moteur, m->reconfigurations_pwm);
+	printf("moteurs               : %u mises a jour dont %u hors evenement commun, saut max %d %% par mise a jour\n",
+		   m->mises_a_jour_moteur, m->mises_a_jour_decalees, m->pas_max_moteur);
+	printf("croisiere             : vitesse moyenne %.0f mm/s, %.0f mm/s en marche avant (%.1f s), %u arrets\n",
+		   m->distance_mm / duree_s, m->marche_avant_ms ? m->avant_mm * 1000.0 / m->marche_avant_ms : 0.0,
+		   m->marche_avant_ms / 1000.0, m->arrets);
+	if (au.pas)
+	{
+		printf("automate              : %u pas, %u transitions, decision moy %.2f us, max %.2f us, au plus %u lignes par etat, etat final %s\n",
+			   au.pas, au.transitions, (double)au.moy / REGISTRE_CYCLES_PAR_US, (double)au.max / REGISTRE_CYCLES_PAR_US, au.lignesMax,
+			   AUTOMATE_get_nom(AUTOMATE_get_etat()));
+		for (uint8_t i = (nbTrace < 5) ? nbTrace : 5; i > 0; i--)
+		{
+			AUTOMATE_get_trace(i - 1, &t);
+			printf("  %8u ms : %-8s -> %-8s (evenement %u, ligne %u)\n", t.date, AUTOMATE_get_nom(t.de), AUTOMATE_get_nom(t.vers), t.evenement, t.ligne);
+		}
+	}
+	if (COMPORTEMENT_get_nb())
+	{
+		stat_arbitre_t ar = COMPORTEMENT_get_stat_arbitre();
+		printf("comportements         : %u pas (%u en retard), %u fusions, %u commandes, pas moy %.2f us, max %.2f us\n",
+			   ar.pas, ar.retards, ar.fusions, ar.commandes, (double)ar.moy / REGISTRE_CYCLES_PAR_US, (double)ar.max / REGISTRE_CYCLES_PAR_US);
+		for (uint8_t i = 0; i < COMPORTEMENT_get_nb(); i++)
+		{
+			stat_comportement_t c = COMPORTEMENT_get_stat(i);
+			printf("  %-20s : maitre %5.1f %% du temps, %4u prises, plus longue %6.1f s%s\n", COMPORTEMENT_get_nom(i),
+				   100.0 * c.duree / duree_ms, c.prises, c.plusLong / 1000.0, (i == COMPORTEMENT_get_maitre()) ? ", maitre final" : "");
+		}
+	}
+	if (s->but_x > 0.0)
+	{
+		if (m->but_ms)
+			printf("but                   : x >= %.0f mm atteint en %.1f s apres %u arrets\n", s->but_x, m->but_ms / 1000.0, m->arrets_but);
+		else
+			printf("but                   : x >= %.0f mm non atteint, %u arrets\n", s->but_x, m->arrets);
+	}
+	printf("pose finale           : x %.0f mm, y %.0f mm, cap %.1f deg\n", px, py, pcap * 180.0 / 3.14159265358979);
+	printf("boucles               : %u, %.1f s perdus (%.1f %% du temps)\n", m->boucles, m->boucle_ms / 1000.0, 100.0 * m->boucle_ms / duree_ms);
+	if (m->lateral_ms)
+	{
+		double moyD = m->lateral_mm[0] / m->lateral_ms, moyG = m->lateral_mm[1] / m->lateral_ms;
+		printf("lateral               : en marche avant, capteur droit a %.0f mm du plus proche obstacle (ecart-type %.0f), gauche a %.0f mm (ecart-type %.0f)\n",
+			   moyD, sqrt(fmax(m->lateral_mm2[0] / m->lateral_ms - moyD * moyD, 0.0)), moyG, sqrt(fmax(m->lateral_mm2[1] / m->lateral_ms - moyG * moyG, 0.0)));
+	}
+	if (MUR_get_stat().pas)
+	{
+		//Erreur quadratique moyenne a la consigne : somme des (d - c)^2 = somme d^2 - 2 c somme d + n c^2
+		stat_mur_t mu = MUR_get_stat();
+		int8_t sens;
+		double c = MUR_get_consigne(&sens);
+		uint8_t i = (sens == MUR_DROITE) ? 0 : 1;
+		double n = m->lateral_ms;
+		double moy = n ? m->lateral_mm[i] / n - c : 0.0;
+		double rms = n ? sqrt(fmax((m->lateral_mm2[i] - 2.0 * c * m->lateral_mm[i]) / n + c * c, 0.0)) : 0.0;
+		printf("suivi de mur          : %s a %.0f mm, erreur laterale moy %+.0f mm, quadratique %.0f mm ; %u commandes dont %u sans mur (%u pertes), moy %.2f us, max %.2f us\n",
+			   (sens == MUR_DROITE) ? "droite" : "gauche", c, moy, rms, mu.pas, mu.perdu, mu.pertes,
+			   (double)mu.moy / REGISTRE_CYCLES_PAR_US, (double)mu.max / REGISTRE_CYCLES_PAR_US);
+	}
+	if (HISTORIQUE_get_stat().manoeuvres)
+	{
+		stat_historique_t h = HISTORIQUE_get_stat();
+		printf("historique            : %u manoeuvres dont %u echecs, au plus %u echecs de suite, %u evasions (periode max %u)\n",
+			   h.manoeuvres, h.echecs, h.chaineMax, h.evasions, h.periodeMax);
+	}
+	if (m->virages)
+	{
+		double moy = m->virage_deg / m->virages;
+		printf("virages sur place     : %u, angle moy %.1f deg (min %.1f, max %.1f, ecart-type %.1f), duree moy %.0f ms\n", m->virages, moy,
+			   m->virage_min_deg, m->virage_max_deg, sqrt(fmax(m->virage_deg2 / m->virages - moy * moy, 0.0)), (double)m->virage_ms / m->virages);
+	}
+	if (SIM_i2c_stat()->lectures)
+	{
+		stat_gyro_t g = GYRO_get_stat();
+		const SIM_stat_i2c_t *i2c = SIM_i2c_stat();
+		const SIM_stat_it_t *it = SIM_stat_it(SIM_IT_I2C);
+		printf("gyroscope             : %u lectures I2C (%u integrees, %u periodes bus occupe, %u erreurs), ISR max %.2f us, biais estime %.2f deg/s, %u virages sur l'angle\n",
+			   i2c->lectures, g.lectures, g.occupe, g.erreurs, it->max_ns / 1000.0, g.biais / 16.0 / 65.5, g.virages);
+		printf("                        cap %.1f deg, ecart au cap vrai %.2f deg\n", GYRO_get_cap() * 180.0 / ODOMETRIE_DEMI_TOUR,
+			   remainder(pcap - s->cap - GYRO_get_cap() * M_PI / ODOMETRIE_DEMI_TOUR, 2.0 * M_PI) * 180.0 / M_PI);
+	}
+	if (ODOMETRIE_get_parcours())
+	{
+		//Pose vraie ramenee dans le repere de depart de l'odometrie
+		pose_t e = ODOMETRIE_get_pose();
+		double dx = px - s->x, dy = py - s->y;
+		double vx = dx * cos(s->cap) + dy * sin(s->cap), vy = dy * cos(s->cap) - dx * sin(s->cap);
+		double ecartCap = remainder(pcap - s->cap - e.cap * M_PI / ODOMETRIE_DEMI_TOUR, 2.0 * M_PI) * 180.0 / M_PI;
+		double ecart = hypot(vx - e.x, vy - e.y);
+		printf("odometrie             : estimee x %d mm, y %d mm, cap %.1f deg sur %u mm ; ecart %.0f mm (%.2f %% du parcours), cap %.2f deg\n",
+			   (int)e.x, (int)e.y, e.cap * 180.0 / ODOMETRIE_DEMI_TOUR, ODOMETRIE_get_parcours(), ecart,
+			   100.0 * ecart / ODOMETRIE_get_parcours(), ecartCap);
+	}
+	if (GRILLE_get_stat().releves)
+	{
+		//Cellules de la grille ramenees du repere de l'odometrie dans celui du monde, comparees aux obstacles vrais
+		stat_grille_t g = GRILLE_get_stat();
+		uint32_t occupees = 0, justes = 0, libres = 0, libresATort = 0;
+		int32_t fx, fy;
+
+		GRILLE_fenetre(&fx, &fy);
+		for (int32_t j = 0; j < GRILLE_COTE; j++)
+			for (int32_t i = 0; i < GRILLE_COTE; i++)
+			{
+				int32_t gx = fx + i * GRILLE_CELLULE, gy = fy + j * GRILLE_CELLULE;
+				int8_t v = GRILLE_lire(gx, gy);
+				double ox = gx + GRILLE_CELLULE / 2.0, oy = gy + GRILLE_CELLULE / 2.0;
+				double d = SIM_monde_distance_obstacle(s->x + ox * cos(s->cap) - oy * sin(s->cap), s->y + ox * sin(s->cap) + oy * cos(s->cap));
+
+				if (v > GRILLE_SEUIL_OCCUPE)
+				{
+					occupees++;
+					justes += (d >= 0.0 && d <= TOLERANCE_GRILLE);
+				}
+				else if (v < -GRILLE_SEUIL_OCCUPE)
+				{
+					libres++;
+					libresATort += (d >= 0.0 && d < GRILLE_CELLULE / 2.0);
+				}
+			}
+		printf("grille                : %u releves integres, %u colonnes ou lignes recentrees, au plus %u cellules par releve, %u recherches\n",
+			   g.releves, g.recentrages, g.cellulesMax, g.requetes);
+		printf("                        fenetre finale : %u cellules occupees dont %.1f %% a moins de %.0f mm d'un obstacle vrai, %u libres dont %u sur un obstacle\n",
+			   occupees, occupees ? 100.0 * justes / occupees : 0.0, TOLERANCE_GRILLE, libres, libresATort);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const SIM_scenario_t *scenario = &scenarios[0];
+	uint64_t duree_ms = DUREE_DEFAUT_MS;
+	uint32_t graine = 1;
+	double diaphonie = 0.3, perte = 0.0, bruit = 3.0, glissement = 0.0, biais = 1.2;
+	uint32_t banc = 0;
+	struct timespec t0, t1;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-v"))
+		{
+			SIM_set_verbeux(TRUE);
+			SIM_hp_verbeux(TRUE);
+		}
+		else if (i + 1 < argc && !strcmp(argv[i], "-d"))
+			duree_ms = strtoull(argv[++i], NULL, 10);
+		else if (i + 1 < argc && !strcmp(argv[i], "-g"))
+			graine = strtoul(argv[++i], NULL, 10);
+		else if (i + 1 < argc && !strcmp(argv[i], "-x"))
+			diaphonie = atof(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-p"))
+			perte = atof(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-b"))
+			bruit = atof(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-j"))
+			SIM_dma_capture(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-w"))
+			SIM_hp_wav(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-t"))
+			banc = strtoul(argv[++i], NULL, 10);
+		else if (i + 1 < argc && !strcmp(argv[i], "-k"))
+			glissement = atof(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-y"))
+			biais = atof(argv[++i]);
+		else if (i + 1 < argc && !strcmp(argv[i], "-s"))
+		{
+			const char *nom = argv[++i];
+			scenario = NULL;
+			for (uint8_t j = 0; j < sizeof(scenarios) / sizeof(scenarios[0]); j++)
+			{
+				if (!strcmp(nom, scenarios[j].nom))
+					scenario = &scenarios[j];
+			}
+			if (scenario == NULL)
+			{
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Le DMA ne recoit que des adresses 32 bits, comme sur la cible
+	if ((uintptr_t)&alea > UINT32_MAX)
+	{
+		fprintf(stderr, "simu : donnees hors des 4 premiers Go, compiler avec -no-pie\n");
+		return EXIT_FAILURE;
+	}
+
+	SIM_alea_init(graine);
+	if (banc)
+	{ //Banc d'essai seul, sans simulation
+		SIM_banc_approche(banc, bruit);
+		SIM_banc_filtre(banc, bruit);
+		SIM_banc_odometrie(banc);
+		SIM_banc_grille(banc);
+		SIM_banc_tache(banc);
+		SIM_banc_minuterie(banc);
+		return EXIT_SUCCESS;
+	}
+	SIM_hcsr04_config(diaphonie, perte, bruit);
+	SIM_monde_init(scenario);
+	SIM_monde_glissement(glissement);
+	SIM_i2c_config(biais, 0.05);
+	SIM_horloge_init(duree_ms * SIM_NS_PAR_MS);
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	if (!setjmp(SIM_fin_simulation))
+		APPLI_main();
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	SIM_hp_fermer();
+	fflush(stdout);
+	rapport(scenario, duree_ms, graine, (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+	return EXIT_SUCCESS;
+}
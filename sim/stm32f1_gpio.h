@@ -0,0 +1,17 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_gpio.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module GPIO de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_GPIO_H_
+#define STM32F1_GPIO_H_
+
+#include "stm32f1xx_hal.h"
+
+void BSP_GPIO_PinCfg(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin, uint32_t GPIO_Mode, uint32_t GPIO_Pull, uint32_t GPIO_Speed);
+
+#endif /* STM32F1_GPIO_H_ */
@@ -0,0 +1,26 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_motorDC.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module moteur a courant continu de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_MOTORDC_H_
+#define STM32F1_MOTORDC_H_
+
+#include "macro_types.h"
+
+typedef enum
+{
+	MOTOR1 = 0,
+	MOTOR2,
+	MOTOR3,
+	MOTOR_NB
+} motor_id_e;
+
+void MOTOR_init(uint8_t nb_motors);
+void MOTOR_set_duty(int16_t duty, motor_id_e motor_id);
+
+#endif /* STM32F1_MOTORDC_H_ */
@@ -0,0 +1,19 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_pwm.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module PWM de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_PWM_H_
+#define STM32F1_PWM_H_
+
+#include "macro_types.h"
+#include "stm32f1_timer.h"
+
+void PWM_run(timer_id_e timer_id, uint16_t TIM_CHANNEL_x, bool_e negative_channel, uint32_t period, uint8_t duty, bool_e remap);
+void PWM_set_period_and_duty(timer_id_e timer_id, uint16_t TIM_CHANNEL_x, uint32_t period, uint8_t duty);
+
+#endif /* STM32F1_PWM_H_ */
@@ -0,0 +1,17 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_sys.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module systeme de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_SYS_H_
+#define STM32F1_SYS_H_
+
+#include "stm32f1_uart.h"
+
+void SYS_set_std_usart(uart_id_e in, uart_id_e out, uart_id_e err);
+
+#endif /* STM32F1_SYS_H_ */
@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_timer.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote des identifiants de timers de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_TIMER_H_
+#define STM32F1_TIMER_H_
+
+#include "stm32f1xx_hal.h"
+
+typedef enum
+{
+	TIMER1_ID = 0,
+	TIMER2_ID,
+	TIMER3_ID,
+	TIMER4_ID,
+	TIMER_ID_NB
+} timer_id_e;
+
+#endif /* STM32F1_TIMER_H_ */
@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1_uart.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module UART de la librairie stm32f1
+ * @note    printf est redirige vers SIM_printf qui facture le temps d'emission
+ * 			bloquant de chaque caractere au debit configure.
+ ******************************************************************************
+ */
+
+#ifndef STM32F1_UART_H_
+#define STM32F1_UART_H_
+
+#include <stdio.h>
+#include "macro_types.h"
+
+typedef enum
+{
+	UART1_ID = 0,
+	UART2_ID,
+	UART3_ID,
+	UART_ID_NB
+} uart_id_e;
+
+void UART_init(uart_id_e uart_id, uint32_t baudrate);
+int SIM_printf(const char *format, ...);
+
+#define printf SIM_printf
+
+#endif /* STM32F1_UART_H_ */
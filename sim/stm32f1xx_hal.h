@@ -0,0 +1,399 @@
+/**
+ ******************************************************************************
+ * @file 	stm32f1xx_hal.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du sous-ensemble de la HAL STM32F1 utilise par appli/
+ * @note    Chaque appel consomme un temps CPU virtuel (voir sim.h), c'est ce qui
+ * 			fait avancer l'horloge de la simulation.
+ ******************************************************************************
+ */
+
+#ifndef STM32F1XX_HAL_H_
+#define STM32F1XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum
+{
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef SIM_gpio[3];
+
+#define GPIOA (&SIM_gpio[0])
+#define GPIOB (&SIM_gpio[1])
+#define GPIOC (&SIM_gpio[2])
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT 0x00000000U
+#define GPIO_MODE_OUTPUT_PP 0x00000001U
+#define GPIO_MODE_OUTPUT_OD 0x00000011U
+#define GPIO_MODE_AF_PP 0x00000002U
+#define GPIO_MODE_AF_OD 0x00000012U
+#define GPIO_MODE_IT_RISING_FALLING 0x10310000U
+
+#define GPIO_NOPULL 0x00000000U
+#define GPIO_PULLUP 0x00000001U
+#define GPIO_PULLDOWN 0x00000002U
+
+#define GPIO_SPEED_FREQ_LOW 0x00000002U
+#define GPIO_SPEED_FREQ_MEDIUM 0x00000001U
+#define GPIO_SPEED_FREQ_HIGH 0x00000003U
+
+//Coeur Cortex-M3 (CMSIS) : masquage des interruptions, veille et compteur de cycles
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern CoreDebug_Type SIM_coreDebug;
+DWT_Type *SIM_dwt(void);
+
+#define DWT (SIM_dwt()) //CYCCNT est recalcule a partir de l'horloge virtuelle a chaque acces
+#define CoreDebug (&SIM_coreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk 0x00000001UL
+#define CoreDebug_DEMCR_TRCENA_Msk 0x01000000UL
+
+uint32_t __get_PRIMASK(void);
+void __disable_irq(void);
+void __enable_irq(void);
+void __WFI(void);
+
+//Acces exclusifs : le simulateur n'interrompt jamais un calcul pur, une sequence LDREX/STREX reussit toujours
+static inline uint32_t __LDREXW(volatile uint32_t *adresse)
+{
+	return *adresse;
+}
+
+static inline uint32_t __STREXW(uint32_t valeur, volatile uint32_t *adresse)
+{
+	*adresse = valeur;
+	return 0;
+}
+
+static inline void __CLREX(void)
+{
+}
+
+static inline void __DMB(void)
+{
+	__sync_synchronize();
+}
+
+typedef enum
+{
+	DMA1_Channel1_IRQn = 11,
+	DMA1_Channel7_IRQn = 17,
+	I2C1_EV_IRQn = 31,
+	I2C1_ER_IRQn = 32
+} IRQn_Type;
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+
+typedef struct
+{
+	volatile uint32_t SR;
+	volatile uint32_t DR;
+	volatile uint32_t BRR;
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+	volatile uint32_t CR3;
+	volatile uint32_t GTPR;
+} USART_TypeDef;
+
+extern USART_TypeDef SIM_usart[3];
+
+#define USART1 (&SIM_usart[0])
+#define USART2 (&SIM_usart[1])
+#define USART3 (&SIM_usart[2])
+#define USART_CR3_DMAT 0x00000080U
+
+typedef struct
+{
+	volatile uint32_t CCR;
+	volatile uint32_t CNDTR;
+	volatile uint32_t CPAR;
+	volatile uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+extern DMA_Channel_TypeDef SIM_dma1[7];
+
+#define DMA1_Channel1 (&SIM_dma1[0])
+#define DMA1_Channel7 (&SIM_dma1[6])
+
+#define DMA_MEMORY_TO_PERIPH 0x00000010U
+#define DMA_PINC_DISABLE 0x00000000U
+#define DMA_MINC_ENABLE 0x00000080U
+#define DMA_PDATAALIGN_BYTE 0x00000000U
+#define DMA_PDATAALIGN_HALFWORD 0x00000100U
+#define DMA_MDATAALIGN_BYTE 0x00000000U
+#define DMA_NORMAL 0x00000000U
+#define DMA_CIRCULAR 0x00000020U
+#define DMA_PRIORITY_LOW 0x00000000U
+#define DMA_PRIORITY_HIGH 0x00002000U
+
+typedef enum
+{
+	HAL_DMA_STATE_RESET = 0x00U,
+	HAL_DMA_STATE_READY = 0x01U,
+	HAL_DMA_STATE_BUSY = 0x02U
+} HAL_DMA_StateTypeDef;
+
+typedef struct
+{
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Channel_TypeDef *Instance;
+	DMA_InitTypeDef Init;
+	volatile HAL_DMA_StateTypeDef State;
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+} DMA_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+//Comme sur la cible, les adresses sont passees sur 32 bits : le simulateur doit etre compile avec -no-pie
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+#define __HAL_RCC_DMA1_CLK_ENABLE() ((void)0)
+
+typedef struct
+{
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+	volatile uint32_t SMCR;
+	volatile uint32_t DIER;
+	volatile uint32_t SR;
+	volatile uint32_t EGR;
+	volatile uint32_t CCMR1;
+	volatile uint32_t CCMR2;
+	volatile uint32_t CCER;
+	volatile uint32_t CNT;
+	volatile uint32_t PSC;
+	volatile uint32_t ARR;
+	volatile uint32_t RCR;
+	volatile uint32_t CCR1;
+	volatile uint32_t CCR2;
+	volatile uint32_t CCR3;
+	volatile uint32_t CCR4;
+	volatile uint32_t BDTR;
+	volatile uint32_t DCR;
+	volatile uint32_t DMAR;
+} TIM_TypeDef;
+
+extern TIM_TypeDef SIM_tim[4];
+
+#define TIM1 (&SIM_tim[0])
+#define TIM2 (&SIM_tim[1])
+#define TIM3 (&SIM_tim[2])
+#define TIM4 (&SIM_tim[3])
+
+#define TIM_CR1_CEN 0x0001U
+#define TIM_CR1_UDIS 0x0002U
+#define TIM_CR1_ARPE 0x0080U
+#define TIM_DIER_CC1DE 0x0200U
+#define TIM_EGR_UG 0x0001U
+#define TIM_CCMR1_OC1PE 0x0008U
+#define TIM_CCMR1_OC2PE 0x0800U
+
+#define TIM_SR_UIF 0x0001U
+#define TIM_SR_CC1IF 0x0002U
+#define TIM_SR_CC2IF 0x0004U
+#define TIM_SR_CC3IF 0x0008U
+#define TIM_SR_CC4IF 0x0010U
+#define TIM_SR_CC1OF 0x0200U
+#define TIM_SR_CC2OF 0x0400U
+#define TIM_SR_CC3OF 0x0800U
+#define TIM_SR_CC4OF 0x1000U
+
+#define TIM_FLAG_UPDATE TIM_SR_UIF
+#define TIM_FLAG_CC1 TIM_SR_CC1IF
+#define TIM_FLAG_CC2 TIM_SR_CC2IF
+#define TIM_FLAG_CC3 TIM_SR_CC3IF
+#define TIM_FLAG_CC4 TIM_SR_CC4IF
+#define TIM_FLAG_CC1OF TIM_SR_CC1OF
+#define TIM_FLAG_CC2OF TIM_SR_CC2OF
+#define TIM_FLAG_CC3OF TIM_SR_CC3OF
+#define TIM_FLAG_CC4OF TIM_SR_CC4OF
+
+#define TIM_COUNTERMODE_UP 0x00000000U
+#define TIM_CLOCKDIVISION_DIV1 0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE 0x00000000U
+#define TIM_ICPOLARITY_RISING 0x00000000U
+#define TIM_ICPOLARITY_FALLING 0x00000002U
+#define TIM_ICSELECTION_DIRECTTI 0x00000001U
+#define TIM_ICSELECTION_INDIRECTTI 0x00000002U
+#define TIM_ICPSC_DIV1 0x00000000U
+
+typedef struct
+{
+	uint32_t Prescaler;
+	uint32_t CounterMode;
+	uint32_t Period;
+	uint32_t ClockDivision;
+	uint32_t RepetitionCounter;
+	uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+	TIM_TypeDef *Instance;
+	TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t ICPolarity;
+	uint32_t ICSelection;
+	uint32_t ICPrescaler;
+	uint32_t ICFilter;
+} TIM_IC_InitTypeDef;
+
+HAL_StatusTypeDef HAL_TIM_IC_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_IC_InitTypeDef *sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+uint32_t SIM_tim_lire_capture(TIM_TypeDef *tim, uint32_t Channel);
+
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__) ((((__HANDLE__)->Instance->SR) & (__FLAG__)) == (__FLAG__))
+//Sur la cible SR est en rc_w0 et la HAL ecrit ~(__FLAG__) ; en memoire simple il faut un masquage
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__) ((__HANDLE__)->Instance->SR &= ~(uint32_t)(__FLAG__))
+//La lecture passe par le simulateur pour comptabiliser les echos effectivement exploites
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) SIM_tim_lire_capture((__HANDLE__)->Instance, (__CHANNEL__))
+
+#define __HAL_RCC_TIM2_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_TIM3_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_AFIO_CLK_ENABLE() ((void)0)
+#define __HAL_AFIO_REMAP_TIM2_PARTIAL_2() ((void)0)
+#define __HAL_AFIO_REMAP_TIM3_PARTIAL() ((void)0)
+#define __HAL_AFIO_REMAP_SWJ_NOJTAG() ((void)0)
+#define __HAL_AFIO_REMAP_I2C1_ENABLE() ((void)0)
+
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CHANNEL_3 0x00000008U
+#define TIM_CHANNEL_4 0x0000000CU
+
+typedef struct
+{
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+	volatile uint32_t OAR1;
+	volatile uint32_t OAR2;
+	volatile uint32_t DR;
+	volatile uint32_t SR1;
+	volatile uint32_t SR2;
+	volatile uint32_t CCR;
+	volatile uint32_t TRISE;
+} I2C_TypeDef;
+
+extern I2C_TypeDef SIM_i2c[2];
+
+#define I2C1 (&SIM_i2c[0])
+#define I2C2 (&SIM_i2c[1])
+
+#define I2C_DUTYCYCLE_2 0x00000000U
+#define I2C_ADDRESSINGMODE_7BIT 0x00004000U
+#define I2C_DUALADDRESS_DISABLE 0x00000000U
+#define I2C_GENERALCALL_DISABLE 0x00000000U
+#define I2C_NOSTRETCH_DISABLE 0x00000000U
+#define I2C_MEMADD_SIZE_8BIT 0x00000001U
+#define I2C_SR1_BTF 0x00000004U
+
+typedef enum
+{
+	HAL_I2C_STATE_RESET = 0x00U,
+	HAL_I2C_STATE_READY = 0x20U,
+	HAL_I2C_STATE_BUSY = 0x24U
+} HAL_I2C_StateTypeDef;
+
+typedef struct
+{
+	uint32_t ClockSpeed;
+	uint32_t DutyCycle;
+	uint32_t OwnAddress1;
+	uint32_t AddressingMode;
+	uint32_t DualAddressMode;
+	uint32_t OwnAddress2;
+	uint32_t GeneralCallMode;
+	uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct
+{
+	I2C_TypeDef *Instance;
+	I2C_InitTypeDef Init;
+	uint8_t *pBuffPtr;
+	uint16_t XferSize;
+	volatile HAL_I2C_StateTypeDef State;
+	volatile uint32_t ErrorCode;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c);
+//Definies par l'application, comme les callbacks faibles de la HAL
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#define __HAL_RCC_I2C1_CLK_ENABLE() ((void)0)
+
+void HAL_Init(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+#endif /* STM32F1XX_HAL_H_ */
@@ -0,0 +1,21 @@
+/**
+ ******************************************************************************
+ * @file 	systick.h
+ * @date    17-October-2026
+ * @author  Gautier - Dufourmantelle
+ * @brief   Doublure hote du module systick de la librairie stm32f1
+ ******************************************************************************
+ */
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+#include "macro_types.h"
+
+#define MAX_CALLBACK_FUNCTION_NB 16
+
+void Systick_init(void);
+bool_e Systick_add_callback_function(callback_fun_t func);
+bool_e Systick_remove_callback_function(callback_fun_t func);
+
+#endif /* SYSTICK_H_ */